@@ -0,0 +1,74 @@
+/**
+ * @file AudioHealth.cpp
+ * @brief System-wide audio health taken from the sample ring fill, & load shedding keyed to it
+**/
+#include "AudioHealth.h"
+
+AudioHealth::AudioHealth(const StreamPlayer *player)
+{
+    this->player = player;
+    current = HEALTH_GOOD;
+    drop_count = 0;
+    num_clients = 0;
+}
+
+int AudioHealth::add_client(const char *name, int shed_at)
+{
+    if (num_clients == HEALTH_MAX_CLIENTS)
+    {
+        return -1;
+    }
+    HealthClient &entry = client_list[num_clients];
+    entry.name = name;
+    entry.shed_at = shed_at;
+    entry.shed = 0;
+    entry.episodes = 0;
+    entry.shedding = false;
+    return num_clients++;
+}
+
+int AudioHealth::level()
+{
+    uint32_t fill = player->fill();
+    int previous = current;
+    int next = previous;
+    if (!player->streaming() || fill >= HEALTH_RECOVER_FILL)
+    {
+        next = HEALTH_GOOD;
+    }
+    else if (fill < HEALTH_CRITICAL_FILL)
+    {
+        next = HEALTH_CRITICAL;
+    }
+    else if (fill < HEALTH_LOW_FILL || previous == HEALTH_CRITICAL)
+    {
+        next = HEALTH_LOW;
+    }
+    if (previous == HEALTH_GOOD && next != HEALTH_GOOD)
+    {
+        drop_count++;
+    }
+    current = next;
+    return next;
+}
+
+bool AudioHealth::admit(int client)
+{
+    if (client < 0 || client >= num_clients)
+    {
+        return true;
+    }
+    HealthClient &entry = client_list[client];
+    if (level() < entry.shed_at)
+    {
+        entry.shedding = false;
+        return true;
+    }
+    if (!entry.shedding)
+    {
+        entry.episodes++;
+        entry.shedding = true;
+    }
+    entry.shed++;
+    return false;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file AudioHealth.h
+ * @brief System-wide audio health taken from the sample ring fill, & load shedding keyed to it
+ * @details Work that is not needed to keep the DAC fed registers as a client with the level at which
+ * it gives way. Before each unit of work the client asks admit(); while the ring is below that
+ * level's fill the work is skipped or put off, & it resumes by itself once the ring has refilled.
+ * Recovery needs a higher fill than the drop, so clients do not flap around one threshold.
+**/
+#ifndef AUDIOHEALTH_H
+#define AUDIOHEALTH_H
+
+#include "mbed.h"
+#include "StreamPlayer.h"
+
+// Ring fill below which the audio is low, then critical
+#define HEALTH_LOW_FILL (PLAYER_RING_SIZE / 2)
+#define HEALTH_CRITICAL_FILL (PLAYER_RING_SIZE / 4)
+// Ring fill the audio must climb back to before it is good again
+#define HEALTH_RECOVER_FILL (PLAYER_RING_SIZE * 3 / 4)
+// Largest number of registered clients
+#define HEALTH_MAX_CLIENTS 8
+
+/**
+ * @brief Audio health levels, worst last
+**/
+enum HealthLevel
+{
+    HEALTH_GOOD,
+    HEALTH_LOW,
+    HEALTH_CRITICAL
+};
+
+/**
+ * @brief A kind of work that gives way to the audio
+**/
+struct HealthClient
+{
+    const char *name;
+    int shed_at;            // HealthLevel at which the work is shed
+    unsigned shed;          // Units of work shed
+    unsigned episodes;      // Times the work started being shed
+    bool shedding;
+};
+
+/**
+ * @brief Audio health signal with per-client load shedding
+**/
+class AudioHealth
+{
+public:
+    AudioHealth(const StreamPlayer *player);
+
+    /**
+     * @brief Registers a kind of non-audio work
+     * @param name Short name for reports, e.g. "lcd"
+     * @param shed_at HealthLevel at which the work is shed
+     * @return Client number for admit(), or -1 if HEALTH_MAX_CLIENTS are registered
+    **/
+    int add_client(const char *name, int shed_at);
+
+    /**
+     * @brief Current health, from the ring fill; good whenever nothing is streaming
+    **/
+    int level();
+
+    /**
+     * @brief Asks whether a client may do a unit of work now
+     * @return false if the work should be skipped or put off; counted as a shed event
+    **/
+    bool admit(int client);
+
+    int clients() const { return num_clients; }
+    const HealthClient &client(int index) const { return client_list[index]; }
+    /**
+     * @brief Times the audio dropped from good to low or worse
+    **/
+    unsigned drops() const { return drop_count; }
+
+private:
+    const StreamPlayer *player;
+    volatile int current;
+    unsigned drop_count;
+    HealthClient client_list[HEALTH_MAX_CLIENTS];
+    int num_clients;
+};
+
+#endif
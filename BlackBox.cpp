@@ -0,0 +1,254 @@
+/**
+ * @file BlackBox.cpp
+ * @brief Recorder of the player's health metrics into a circular file on the card
+**/
+#include "BlackBox.h"
+#include "us_ticker_api.h"
+#include <stdlib.h>
+#include <string.h>
+#if defined(TOOLCHAIN_GCC)
+#include <malloc.h>
+// From newlib's unistd.h, which cannot be included beside mbed's sleep()
+extern "C" void *sbrk(ptrdiff_t incr);
+#endif
+
+BlackBox::BlackBox(SDCard *fs)
+{
+    this->fs = fs;
+    file_ok = false;
+    sequence = 1;
+    boot_count = 1;
+    next_sector = 0;
+    pending_count = 0;
+    queued_full = false;
+    dropped_sectors = 0;
+    dropped_since = false;
+    num_stacks = 0;
+    main_stack_paint = NULL;
+    uptime_us = 0;
+    last_us = us_ticker_read();
+    memset(pending, 0, sizeof(pending));
+}
+
+/**
+ * @brief Sequence number of the first record of a sector, 0 if unused or unreadable
+**/
+uint32_t BlackBox::first_sequence(uint32_t sector)
+{
+    if (!file.read_sector(sector, (uint8_t *)queued))
+    {
+        return 0;
+    }
+    return queued[0].sequence;
+}
+
+bool BlackBox::open(const char *name)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/%s/%s", fs->getName(), name);
+    if (!file.open(fs, name) || file.file_size != BLACKBOX_SECTORS * SECTOR_SIZE)
+    {
+        // Allocate the whole file once; every later write overwrites it in place
+        file.close();
+        sdMutex.lock();
+        FILE *fp = fopen(path, "wb");
+        if (fp == NULL)
+        {
+            sdMutex.unlock();
+            return false;
+        }
+        memset(queued, 0, sizeof(queued));
+        bool ok = true;
+        for (int i = 0; i < BLACKBOX_SECTORS && ok; i++)
+        {
+            ok = fwrite(queued, SECTOR_SIZE, 1, fp) == 1;
+        }
+        ok = fclose(fp) == 0 && ok;
+        // The new chain is not in the FAT sector cached when the file was first looked for
+        invalidate_fat_cache();
+        sdMutex.unlock();
+        if (!ok || !file.open(fs, name))
+        {
+            file.close();
+            return false;
+        }
+    }
+
+    // Sectors from 0 up to the newest hold sequence numbers at or above sector 0's; the rest are
+    // older, from before the file last wrapped, or unused
+    uint32_t oldest = first_sequence(0);
+    if (oldest != 0)
+    {
+        uint32_t lo = 0;
+        uint32_t hi = BLACKBOX_SECTORS - 1;
+        while (lo < hi)
+        {
+            uint32_t mid = (lo + hi + 1) / 2;
+            if (first_sequence(mid) >= oldest)
+            {
+                lo = mid;
+            }
+            else
+            {
+                hi = mid - 1;
+            }
+        }
+        if (file.read_sector(lo, (uint8_t *)queued))
+        {
+            const BlackBoxRecord &last = queued[BLACKBOX_PER_SECTOR - 1];
+            sequence = last.sequence + 1;
+            boot_count = last.boot + 1;
+        }
+        next_sector = (lo + 1) % BLACKBOX_SECTORS;
+    }
+    file_ok = true;
+    return true;
+}
+
+unsigned char *BlackBox::watch_stack(uint32_t size)
+{
+    unsigned char *stack = new unsigned char[size];
+    uint32_t *words = (uint32_t *)stack;
+    for (uint32_t i = 0; i < size / 4; i++)
+    {
+        words[i] = BLACKBOX_STACK_PAINT;
+    }
+    if (num_stacks < BLACKBOX_MAX_STACKS)
+    {
+        stacks[num_stacks] = stack;
+        stack_sizes[num_stacks] = size;
+        num_stacks++;
+    }
+    return stack;
+}
+
+/**
+ * @details Counts the words still holding the paint. The stack grows down, so unused space is at the bottom; RTX keeps its overflow check
+ * word in the lowest word, which is skipped.
+**/
+uint16_t BlackBox::stack_free(int index)
+{
+    const uint32_t *words = (const uint32_t *)stacks[index];
+    uint32_t count = stack_sizes[index] / 4;
+    uint32_t i = 1;
+    while (i < count && words[i] == BLACKBOX_STACK_PAINT)
+    {
+        i++;
+    }
+    return (i - 1) * 4;
+}
+
+/**
+ * @details Stops a little below its own frame, which is gone once it returns. Only GCC's sbrk()
+ * tells where the heap ends, so elsewhere nothing is painted.
+**/
+void BlackBox::watch_main_stack()
+{
+#if defined(TOOLCHAIN_GCC)
+    uint32_t here = 0;
+    uint32_t *top = (uint32_t *)(((uint32_t)&here - 256) & ~3);
+    uint32_t *word = heap_break();
+    while (word < top)
+    {
+        *word++ = BLACKBOX_STACK_PAINT;
+    }
+    main_stack_paint = top;
+#endif
+}
+
+/**
+ * @brief First word above the heap
+**/
+uint32_t *BlackBox::heap_break()
+{
+#if defined(TOOLCHAIN_GCC)
+    return (uint32_t *)(((uint32_t)sbrk(0) + 3) & ~3);
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * @details The room above the heap is the run of paint from where the break is now up to the first
+ * word the main stack has written.
+**/
+uint16_t BlackBox::heap_free()
+{
+    uint32_t total = 0;
+    if (main_stack_paint != NULL)
+    {
+        const uint32_t *word = heap_break();
+        const uint32_t *start = word;
+        while (word < main_stack_paint && *word == BLACKBOX_STACK_PAINT)
+        {
+            word++;
+        }
+        total = (word - start) * 4;
+    }
+#if defined(TOOLCHAIN_GCC)
+    total += mallinfo().fordblks;
+#endif
+    return total > 0xFFFF ? 0xFFFF : total;
+}
+
+void BlackBox::record(BlackBoxRecord *entry)
+{
+    uint32_t now = us_ticker_read();
+    uptime_us += now - last_us;
+    last_us = now;
+
+    entry->sequence = sequence++;
+    entry->uptime_s = (uint32_t)(uptime_us / 1000000);
+    entry->boot = boot_count;
+    uint32_t max_us;
+    uint32_t p99_us = fs->read_latency(BLACKBOX_SD_WINDOW, 99, &max_us);
+    entry->sd_p99_us = p99_us > 0xFFFF ? 0xFFFF : p99_us;
+    entry->sd_max_us = max_us > 0xFFFF ? 0xFFFF : max_us;
+    entry->heap_free = heap_free();
+    for (int i = 0; i < BLACKBOX_MAX_STACKS; i++)
+    {
+        entry->stack_free[i] = i < num_stacks ? stack_free(i) : 0;
+    }
+    if (dropped_since)
+    {
+        entry->flags |= BLACKBOX_DROPPED;
+        dropped_since = false;
+    }
+    memset(entry->reserved, 0, sizeof(entry->reserved));
+    pending[pending_count++] = *entry;
+    if (pending_count < BLACKBOX_PER_SECTOR)
+    {
+        return;
+    }
+
+    // Hand the full sector to flush(), unless it is still busy with the last one
+    pending_count = 0;
+    if (!file_ok || queued_full)
+    {
+        dropped_sectors++;
+        dropped_since = true;
+        return;
+    }
+    memcpy(queued, pending, sizeof(queued));
+    queued_full = true;
+}
+
+bool BlackBox::flush()
+{
+    if (!queued_full)
+    {
+        return false;
+    }
+    bool ok = file.write_sector(next_sector, (const uint8_t *)queued);
+    if (ok)
+    {
+        next_sector = (next_sector + 1) % BLACKBOX_SECTORS;
+    }
+    else
+    {
+        dropped_sectors++;
+        dropped_since = true;
+    }
+    queued_full = false;
+    return ok;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file BlackBox.h
+ * @brief Recorder of the player's health metrics into a circular file on the card
+ * @details The file is allocated at full size once, then overwritten in place a whole sector at a
+ * time through TrackStream::write_sector, so recording never touches the FAT or the directory and a
+ * reset loses at most the sector being filled. Records carry a running sequence number, so the
+ * newest sector is found again at boot by a binary search & the host tool can put them in order.
+**/
+#ifndef BLACKBOX_H
+#define BLACKBOX_H
+
+#include "mbed.h"
+#include "SDCard.h"
+#include "TrackStream.h"
+
+// Sectors in the file; at one record a second it holds about 4.5 hours
+#define BLACKBOX_SECTORS 2048
+// Records written together as one sector
+#define BLACKBOX_PER_SECTOR (SECTOR_SIZE / sizeof(BlackBoxRecord))
+// Thread stacks whose high water marks are recorded
+#define BLACKBOX_MAX_STACKS 8
+// Fill of unused stack, checked for the high water mark
+#define BLACKBOX_STACK_PAINT 0xCDCDCDCD
+
+// SDCard latency window the records are taken from
+#define BLACKBOX_SD_WINDOW 0
+
+// BlackBoxRecord flags
+#define BLACKBOX_PLAYING 0x01       // A song or test signal was playing
+#define BLACKBOX_DROPPED 0x02       // Records were lost before this one because the card fell behind
+
+/**
+ * @brief One second of metrics; 64 bytes, so a sector holds 8
+**/
+struct BlackBoxRecord
+{
+    uint32_t sequence;          // Counts up across boots; 0 marks an unused record
+    uint32_t uptime_s;
+    uint16_t boot;              // Power-ups since the file was created
+    uint16_t cpu_mhz;
+    uint16_t fifo_min;          // Lowest & highest sample ring fill over the second
+    uint16_t fifo_max;
+    uint16_t underruns;         // Sample interrupts that found the ring empty over the second
+    uint16_t sd_p99_us;         // 99th percentile & slowest card sector read over the second
+    uint16_t sd_max_us;
+    uint16_t heap_free;         // Bytes malloc could still hand out, in total
+    int16_t song;
+    uint8_t cpu_percent;
+    uint8_t flags;
+    uint16_t stack_free[BLACKBOX_MAX_STACKS];  // Bytes never used by each watched stack
+    uint16_t input_audio_ms;    // Slowest command to reach the audio & the screen over the second
+    uint16_t input_lcd_ms;
+    uint8_t inputs;             // Commands that took effect over the second
+    uint8_t reserved[15];
+};
+
+/**
+ * @brief Circular metrics file with whole-sector writes
+**/
+class BlackBox
+{
+public:
+    BlackBox(SDCard *fs);
+
+    /**
+     * @brief Opens the file, creating it at full size if it is missing or the wrong size
+     * @details Recording continues after the newest sector already in the file.
+     * @param name File name in the root directory of the card, e.g. "blackbox.bin"
+     * @return false if the file could not be opened or created; record() then only counts
+    **/
+    bool open(const char *name);
+
+    /**
+     * @brief Allocates a painted stack for a Thread & watches its high water mark
+     * @param size Stack size in bytes, as passed to the Thread
+     * @return Stack to pass to the Thread constructor
+    **/
+    unsigned char *watch_stack(uint32_t size);
+
+    /**
+     * @brief Paints the calling thread's stack below the stack pointer, down to the heap
+     * @details Call first thing in main(). The speaker thread runs on the main stack, which RTX places
+     * right above the heap, so the paint left between them is the room both can still grow into.
+    **/
+    void watch_main_stack();
+
+    /**
+     * @brief Completes a record with the sequence, time, stacks, heap & card latency, & queues it
+     * @details Call once a second with the player's own fields filled in. A full sector is handed
+     * to flush(); if the previous one has not been written yet the new one is dropped.
+    **/
+    void record(BlackBoxRecord *entry);
+
+    /**
+     * @brief Writes the queued sector, if any; call from a low priority thread
+     * @return true if a sector was written
+    **/
+    bool flush();
+
+    uint16_t boot() const { return boot_count; }
+    unsigned dropped() const { return dropped_sectors; }
+
+    /**
+     * @brief Bytes of a watched stack never used, in the order the stacks were watched
+    **/
+    uint16_t stack_free(int index);
+    int watched() const { return num_stacks; }
+
+    /**
+     * @brief Bytes malloc could still hand out: free blocks inside the heap, & the paint left between
+     * the heap break & the main stack's high water mark
+     * @details Never allocates, so it is safe from any thread. Built with GCC only; 0 otherwise, or
+     * without the room above the heap if watch_main_stack() was not called.
+    **/
+    uint16_t heap_free();
+
+private:
+    uint32_t first_sequence(uint32_t sector);
+    uint32_t *heap_break();
+
+    SDCard *fs;
+    TrackStream file;
+    bool file_ok;
+    uint32_t sequence;
+    uint16_t boot_count;
+    uint32_t next_sector;           // File sector the queued sector goes to
+    BlackBoxRecord pending[BLACKBOX_PER_SECTOR];
+    unsigned pending_count;
+    BlackBoxRecord queued[BLACKBOX_PER_SECTOR];
+    volatile bool queued_full;
+    unsigned dropped_sectors;
+    bool dropped_since;
+    unsigned char *stacks[BLACKBOX_MAX_STACKS];
+    uint32_t stack_sizes[BLACKBOX_MAX_STACKS];
+    int num_stacks;
+    const uint32_t *main_stack_paint;   // End of the paint below the main stack
+    uint64_t uptime_us;
+    uint32_t last_us;
+};
+
+#endif
@@ -0,0 +1,321 @@
+/**
+ * @file BluetoothLink.cpp
+ * @brief Fast, flow-controlled link to the Adafruit Bluefruit LE UART Friend
+**/
+#include "BluetoothLink.h"
+#include "us_ticker_api.h"
+#include <string.h>
+
+// PCONP bit powering the GPDMA controller
+#define PCONP_GPDMA (1 << 29)
+// GPDMA request line of the UART2 transmitter (DMAREQSEL bit 4 clear)
+#define DMA_UART2_TX 12
+// UART FCR: FIFOs on & cleared, DMA requests on
+#define UART_FCR_FIFO_DMA 0x0F
+
+// AT command replies
+#define REPLY_TIMEOUT 0
+#define REPLY_OK 1
+#define REPLY_ERROR -1
+
+// Rates tried, fastest first; all are accepted by AT+BAUDRATE
+static const uint32_t linkRates[] = {921600, 460800, 230400, 115200, 57600, 38400, 19200, 9600};
+#define NUM_LINK_RATES (sizeof(linkRates) / sizeof(linkRates[0]))
+
+BluetoothLink::BluetoothLink(RawSerial *serial, PinName cts, PinName rts) : cts(cts), rts(rts)
+{
+    this->serial = serial;
+    this->cts = 1;
+    memset(&link_stats, 0, sizeof(link_stats));
+    link_stats.baud = BLUETOOTH_DEFAULT_BAUD;
+    rx_head = 0;
+    rx_tail = 0;
+}
+
+/**
+ * @brief Waits while the module holds RTS high
+**/
+void BluetoothLink::wait_clear()
+{
+    if (rts)
+    {
+        link_stats.flow_stalls++;
+        while (rts)
+        {
+            Thread::wait(1);
+        }
+    }
+}
+
+/**
+ * @brief Sends text a byte at a time, honouring RTS
+**/
+void BluetoothLink::send_raw(const char *text)
+{
+    while (*text)
+    {
+        wait_clear();
+        serial->putc(*text++);
+    }
+}
+
+/**
+ * @brief Reads reply lines until OK, ERROR or the timeout
+**/
+int BluetoothLink::read_reply()
+{
+    Timer timer;
+    timer.start();
+    int len = 0;
+    while (timer.read_ms() < BLUETOOTH_AT_TIMEOUT_MS)
+    {
+        if (!serial->readable())
+        {
+            Thread::wait(1);
+            continue;
+        }
+        char c = serial->getc();
+        if (c != '\n' && c != '\r')
+        {
+            if (len < (int)sizeof(reply) - 1)
+            {
+                reply[len++] = c;
+            }
+            continue;
+        }
+        reply[len] = 0;
+        len = 0;
+        if (strcmp(reply, "OK") == 0)
+        {
+            return REPLY_OK;
+        }
+        if (strcmp(reply, "ERROR") == 0)
+        {
+            return REPLY_ERROR;
+        }
+    }
+    return REPLY_TIMEOUT;
+}
+
+/**
+ * @brief Sends an AT command, resending it if the module does not answer
+ * @return true if the module replied OK
+**/
+bool BluetoothLink::command(const char *text)
+{
+    for (int i = 0; i < BLUETOOTH_AT_TRIES; i++)
+    {
+        if (i > 0)
+        {
+            link_stats.retransmissions++;
+        }
+        send_raw(text);
+        send_raw("\r\n");
+        int result = read_reply();
+        if (result != REPLY_TIMEOUT)
+        {
+            return result == REPLY_OK;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Looks for the module at one rate, leaving it in command mode if found
+ * @details "+++" toggles between data & command mode, so a module already in command mode is put
+ * back into it by a second toggle.
+**/
+bool BluetoothLink::probe(uint32_t baud)
+{
+    serial->baud(baud);
+    Thread::wait(5);
+    while (serial->readable())
+    {
+        serial->getc();
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        send_raw("+++\r\n");
+        if (read_reply() != REPLY_OK)
+        {
+            return false;
+        }
+        send_raw("AT\r\n");
+        if (read_reply() == REPLY_OK)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t BluetoothLink::negotiate()
+{
+    // Transmit DMA from UART2
+    LPC_SC->PCONP |= PCONP_GPDMA;
+    LPC_SC->DMAREQSEL &= ~(1 << (DMA_UART2_TX - 8));
+    LPC_GPDMA->DMACConfig = 1;
+    LPC_UART2->FCR = UART_FCR_FIFO_DMA;
+    cts = 0;
+
+    // Find the rate the module was left at; it keeps the last one set across power cycles
+    int found = -1;
+    for (unsigned i = 0; i < NUM_LINK_RATES && found < 0; i++)
+    {
+        if (probe(linkRates[i]))
+        {
+            found = i;
+        }
+    }
+    if (found < 0)
+    {
+        serial->baud(BLUETOOTH_DEFAULT_BAUD);
+        link_stats.baud = BLUETOOTH_DEFAULT_BAUD;
+        serial->attach(this, &BluetoothLink::on_rx, RawSerial::RxIrq);
+        return link_stats.baud;
+    }
+
+    // Step up, fastest first; the module takes a new rate when it restarts
+    char text[24];
+    for (int i = 0; i < found; i++)
+    {
+        snprintf(text, sizeof(text), "AT+BAUDRATE=%u", (unsigned)linkRates[i]);
+        if (!command(text))
+        {
+            continue;
+        }
+        send_raw("ATZ\r\n");
+        Thread::wait(BLUETOOTH_RESET_MS);
+        if (probe(linkRates[i]))
+        {
+            found = i;
+            break;
+        }
+        // Too fast to hold: set the module back to the rate that worked, without expecting replies
+        serial->baud(linkRates[i]);
+        send_raw("+++\r\n");
+        Thread::wait(50);
+        snprintf(text, sizeof(text), "AT+BAUDRATE=%u\r\n", (unsigned)linkRates[found]);
+        send_raw(text);
+        Thread::wait(50);
+        send_raw("ATZ\r\n");
+        Thread::wait(BLUETOOTH_RESET_MS);
+        if (!probe(linkRates[found]))
+        {
+            break;
+        }
+    }
+
+    // Back to data mode for the Control Pad
+    serial->baud(linkRates[found]);
+    send_raw("+++\r\n");
+    read_reply();
+    link_stats.baud = linkRates[found];
+    serial->attach(this, &BluetoothLink::on_rx, RawSerial::RxIrq);
+    return link_stats.baud;
+}
+
+/**
+ * @brief UART2 receive interrupt: empties the FIFO into the ring & holds the module off when it is nearly full
+**/
+void BluetoothLink::on_rx()
+{
+    while (serial->readable())
+    {
+        char c = serial->getc();
+        if (rx_head - rx_tail == BLUETOOTH_RX_BUFFER)
+        {
+            link_stats.rx_overruns++;
+            continue;
+        }
+        rx_buffer[rx_head % BLUETOOTH_RX_BUFFER] = c;
+        rx_head++;
+    }
+    if (rx_head - rx_tail >= BLUETOOTH_RX_BUFFER - BLUETOOTH_RX_HEADROOM)
+    {
+        cts = 1;
+    }
+}
+
+char BluetoothLink::getc()
+{
+    while (rx_head == rx_tail)
+    {
+        Thread::wait(1);
+    }
+    char c = rx_buffer[rx_tail % BLUETOOTH_RX_BUFFER];
+    rx_tail++;
+    // Let the module send again once the ring has drained to a quarter
+    if (rx_head - rx_tail <= BLUETOOTH_RX_BUFFER / 4)
+    {
+        cts = 0;
+    }
+    return c;
+}
+
+/**
+ * @brief Moves one chunk to the UART by DMA, yielding until it has been taken
+ * @return false on a bus error
+**/
+bool BluetoothLink::dma_send(const char *data, int length)
+{
+    uint32_t mask = 1 << BLUETOOTH_DMA_CHANNEL;
+    LPC_GPDMACH_TypeDef *channel = (LPC_GPDMACH_TypeDef *)(LPC_GPDMACH0_BASE + 0x20 * BLUETOOTH_DMA_CHANNEL);
+    LPC_GPDMA->DMACIntTCClear = mask;
+    LPC_GPDMA->DMACIntErrClr = mask;
+    channel->DMACCSrcAddr = (uint32_t)data;
+    channel->DMACCDestAddr = (uint32_t)&LPC_UART2->THR;
+    channel->DMACCLLI = 0;
+    // Single byte transfers, source address incrementing
+    channel->DMACCControl = length | (1 << 26);
+    // Enabled, UART2 transmit as destination, memory to peripheral
+    channel->DMACCConfig = 1 | (DMA_UART2_TX << 6) | (1 << 11);
+    while (LPC_GPDMA->DMACEnbldChns & mask)
+    {
+        Thread::wait(1);
+    }
+    return !(LPC_GPDMA->DMACRawIntErrStat & mask);
+}
+
+void BluetoothLink::write(const char *data, int length)
+{
+    uint32_t start = us_ticker_read();
+    while (length > 0)
+    {
+        int n = length < BLUETOOTH_DMA_CHUNK ? length : BLUETOOTH_DMA_CHUNK;
+        wait_clear();
+        bool sent = false;
+        if (n >= BLUETOOTH_DMA_MIN)
+        {
+            sent = dma_send(data, n);
+            if (sent)
+            {
+                link_stats.dma_chunks++;
+            }
+            else
+            {
+                // Resend the chunk by hand after a bus error
+                link_stats.retransmissions++;
+            }
+        }
+        for (int i = 0; i < n && !sent; i++)
+        {
+            wait_clear();
+            serial->putc(data[i]);
+        }
+        data += n;
+        length -= n;
+        link_stats.bytes_sent += n;
+    }
+    link_stats.busy_us += us_ticker_read() - start;
+}
+
+void BluetoothLink::puts(const char *text)
+{
+    write(text, strlen(text));
+}
+
+uint32_t BluetoothLink::throughput() const
+{
+    return link_stats.busy_us ? (uint32_t)(link_stats.bytes_sent * 1000000 / link_stats.busy_us) : 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file BluetoothLink.h
+ * @brief Fast, flow-controlled link to the Adafruit Bluefruit LE UART Friend
+ * @details The module is on UART2 (p28/p27), which has no hardware flow control on the LPC1768, so
+ * CTS & RTS are driven & sampled as GPIO: the module's RTS is checked before each byte or DMA chunk,
+ * and chunks are small enough to fit in the module's headroom after it raises RTS. negotiate() finds
+ * the module at whatever rate it was left at, then steps both ends up to the fastest rate that still
+ * answers AT commands. Bulk writes are moved to the UART by a GPDMA channel. Received bytes are
+ * taken by the UART interrupt into a ring, & CTS is raised while the ring is nearly full, so a line
+ * sent at the full rate is not lost between polls of the BlueTooth thread.
+**/
+#ifndef BLUETOOTHLINK_H
+#define BLUETOOTHLINK_H
+
+#include "mbed.h"
+#include "rtos.h"
+
+// Rate of a factory-fresh module
+#define BLUETOOTH_DEFAULT_BAUD 9600
+// GPDMA channel used for transmit; the lowest priority channel
+#define BLUETOOTH_DMA_CHANNEL 7
+// Largest DMA transfer between checks of the module's RTS
+#define BLUETOOTH_DMA_CHUNK 64
+// Writes shorter than this are sent a byte at a time
+#define BLUETOOTH_DMA_MIN 8
+// Time allowed for the module to answer an AT command
+#define BLUETOOTH_AT_TIMEOUT_MS 300
+// Times an AT command is sent before it is given up on
+#define BLUETOOTH_AT_TRIES 3
+// Time the module takes to restart after ATZ
+#define BLUETOOTH_RESET_MS 1000
+// Receive ring; a power of two
+#define BLUETOOTH_RX_BUFFER 128
+// Room left in the ring when CTS is raised, for bytes the module sends before it sees it
+#define BLUETOOTH_RX_HEADROOM 32
+
+/**
+ * @brief Traffic counters of the link
+**/
+struct LinkStats
+{
+    uint32_t baud;              // Rate both ends run at
+    uint64_t bytes_sent;
+    uint32_t busy_us;           // Time spent in write(), for throughput
+    unsigned dma_chunks;
+    unsigned flow_stalls;       // Times the module held RTS & sending waited
+    unsigned retransmissions;   // AT commands resent & DMA chunks resent after a bus error
+    unsigned rx_overruns;       // Bytes received with the ring full & dropped
+};
+
+/**
+ * @brief Bluefruit UART link with rate negotiation, GPIO flow control & DMA transmit
+**/
+class BluetoothLink
+{
+public:
+    /**
+     * @brief Creates a link on a serial port already opened on p28/p27
+     * @param serial UART2 port the module is on
+     * @param cts Pin wired to the module's CTS; held low while the mbed can receive
+     * @param rts Pin wired to the module's RTS; high while the module cannot take more data
+    **/
+    BluetoothLink(RawSerial *serial, PinName cts, PinName rts);
+
+    /**
+     * @brief Finds the module & raises both ends to the fastest rate it answers reliably at
+     * @details Blocks for several seconds; leaves the module in data mode & receiving into the ring.
+     * If the module is not found the link stays at BLUETOOTH_DEFAULT_BAUD.
+     * @return Rate in use
+    **/
+    uint32_t negotiate();
+
+    /**
+     * @brief Sends bytes, by DMA for longer writes, waiting whenever the module holds RTS
+    **/
+    void write(const char *data, int length);
+    void puts(const char *text);
+
+    /**
+     * @brief Whether a received byte is waiting in the ring
+    **/
+    bool readable() const { return rx_head != rx_tail; }
+
+    /**
+     * @brief Takes the next received byte, waiting for one if the ring is empty
+    **/
+    char getc();
+
+    const LinkStats &stats() const { return link_stats; }
+
+    /**
+     * @brief Average transmit throughput while sending, in bytes per second
+    **/
+    uint32_t throughput() const;
+
+private:
+    bool probe(uint32_t baud);
+    bool command(const char *text);
+    int read_reply();
+    void send_raw(const char *text);
+    void wait_clear();
+    bool dma_send(const char *data, int length);
+    void on_rx();
+
+    RawSerial *serial;
+    DigitalOut cts;
+    DigitalIn rts;
+    LinkStats link_stats;
+    char reply[32];
+    char rx_buffer[BLUETOOTH_RX_BUFFER];
+    volatile uint32_t rx_head;          // Written by on_rx()
+    volatile uint32_t rx_tail;          // Written by getc()
+};
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * @file CardProfiles.cpp
+ * @brief Calibration profiles of the SD cards the player has seen, kept in the last flash sector
+**/
+#include "CardProfiles.h"
+#include <string.h>
+
+// Entry point of the IAP routines in the boot ROM; they use the top 32 bytes of RAM, which the
+// linker script leaves free
+#define IAP_LOCATION 0x1FFF1FF1
+// IAP commands & the status returned on success
+#define IAP_PREPARE 50
+#define IAP_COPY 51
+#define IAP_ERASE 52
+#define IAP_SUCCESS 0
+
+typedef void (*IapEntry)(uint32_t *command, uint32_t *result);
+
+/**
+ * @brief Calls an IAP command with interrupts off, as the vector table is in the flash being written
+ * @return IAP status, IAP_SUCCESS if it worked
+**/
+static uint32_t iap(uint32_t code, uint32_t p0, uint32_t p1, uint32_t p2, uint32_t p3)
+{
+    uint32_t command[5] = {code, p0, p1, p2, p3};
+    uint32_t result[5];
+    __disable_irq();
+    ((IapEntry)IAP_LOCATION)(command, result);
+    __enable_irq();
+    return result[0];
+}
+
+static const CardProfile *slot(int index)
+{
+    return (const CardProfile *)(CARD_PROFILE_BASE + index * CARD_PROFILE_SLOT);
+}
+
+/**
+ * @brief First slot still erased, or -1 if the sector is full
+**/
+int CardProfiles::free_slot() const
+{
+    for (int i = 0; i < CARD_PROFILE_SLOTS; i++)
+    {
+        if (slot(i)->magic == 0xFFFFFFFF)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool CardProfiles::find(const uint8_t *cid, const uint8_t *csd, CardProfile *profile) const
+{
+    // Slots are used in order, so the last match is the newest
+    bool found = false;
+    for (int i = 0; i < CARD_PROFILE_SLOTS && slot(i)->magic != 0xFFFFFFFF; i++)
+    {
+        const CardProfile *entry = slot(i);
+        if (entry->magic == CARD_PROFILE_MAGIC && memcmp(entry->cid, cid, sizeof(entry->cid)) == 0 &&
+            memcmp(entry->csd, csd, sizeof(entry->csd)) == 0)
+        {
+            *profile = *entry;
+            found = true;
+        }
+    }
+    return found;
+}
+
+bool CardProfiles::save(const CardProfile &profile)
+{
+    uint32_t cclk_khz = SystemCoreClock / 1000;
+    int index = free_slot();
+    if (index < 0)
+    {
+        if (iap(IAP_PREPARE, CARD_PROFILE_SECTOR, CARD_PROFILE_SECTOR, 0, 0) != IAP_SUCCESS ||
+            iap(IAP_ERASE, CARD_PROFILE_SECTOR, CARD_PROFILE_SECTOR, cclk_khz, 0) != IAP_SUCCESS)
+        {
+            return false;
+        }
+        index = 0;
+    }
+
+    // IAP copies whole slots from word aligned RAM; the rest of the slot stays erased
+    uint32_t buffer[CARD_PROFILE_SLOT / 4];
+    memset(buffer, 0xFF, sizeof(buffer));
+    memcpy(buffer, &profile, sizeof(profile));
+    ((CardProfile *)buffer)->magic = CARD_PROFILE_MAGIC;
+    if (iap(IAP_PREPARE, CARD_PROFILE_SECTOR, CARD_PROFILE_SECTOR, 0, 0) != IAP_SUCCESS)
+    {
+        return false;
+    }
+    return iap(IAP_COPY, (uint32_t)slot(index), (uint32_t)buffer, CARD_PROFILE_SLOT, cclk_khz) == IAP_SUCCESS;
+}
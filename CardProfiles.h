@@ -0,0 +1,74 @@
+/**
+ * @file CardProfiles.h
+ * @brief Calibration profiles of the SD cards the player has seen, kept in the last flash sector
+ * @details Each profile is keyed by the card's CID & CSD registers, so a card is calibrated once &
+ * later boots only read its two registers. Profiles are appended to the sector one 256 byte slot at a
+ * time through the IAP routines in the boot ROM; the newest slot for a card wins. The sector is erased
+ * only when every slot has been used, which also forgets the other cards, which are then calibrated again.
+**/
+#ifndef CARDPROFILES_H
+#define CARDPROFILES_H
+
+#include "mbed.h"
+
+// Flash sector holding the profiles: the last 32 KB sector of the LPC1768, above the program
+#define CARD_PROFILE_SECTOR 29
+#define CARD_PROFILE_BASE 0x00078000
+#define CARD_PROFILE_SECTOR_SIZE 0x8000
+// Smallest block IAP can write
+#define CARD_PROFILE_SLOT 256
+#define CARD_PROFILE_SLOTS (CARD_PROFILE_SECTOR_SIZE / CARD_PROFILE_SLOT)
+// Marks a slot holding a profile ("SDCP")
+#define CARD_PROFILE_MAGIC 0x50434453
+
+// CardProfile flags
+#define CARD_HIGH_CAPACITY 0x01     // SDHC/SDXC, addressed in blocks rather than bytes
+#define CARD_SEQUENTIAL 0x02        // Consecutive blocks read measurably faster than scattered ones
+#define CARD_RECALIBRATE 0x04       // Read errors since calibration; calibrate again at the next boot
+
+/**
+ * @brief Calibration of one card
+**/
+struct CardProfile
+{
+    uint32_t magic;
+    uint8_t cid[16];            // Card identification register: maker, product, serial number
+    uint8_t csd[16];            // Card specific data register: capacity & timing
+    uint32_t spi_hz;            // Fastest SPI clock that read the reference blocks with good CRCs
+    uint16_t p50_us;            // Median, 99th percentile & slowest block read at that clock
+    uint16_t p99_us;
+    uint16_t max_us;
+    uint16_t read_ahead;        // Blocks of 44.1 kHz 16 bit stereo audio played during the 99th percentile read
+    uint16_t errors;            // Failed block reads since calibration
+    uint8_t flags;
+    uint8_t reserved;
+};
+
+/**
+ * @brief Flash store of card profiles
+**/
+class CardProfiles
+{
+public:
+    /**
+     * @brief Finds the newest profile of a card
+     * @param cid CID register of the card
+     * @param csd CSD register of the card
+     * @param profile Set to the profile if found
+     * @return false if the card has no profile
+    **/
+    bool find(const uint8_t *cid, const uint8_t *csd, CardProfile *profile) const;
+
+    /**
+     * @brief Appends a profile, erasing the sector first if it is full
+     * @details Interrupts are off while the flash is written, about 1 ms, or about 100 ms when the
+     * sector is erased, so call only while no audio is playing.
+     * @return false if the flash could not be written
+    **/
+    bool save(const CardProfile &profile);
+
+private:
+    int free_slot() const;
+};
+
+#endif
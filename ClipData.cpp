@@ -0,0 +1,613 @@
+/**
+ * @file ClipData.cpp
+ * @brief Clip image built into the firmware; written by tools/pack_clips.py, do not edit
+ * @details 9564 bytes at 8000 Hz:
+ * chime, 3600 samples
+ * click, 120 samples
+ * error, 3200 samples
+ * fallback, 12000 samples, looped
+**/
+#include "ClipStore.h"
+
+// Aligned so the header & index are read in place
+const uint8_t clipImage[] __attribute__((aligned(4))) =
+{
+    0x43, 0x4c, 0x49, 0x50, 0x04, 0x00, 0x00, 0x00, 0x63, 0x68, 0x69, 0x6d, 0x65, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x68, 0x00, 0x00, 0x00, 0x10, 0x0e, 0x00, 0x00, 0x40, 0x1f, 0x00, 0x00,
+    0x63, 0x6c, 0x69, 0x63, 0x6b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x07, 0x00, 0x00,
+    0x78, 0x00, 0x00, 0x00, 0x40, 0x1f, 0x00, 0x00, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xac, 0x07, 0x00, 0x00, 0x80, 0x0c, 0x00, 0x00, 0x40, 0x1f, 0x00, 0x00,
+    0x66, 0x61, 0x6c, 0x6c, 0x62, 0x61, 0x63, 0x6b, 0x00, 0x00, 0x00, 0x00, 0xec, 0x0d, 0x00, 0x00,
+    0xe0, 0x2e, 0x00, 0x00, 0x40, 0x1f, 0x01, 0x00, 0x70, 0x77, 0x77, 0xf9, 0xff, 0x2f, 0x33, 0x04,
+    0xa8, 0xcc, 0x9a, 0x20, 0x44, 0x12, 0xa8, 0xbc, 0xab, 0x30, 0x54, 0x22, 0xa8, 0xbc, 0x9c, 0x28,
+    0x34, 0x14, 0xa0, 0xdb, 0xaa, 0x18, 0x44, 0x22, 0x90, 0xbc, 0x9c, 0x19, 0x34, 0x33, 0x90, 0xcc,
+    0x9c, 0x19, 0x43, 0x33, 0x80, 0xcc, 0xbb, 0x19, 0x63, 0x23, 0x91, 0xda, 0xbb, 0x19, 0x52, 0x33,
+    0x82, 0xdb, 0xac, 0x09, 0x32, 0x35, 0x81, 0xca, 0xac, 0x0a, 0x42, 0x43, 0x01, 0xba, 0xbd, 0x0a,
+    0x41, 0x34, 0x01, 0xc9, 0xcb, 0x8a, 0x41, 0x43, 0x02, 0xb9, 0xbd, 0x8a, 0x31, 0x35, 0x12, 0xb9,
+    0xcd, 0x8a, 0x30, 0x34, 0x13, 0xb9, 0xcd, 0x9a, 0x30, 0x44, 0x12, 0xb8, 0xdb, 0x9b, 0x20, 0x35,
+    0x22, 0xa8, 0xbd, 0xab, 0x20, 0x45, 0x12, 0xa0, 0xdb, 0x9b, 0x28, 0x34, 0x14, 0x90, 0xdb, 0xab,
+    0x18, 0x44, 0x13, 0x91, 0xbc, 0xac, 0x19, 0x34, 0x24, 0x80, 0xdb, 0xab, 0x19, 0x53, 0x33, 0x80,
+    0xdb, 0xac, 0x19, 0x42, 0x33, 0x81, 0xdb, 0xac, 0x09, 0x42, 0x24, 0x81, 0xba, 0xbd, 0x09, 0x42,
+    0x24, 0x01, 0xba, 0xbd, 0x0a, 0x41, 0x34, 0x82, 0xc9, 0xac, 0x8a, 0x41, 0x43, 0x02, 0xc9, 0xcb,
+    0x8a, 0x31, 0x35, 0x02, 0xb9, 0xbd, 0x9a, 0x31, 0x45, 0x02, 0xb8, 0xbc, 0x9b, 0x31, 0x45, 0x12,
+    0xa9, 0xbc, 0xab, 0x30, 0x36, 0x22, 0xa8, 0xbd, 0xab, 0x20, 0x45, 0x12, 0xa0, 0xbc, 0xab, 0x28,
+    0x45, 0x22, 0xa0, 0xdb, 0xab, 0x28, 0x63, 0x22, 0x90, 0xdb, 0x9b, 0x19, 0x34, 0x24, 0x90, 0xcb,
+    0xac, 0x08, 0x53, 0x23, 0x80, 0xdb, 0xab, 0x09, 0x53, 0x33, 0x81, 0xdb, 0xac, 0x09, 0x42, 0x24,
+    0x81, 0xca, 0xbb, 0x0a, 0x53, 0x43, 0x01, 0xca, 0xac, 0x0a, 0x32, 0x35, 0x01, 0xba, 0xae, 0x0a,
+    0x31, 0x44, 0x01, 0xb9, 0xbc, 0x8b, 0x32, 0x36, 0x02, 0xb9, 0xbd, 0x9a, 0x31, 0x36, 0x02, 0xb8,
+    0xbd, 0x9a, 0x21, 0x35, 0x13, 0xb8, 0xcd, 0x9a, 0x30, 0x53, 0x22, 0xa9, 0xbc, 0x9c, 0x20, 0x34,
+    0x14, 0xa8, 0xdb, 0x9b, 0x10, 0x44, 0x22, 0xa0, 0xbc, 0x9c, 0x18, 0x34, 0x14, 0x90, 0xdb, 0x9b,
+    0x29, 0x53, 0x23, 0x90, 0xdb, 0x9c, 0x19, 0x43, 0x23, 0x91, 0xdb, 0xac, 0x08, 0x43, 0x33, 0x91,
+    0xdb, 0xac, 0x09, 0x43, 0x43, 0x81, 0xbb, 0xbd, 0x09, 0x42, 0x34, 0x81, 0xca, 0xac, 0x89, 0x42,
+    0x43, 0x01, 0xba, 0xbd, 0x89, 0x41, 0x24, 0x02, 0xc9, 0xcb, 0x8a, 0x41, 0x43, 0x11, 0xb9, 0xbd,
+    0x8a, 0x31, 0x35, 0x12, 0xb9, 0xae, 0x9a, 0x30, 0x35, 0x12, 0xb9, 0xcc, 0x9a, 0x20, 0x35, 0x13,
+    0xb8, 0xbd, 0xab, 0x30, 0x45, 0x12, 0xa0, 0xcc, 0x9a, 0x28, 0x34, 0x23, 0xa0, 0xcd, 0xaa, 0x28,
+    0x34, 0x14, 0x90, 0xbc, 0xbb, 0x28, 0x54, 0x22, 0x90, 0xdb, 0xab, 0x18, 0x53, 0x33, 0x91, 0xcc,
+    0xbb, 0x18, 0x53, 0x33, 0x81, 0xcc, 0xbb, 0x09, 0x63, 0x23, 0x81, 0xda, 0xbb, 0x09, 0x52, 0x43,
+    0x81, 0xca, 0xbb, 0x0a, 0x52, 0x24, 0x82, 0xba, 0xbd, 0x89, 0x42, 0x43, 0x82, 0xc9, 0xcb, 0x0a,
+    0x31, 0x35, 0x02, 0xc9, 0xbc, 0x99, 0x41, 0x43, 0x02, 0xc8, 0xcb, 0x8a, 0x30, 0x35, 0x12, 0xb9,
+    0xbd, 0x9a, 0x30, 0x35, 0x23, 0xb9, 0xcd, 0x9a, 0x20, 0x44, 0x12, 0xa8, 0xdb, 0x9b, 0x38, 0x44,
+    0x22, 0xa8, 0xbc, 0xac, 0x20, 0x53, 0x23, 0xa0, 0xcc, 0x9b, 0x18, 0x34, 0x24, 0x90, 0xbc, 0xac,
+    0x18, 0x53, 0x23, 0xa1, 0xdb, 0xbb, 0x18, 0x53, 0x24, 0x80, 0xcb, 0xbb, 0x09, 0x44, 0x33, 0x91,
+    0xdb, 0xcb, 0x19, 0x42, 0x33, 0x82, 0xdb, 0xac, 0x0a, 0x42, 0x24, 0x82, 0xca, 0xcb, 0x89, 0x42,
+    0x33, 0x03, 0xcb, 0xbd, 0x89, 0x41, 0x43, 0x02, 0xc9, 0xcb, 0x8a, 0x31, 0x35, 0x02, 0xb9, 0xbd,
+    0x9a, 0x31, 0x36, 0x02, 0xa9, 0xbd, 0x9a, 0x30, 0x35, 0x13, 0xb8, 0xcd, 0x9a, 0x21, 0x34, 0x13,
+    0xb8, 0xbd, 0x9c, 0x20, 0x34, 0x14, 0xa8, 0xdb, 0x9b, 0x28, 0x44, 0x22, 0x98, 0xcc, 0xaa, 0x10,
+    0x53, 0x23, 0x90, 0xcc, 0xaa, 0x19, 0x34, 0x24, 0x91, 0xdb, 0xbb, 0x18, 0x53, 0x33, 0x91, 0xeb,
+    0xab, 0x19, 0x43, 0x24, 0x81, 0xcb, 0xac, 0x09, 0x43, 0x43, 0x91, 0xca, 0xbb, 0x0a, 0x53, 0x24,
+    0x82, 0xca, 0xcb, 0x89, 0x42, 0x43, 0x01, 0xba, 0xbd, 0x0a, 0x41, 0x24, 0x02, 0xc9, 0xcb, 0x8a,
+    0x77, 0x77, 0xf7, 0xff, 0x40, 0x24, 0xb8, 0xbc, 0x29, 0x44, 0x01, 0xcb, 0x9b, 0x41, 0x24, 0xa8,
+    0xbc, 0x19, 0x44, 0x82, 0xc9, 0xab, 0x31, 0x25, 0xa1, 0xbc, 0x0a, 0x63, 0x02, 0xb9, 0x9d, 0x20,
+    0x24, 0x91, 0xbc, 0x8a, 0x53, 0x13, 0xc9, 0xac, 0x20, 0x34, 0x91, 0xbc, 0x8b, 0x53, 0x13, 0xc8,
+    0xac, 0x28, 0x34, 0x92, 0xdb, 0x8b, 0x42, 0x23, 0xb8, 0xae, 0x29, 0x43, 0x02, 0xdb, 0x8b, 0x31,
+    0x25, 0xb0, 0xbc, 0x19, 0x63, 0x82, 0xc9, 0x9b, 0x31, 0x34, 0xa0, 0xbd, 0x09, 0x53, 0x12, 0xca,
+    0xab, 0x30, 0x35, 0xa1, 0xcc, 0x89, 0x43, 0x13, 0xd9, 0xab, 0x20, 0x25, 0x81, 0xbc, 0x8a, 0x52,
+    0x13, 0xc8, 0xbb, 0x39, 0x35, 0x82, 0xcc, 0x9a, 0x42, 0x23, 0xb8, 0xbd, 0x29, 0x34, 0x83, 0xeb,
+    0x9a, 0x31, 0x25, 0xa8, 0xbc, 0x19, 0x34, 0x03, 0xdb, 0x9b, 0x40, 0x24, 0xa0, 0xbc, 0x1a, 0x53,
+    0x03, 0xd9, 0x9b, 0x20, 0x25, 0x91, 0xbc, 0x0a, 0x52, 0x13, 0xc9, 0x9c, 0x28, 0x24, 0x92, 0xbc,
+    0x8b, 0x53, 0x13, 0xc8, 0xcb, 0x28, 0x34, 0x92, 0xdb, 0x9a, 0x42, 0x23, 0xb8, 0xbd, 0x29, 0x44,
+    0x01, 0xcb, 0x9b, 0x32, 0x16, 0xa0, 0xcb, 0x19, 0x43, 0x03, 0xdb, 0x9b, 0x31, 0x25, 0x90, 0xad,
+    0x0a, 0x53, 0x02, 0xc9, 0x9b, 0x20, 0x35, 0x90, 0xbc, 0x8a, 0x53, 0x13, 0xc9, 0x9c, 0x28, 0x34,
+    0x91, 0xbc, 0x8b, 0x53, 0x23, 0xc9, 0xac, 0x28, 0x34, 0x92, 0xdb, 0x8b, 0x51, 0x13, 0xa8, 0xad,
+    0x19, 0x34, 0x02, 0xdb, 0x9b, 0x41, 0x14, 0xa0, 0xbc, 0x19, 0x34, 0x03, 0xdb, 0x9b, 0x40, 0x24,
+    0xa0, 0xbc, 0x1a, 0x53, 0x03, 0xca, 0xab, 0x30, 0x35, 0xa1, 0xcc, 0x89, 0x43, 0x13, 0xd9, 0xab,
+    0x20, 0x25, 0x81, 0xbc, 0x0b, 0x52, 0x13, 0xc8, 0xbb, 0x39, 0x35, 0x82, 0xcc, 0x9a, 0x42, 0x23,
+    0xb8, 0xbd, 0x29, 0x44, 0x01, 0xcb, 0x9b, 0x32, 0x16, 0xa0, 0xcb, 0x19, 0x43, 0x03, 0xcb, 0x9c,
+    0x30, 0x25, 0xa0, 0xcb, 0x0a, 0x53, 0x12, 0xba, 0x9d, 0x38, 0x34, 0x90, 0xcc, 0x89, 0x43, 0x12,
+    0xb9, 0xad, 0x28, 0x25, 0x81, 0xdb, 0x0a, 0x41, 0x13, 0xb9, 0xbc, 0x28, 0x35, 0x92, 0xdb, 0x8b,
+    0x42, 0x23, 0xb8, 0xbd, 0x29, 0x44, 0x01, 0xcb, 0x9b, 0x51, 0x23, 0xa8, 0xad, 0x09, 0x34, 0x83,
+    0xda, 0x9b, 0x40, 0x33, 0xb1, 0xbd, 0x0a, 0x44, 0x12, 0xca, 0xab, 0x30, 0x35, 0xa1, 0xcc, 0x89,
+    0x43, 0x13, 0xca, 0xbb, 0x20, 0x36, 0x91, 0xbc, 0x8a, 0x52, 0x13, 0xc8, 0xbb, 0x39, 0x35, 0x82,
+    0xcc, 0x9a, 0x42, 0x23, 0xb8, 0xbd, 0x29, 0x44, 0x01, 0xcb, 0x9a, 0x31, 0x25, 0xa0, 0xad, 0x09,
+    0x53, 0x02, 0xca, 0x9b, 0x40, 0x33, 0xa0, 0xbd, 0x1a, 0x53, 0x12, 0xca, 0xab, 0x30, 0x35, 0xa1,
+    0xcc, 0x0a, 0x43, 0x13, 0xc9, 0xac, 0x38, 0x34, 0x91, 0xcc, 0x0a, 0x41, 0x23, 0xb9, 0xbd, 0x28,
+    0x44, 0x81, 0xcb, 0x9a, 0x42, 0x33, 0xc8, 0xac, 0x19, 0x34, 0x83, 0xdb, 0x9b, 0x41, 0x24, 0xa8,
+    0xbc, 0x19, 0x34, 0x03, 0xdb, 0xab, 0x41, 0x24, 0xa0, 0xbc, 0x1a, 0x53, 0x03, 0xd9, 0x9b, 0x20,
+    0x25, 0x91, 0xbc, 0x8a, 0x53, 0x13, 0xc9, 0x9c, 0x28, 0x34, 0x91, 0xbc, 0x8b, 0x53, 0x23, 0xc9,
+    0xac, 0x28, 0x34, 0x92, 0xdb, 0x8b, 0x42, 0x23, 0xb8, 0xae, 0x29, 0x43, 0x02, 0xdb, 0x8b, 0x31,
+    0x25, 0xb0, 0xbc, 0x19, 0x63, 0x82, 0xc9, 0x9b, 0x31, 0x34, 0xa0, 0xbd, 0x09, 0x53, 0x12, 0xca,
+    0xab, 0x30, 0x26, 0x90, 0xcb, 0x0a, 0x52, 0x03, 0xb9, 0xad, 0x20, 0x34, 0x91, 0xbc, 0x8b, 0x53,
+    0x23, 0xc9, 0xac, 0x28, 0x34, 0x92, 0xdb, 0x8b, 0x51, 0x13, 0xb0, 0xbd, 0x18, 0x34, 0x02, 0xdb,
+    0x9b, 0x41, 0x14, 0xa0, 0xbc, 0x19, 0x34, 0x03, 0xdb, 0xab, 0x41, 0x24, 0xa0, 0xbc, 0x1a, 0x53,
+    0x03, 0xd9, 0x9b, 0x20, 0x25, 0x91, 0xbc, 0x0a, 0x52, 0x13, 0xc9, 0x9c, 0x28, 0x24, 0x92, 0xbc,
+    0x8b, 0x53, 0x13, 0xc8, 0xcb, 0x28, 0x34, 0x92, 0xdb, 0x9a, 0x42, 0x23, 0xb8, 0xbd, 0x29, 0x44,
+    0x01, 0xcb, 0x9b, 0x51, 0x23, 0xa8, 0xad, 0x09, 0x34, 0x02, 0xda, 0x9b, 0x40, 0x33, 0xb1, 0xbd,
+    0x0a, 0x44, 0x12, 0xca, 0xab, 0x30, 0x35, 0xa1, 0xcc, 0x89, 0x43, 0x13, 0xba, 0x9e, 0x28, 0x43,
+    0x91, 0xcb, 0x8b, 0x53, 0x13, 0xb9, 0xad, 0x18, 0x25, 0x92, 0xda, 0x8a, 0x41, 0x13, 0xa8, 0xad,
+    0x19, 0x34, 0x02, 0xdb, 0x9b, 0x41, 0x14, 0xa0, 0xbc, 0x19, 0x34, 0x03, 0xdb, 0xab, 0x41, 0x24,
+    0xa0, 0xbc, 0x1a, 0x53, 0x03, 0xca, 0xab, 0x30, 0x26, 0xa1, 0xcb, 0x8a, 0x53, 0x03, 0xb9, 0xad,
+    0x20, 0x34, 0x91, 0xbc, 0x8b, 0x62, 0x13, 0xb9, 0xbc, 0x28, 0x35, 0x81, 0xdb, 0x9a, 0x42, 0x23,
+    0xb8, 0xbd, 0x29, 0x44, 0x01, 0xcb, 0x9b, 0x32, 0x16, 0xa0, 0xcb, 0x19, 0x43, 0x03, 0xdb, 0x9b,
+    0x31, 0x25, 0x90, 0xad, 0x0a, 0x53, 0x02, 0xc9, 0x9b, 0x20, 0x25, 0x91, 0xbc, 0x8a, 0x53, 0x13,
+    0xc9, 0x9c, 0x28, 0x34, 0x91, 0xbc, 0x8b, 0x53, 0x23, 0xc9, 0xac, 0x28, 0x34, 0x92, 0xdb, 0x8b,
+    0x42, 0x23, 0xb8, 0xae, 0x29, 0x43, 0x02, 0xdb, 0x8b, 0x31, 0x25, 0xa8, 0xbc, 0x19, 0x34, 0x03,
+    0xea, 0x9b, 0x31, 0x34, 0xa0, 0xbd, 0x09, 0x53, 0x12, 0xca, 0xab, 0x30, 0x35, 0xa1, 0xcc, 0x89,
+    0x43, 0x13, 0xba, 0x9e, 0x28, 0x43, 0x91, 0xcb, 0x8b, 0x43, 0x14, 0xb8, 0xad, 0x28, 0x43, 0x82,
+    0xbc, 0x9b, 0x52, 0x23, 0xb8, 0xbd, 0x18, 0x44, 0x01, 0xda, 0x9a, 0x31, 0x24, 0xa0, 0xad, 0x09,
+    0x34, 0x02, 0xda, 0x9b, 0x31, 0x25, 0xa0, 0xbc, 0x1a, 0x53, 0x03, 0xd9, 0x9b, 0x20, 0x25, 0x91,
+    0xbc, 0x0a, 0x52, 0x13, 0xc9, 0x9c, 0x28, 0x24, 0x92, 0xbc, 0x8b, 0x53, 0x13, 0xc8, 0xbb, 0x39,
+    0x35, 0x82, 0xcc, 0x9a, 0x42, 0x23, 0xb8, 0xbd, 0x29, 0x44, 0x01, 0xcb, 0x9b, 0x51, 0x23, 0xa8,
+    0xad, 0x09, 0x34, 0x02, 0xda, 0x9b, 0x40, 0x33, 0xb1, 0xbd, 0x1a, 0x53, 0x03, 0xd9, 0x9b, 0x38,
+    0x35, 0x90, 0xbc, 0x8a, 0x53, 0x13, 0xc9, 0x9c, 0x28, 0x34, 0x91, 0xbc, 0x8b, 0x53, 0x23, 0xc9,
+    0xac, 0x28, 0x34, 0x92, 0xdb, 0x8b, 0x51, 0x13, 0xa8, 0xad, 0x19, 0x34, 0x02, 0xdb, 0x9b, 0x41,
+    0x33, 0xb0, 0xbd, 0x1a, 0x44, 0x02, 0xca, 0xab, 0x31, 0x26, 0xa0, 0xcb, 0x1a, 0x43, 0x03, 0xca,
+    0x9c, 0x38, 0x25, 0x90, 0xcb, 0x8a, 0x53, 0x03, 0xb9, 0xad, 0x20, 0x34, 0x91, 0xbc, 0x8b, 0x53,
+    0x23, 0xc9, 0xac, 0x28, 0x34, 0x82, 0xcc, 0x9a, 0x42, 0x23, 0xb8, 0xae, 0x18, 0x43, 0x82, 0xcb,
+    0x9b, 0x41, 0x24, 0xa0, 0xbd, 0x08, 0x53, 0x02, 0xca, 0x9b, 0x40, 0x33, 0xb1, 0xbd, 0x1a, 0x53,
+    0x03, 0xca, 0xbb, 0x40, 0x34, 0x90, 0xcc, 0x89, 0x43, 0x03, 0xc9, 0xbb, 0x30, 0x35, 0x81, 0xbd,
+    0x8a, 0x52, 0x13, 0xb9, 0xbc, 0x28, 0x35, 0x92, 0xdb, 0x8b, 0x51, 0x13, 0xb8, 0xbc, 0x29, 0x44,
+    0x82, 0xda, 0x9a, 0x31, 0x15, 0xa0, 0xac, 0x09, 0x34, 0x03, 0xdb, 0x9b, 0x40, 0x24, 0xa0, 0xbc,
+    0x09, 0x53, 0x03, 0xca, 0xab, 0x30, 0x26, 0x90, 0xcb, 0x0a, 0x52, 0x03, 0xb9, 0xad, 0x20, 0x34,
+    0x91, 0xbc, 0x8b, 0x53, 0x23, 0xc9, 0xac, 0x28, 0x34, 0x92, 0xdb, 0x9b, 0x52, 0x13, 0xb0, 0xbd,
+    0x18, 0x34, 0x02, 0xdb, 0x9b, 0x41, 0x33, 0xb0, 0xae, 0x09, 0x34, 0x02, 0xda, 0x9b, 0x40, 0x33,
+    0xa0, 0xbd, 0x0a, 0x44, 0x02, 0xc9, 0xab, 0x30, 0x35, 0xa1, 0xbc, 0x0b, 0x53, 0x23, 0xca, 0xac,
+    0x20, 0x34, 0x92, 0xcc, 0x8a, 0x42, 0x23, 0xb9, 0xbd, 0x28, 0x44, 0x81, 0xcb, 0x8b, 0x42, 0x23,
+    0xc0, 0xbc, 0x18, 0x34, 0x83, 0xdb, 0x9b, 0x41, 0x24, 0xa8, 0xbc, 0x19, 0x63, 0x82, 0xc9, 0x9b,
+    0x31, 0x34, 0xa0, 0xbd, 0x09, 0x53, 0x12, 0xca, 0xab, 0x30, 0x26, 0xa1, 0xcb, 0x0a, 0x52, 0x03,
+    0xb9, 0xad, 0x20, 0x34, 0x91, 0xbc, 0x8b, 0x53, 0x23, 0xc9, 0xac, 0x28, 0x34, 0x92, 0xdb, 0x8b,
+    0x51, 0x13, 0xb0, 0xad, 0x19, 0x34, 0x02, 0xdb, 0x9b, 0x41, 0x33, 0xb0, 0xae, 0x09, 0x53, 0x02,
+    0xca, 0x9b, 0x40, 0x33, 0xa0, 0xbd, 0x0a, 0x34, 0x13, 0xda, 0xbb, 0x31, 0x26, 0x91, 0xbc, 0x0a,
+    0x43, 0x04, 0xc8, 0xab, 0x38, 0x35, 0x91, 0xbc, 0x8b, 0x53, 0x13, 0xc8, 0xac, 0x28, 0x34, 0x81,
+    0xdb, 0x8b, 0x42, 0x23, 0xb8, 0xae, 0x29, 0x43, 0x02, 0xdb, 0x9a, 0x31, 0x25, 0xb0, 0xbc, 0x19,
+    0x63, 0x82, 0xc9, 0xaa, 0x31, 0x25, 0xa0, 0xbc, 0x09, 0x53, 0x03, 0xca, 0xab, 0x30, 0x35, 0xa1,
+    0xbc, 0x0b, 0x53, 0x23, 0xca, 0xac, 0x20, 0x34, 0x92, 0xcc, 0x8a, 0x42, 0x23, 0xb9, 0xbd, 0x28,
+    0x70, 0x77, 0xfd, 0xff, 0x75, 0x96, 0xbc, 0x29, 0x43, 0x91, 0xbc, 0x18, 0x43, 0xa1, 0xbb, 0x19,
+    0x25, 0x91, 0xcb, 0x29, 0x33, 0xa1, 0xbc, 0x29, 0x34, 0xa1, 0xbc, 0x29, 0x24, 0x91, 0xac, 0x19,
+    0x43, 0x91, 0xac, 0x19, 0x43, 0x90, 0xca, 0x18, 0x32, 0x91, 0xbc, 0x18, 0x43, 0x91, 0xac, 0x19,
+    0x43, 0xa1, 0xbb, 0x19, 0x25, 0x91, 0xcb, 0x18, 0x33, 0x91, 0xad, 0x19, 0x70, 0x77, 0x77, 0x77,
+    0xf4, 0xac, 0x9a, 0x00, 0x43, 0x34, 0x33, 0x82, 0xb9, 0xcd, 0xac, 0x9a, 0x08, 0x43, 0x34, 0x33,
+    0x02, 0xb9, 0xcd, 0xcb, 0xaa, 0x18, 0x32, 0x36, 0x23, 0x12, 0xa9, 0xdc, 0xbb, 0xab, 0x19, 0x42,
+    0x35, 0x24, 0x02, 0x98, 0xbc, 0xad, 0xab, 0x88, 0x32, 0x45, 0x23, 0x03, 0xa0, 0xdb, 0xbc, 0xab,
+    0x0a, 0x41, 0x44, 0x23, 0x13, 0x98, 0xdb, 0xbc, 0xab, 0x8a, 0x41, 0x53, 0x24, 0x12, 0x90, 0xca,
+    0xbc, 0xbb, 0x99, 0x31, 0x45, 0x43, 0x12, 0x91, 0xca, 0xdb, 0xba, 0x99, 0x11, 0x44, 0x24, 0x22,
+    0x80, 0xc9, 0xbc, 0xbb, 0x8b, 0x20, 0x54, 0x43, 0x22, 0x81, 0xc9, 0xdb, 0xab, 0x9a, 0x10, 0x53,
+    0x34, 0x23, 0x01, 0xba, 0xcd, 0xcb, 0x99, 0x18, 0x42, 0x34, 0x33, 0x01, 0xc9, 0xdb, 0xcb, 0x9a,
+    0x00, 0x42, 0x34, 0x33, 0x01, 0xb8, 0xcd, 0xbb, 0xab, 0x19, 0x53, 0x34, 0x24, 0x02, 0xa8, 0xcc,
+    0xcb, 0x9a, 0x09, 0x42, 0x53, 0x32, 0x11, 0xa8, 0xdb, 0xbc, 0xaa, 0x09, 0x32, 0x45, 0x33, 0x12,
+    0xa0, 0xcc, 0xdb, 0xaa, 0x88, 0x31, 0x44, 0x33, 0x22, 0x98, 0xeb, 0xcb, 0xba, 0x09, 0x30, 0x35,
+    0x34, 0x22, 0x90, 0xdb, 0xdb, 0xaa, 0x89, 0x20, 0x44, 0x33, 0x23, 0x80, 0xdb, 0xbc, 0xac, 0x8a,
+    0x20, 0x44, 0x33, 0x33, 0x80, 0xda, 0xbc, 0xac, 0x9a, 0x20, 0x34, 0x35, 0x22, 0x81, 0xba, 0xcd,
+    0xbb, 0x9a, 0x10, 0x44, 0x43, 0x23, 0x01, 0xba, 0xcd, 0xbb, 0x9a, 0x28, 0x53, 0x34, 0x33, 0x01,
+    0xb9, 0xbe, 0xbc, 0x9a, 0x18, 0x52, 0x43, 0x33, 0x01, 0xb8, 0xdc, 0xbb, 0xab, 0x08, 0x53, 0x34,
+    0x24, 0x01, 0xa8, 0xdb, 0xcb, 0xaa, 0x19, 0x41, 0x34, 0x24, 0x02, 0x98, 0xbc, 0xbd, 0xaa, 0x09,
+    0x32, 0x45, 0x33, 0x02, 0xa0, 0xdb, 0xbc, 0xab, 0x0a, 0x41, 0x44, 0x23, 0x13, 0xa0, 0xdb, 0xbc,
+    0xbb, 0x89, 0x41, 0x53, 0x24, 0x12, 0x90, 0xca, 0xbc, 0xbb, 0x99, 0x31, 0x45, 0x43, 0x12, 0x91,
+    0xca, 0xdb, 0xab, 0x99, 0x30, 0x63, 0x33, 0x23, 0x91, 0xca, 0xbd, 0xcb, 0x99, 0x20, 0x53, 0x43,
+    0x22, 0x81, 0xc9, 0xdb, 0xab, 0x9a, 0x28, 0x53, 0x34, 0x23, 0x01, 0xba, 0xcd, 0xcb, 0x99, 0x18,
+    0x42, 0x34, 0x33, 0x01, 0xb9, 0xbe, 0xac, 0xaa, 0x18, 0x43, 0x34, 0x24, 0x11, 0xa9, 0xcc, 0xcb,
+    0x9a, 0x08, 0x32, 0x36, 0x32, 0x02, 0xa8, 0xbd, 0xbc, 0xab, 0x09, 0x43, 0x44, 0x33, 0x12, 0x99,
+    0xcc, 0xbc, 0xab, 0x08, 0x41, 0x34, 0x34, 0x02, 0xa0, 0xdb, 0xbc, 0xba, 0x09, 0x41, 0x53, 0x33,
+    0x13, 0x90, 0xcc, 0xdb, 0xaa, 0x89, 0x21, 0x44, 0x43, 0x21, 0x88, 0xca, 0xbc, 0xab, 0x8a, 0x30,
+    0x45, 0x33, 0x23, 0x91, 0xdb, 0xbc, 0xac, 0x8a, 0x20, 0x44, 0x33, 0x14, 0x91, 0xc9, 0xcb, 0xac,
+    0x99, 0x20, 0x43, 0x34, 0x23, 0x01, 0xca, 0xcc, 0xbb, 0x9a, 0x10, 0x44, 0x53, 0x22, 0x00, 0xb9,
+    0xcc, 0xbb, 0xaa, 0x10, 0x63, 0x43, 0x32, 0x81, 0xa9, 0xbd, 0xbc, 0xaa, 0x00, 0x53, 0x53, 0x22,
+    0x01, 0xa8, 0xcc, 0xbb, 0xab, 0x08, 0x53, 0x34, 0x24, 0x11, 0xa8, 0xcc, 0xbb, 0xbb, 0x08, 0x43,
+    0x35, 0x24, 0x12, 0xa8, 0xbc, 0xbd, 0xaa, 0x09, 0x32, 0x45, 0x33, 0x12, 0x98, 0xcc, 0xcb, 0xab,
+    0x89, 0x32, 0x45, 0x33, 0x12, 0x90, 0xcc, 0xcb, 0xab, 0x8a, 0x22, 0x36, 0x43, 0x12, 0x90, 0xca,
+    0xbc, 0xac, 0x89, 0x30, 0x63, 0x23, 0x23, 0x90, 0xca, 0xbd, 0xbb, 0x99, 0x21, 0x54, 0x33, 0x33,
+    0x80, 0xcb, 0xbd, 0xac, 0x8a, 0x10, 0x34, 0x25, 0x23, 0x81, 0xba, 0xbe, 0xbb, 0x9b, 0x20, 0x44,
+    0x34, 0x33, 0x81, 0xc9, 0xcc, 0xbb, 0x9a, 0x18, 0x63, 0x33, 0x24, 0x01, 0xb9, 0xcc, 0xcb, 0x9a,
+    0x18, 0x42, 0x34, 0x33, 0x03, 0xb9, 0xcd, 0xac, 0x9b, 0x08, 0x42, 0x34, 0x24, 0x11, 0x99, 0xbc,
+    0xbd, 0xaa, 0x08, 0x32, 0x36, 0x33, 0x03, 0xb0, 0xcc, 0xbc, 0xbb, 0x08, 0x42, 0x34, 0x34, 0x03,
+    0xa0, 0xeb, 0xbb, 0xac, 0x09, 0x31, 0x35, 0x34, 0x12, 0x98, 0xdb, 0xcb, 0xab, 0x99, 0x31, 0x45,
+    0x33, 0x13, 0x90, 0xdb, 0xdb, 0xab, 0x89, 0x30, 0x44, 0x43, 0x12, 0x91, 0xba, 0xae, 0xbb, 0x8b,
+    0x21, 0x54, 0x33, 0x33, 0x80, 0xcb, 0xbd, 0xbb, 0xab, 0x31, 0x35, 0x35, 0x13, 0x01, 0xba, 0xbe,
+    0xbb, 0x9b, 0x30, 0x73, 0x72, 0x77, 0x77, 0x77, 0x97, 0x99, 0xba, 0xaa, 0x9a, 0x08, 0x31, 0x44,
+    0x34, 0x33, 0x22, 0x81, 0xba, 0xbe, 0xbd, 0xab, 0xab, 0x88, 0x32, 0x45, 0x34, 0x33, 0x23, 0x81,
+    0xb9, 0xcd, 0xcc, 0xba, 0x9a, 0x89, 0x21, 0x44, 0x34, 0x43, 0x22, 0x00, 0xa8, 0xcc, 0xcb, 0xac,
+    0xaa, 0x89, 0x11, 0x34, 0x35, 0x24, 0x23, 0x01, 0xa8, 0xbc, 0xcd, 0xba, 0xab, 0x99, 0x20, 0x63,
+    0x43, 0x43, 0x22, 0x02, 0x98, 0xdb, 0xcb, 0xbc, 0xaa, 0x8a, 0x28, 0x52, 0x34, 0x34, 0x32, 0x02,
+    0x90, 0xdb, 0xbc, 0xbc, 0xbb, 0x9a, 0x18, 0x53, 0x44, 0x33, 0x33, 0x13, 0x90, 0xdb, 0xcc, 0xcb,
+    0xab, 0x9a, 0x18, 0x32, 0x36, 0x34, 0x24, 0x11, 0x80, 0xb9, 0xbd, 0xad, 0xbb, 0x9a, 0x09, 0x42,
+    0x34, 0x35, 0x33, 0x22, 0x80, 0xc9, 0xcc, 0xcb, 0xbb, 0xaa, 0x09, 0x41, 0x53, 0x34, 0x33, 0x23,
+    0x81, 0xb9, 0xbe, 0xbd, 0xbb, 0xaa, 0x89, 0x31, 0x45, 0x34, 0x33, 0x14, 0x01, 0xa9, 0xbc, 0xbd,
+    0xbc, 0xaa, 0x89, 0x21, 0x63, 0x43, 0x43, 0x12, 0x01, 0xa8, 0xcb, 0xcc, 0xbb, 0xab, 0x8a, 0x20,
+    0x44, 0x44, 0x33, 0x32, 0x11, 0xa8, 0xeb, 0xdb, 0xab, 0xbb, 0x99, 0x10, 0x34, 0x45, 0x33, 0x33,
+    0x12, 0xa8, 0xdb, 0xcc, 0xcb, 0xaa, 0x8a, 0x18, 0x42, 0x44, 0x33, 0x33, 0x13, 0x90, 0xeb, 0xcb,
+    0xbc, 0xab, 0xaa, 0x00, 0x43, 0x44, 0x24, 0x33, 0x12, 0x80, 0xca, 0xcc, 0xcb, 0xab, 0xaa, 0x08,
+    0x42, 0x34, 0x35, 0x23, 0x13, 0x81, 0xca, 0xcc, 0xcb, 0xbb, 0xaa, 0x08, 0x41, 0x53, 0x34, 0x33,
+    0x23, 0x00, 0xba, 0xdd, 0xbb, 0xbc, 0xaa, 0x09, 0x31, 0x54, 0x43, 0x33, 0x22, 0x01, 0xb9, 0xdc,
+    0xdb, 0xba, 0xaa, 0x89, 0x21, 0x44, 0x34, 0x43, 0x22, 0x01, 0x99, 0xcc, 0xcb, 0xac, 0xaa, 0x89,
+    0x10, 0x34, 0x35, 0x43, 0x23, 0x01, 0x98, 0xbc, 0xcd, 0xba, 0xab, 0x8a, 0x10, 0x53, 0x44, 0x33,
+    0x33, 0x11, 0x98, 0xeb, 0xdb, 0xbb, 0xba, 0x9a, 0x10, 0x53, 0x44, 0x33, 0x33, 0x12, 0x90, 0xdb,
+    0xcc, 0xcb, 0xba, 0x99, 0x08, 0x33, 0x36, 0x34, 0x33, 0x22, 0x88, 0xda, 0xbc, 0xcc, 0xaa, 0x9a,
+    0x08, 0x32, 0x35, 0x35, 0x23, 0x13, 0x80, 0xc9, 0xcc, 0xcb, 0xbb, 0x9a, 0x09, 0x32, 0x45, 0x34,
+    0x33, 0x22, 0x81, 0xba, 0xdd, 0xbb, 0xbc, 0x9a, 0x89, 0x31, 0x35, 0x35, 0x43, 0x12, 0x81, 0xa9,
+    0xeb, 0xbb, 0xbc, 0xab, 0x88, 0x30, 0x54, 0x43, 0x33, 0x23, 0x01, 0xa9, 0xdc, 0xdb, 0xba, 0xaa,
+    0x8a, 0x21, 0x63, 0x43, 0x33, 0x33, 0x02, 0xb8, 0xcc, 0xcc, 0xbb, 0xbb, 0x99, 0x20, 0x44, 0x44,
+    0x33, 0x32, 0x02, 0xa0, 0xeb, 0xdb, 0xbb, 0xba, 0x8a, 0x28, 0x43, 0x45, 0x33, 0x33, 0x12, 0x90,
+    0xbc, 0xbe, 0xcb, 0xbb, 0x99, 0x18, 0x42, 0x35, 0x34, 0x33, 0x12, 0x90, 0xda, 0xdb, 0xcb, 0xab,
+    0x9a, 0x08, 0x42, 0x34, 0x35, 0x32, 0x22, 0x80, 0xca, 0xcc, 0xcb, 0xbb, 0x9a, 0x08, 0x41, 0x63,
+    0x33, 0x33, 0x23, 0x81, 0xca, 0xcc, 0xbc, 0xcb, 0x9a, 0x09, 0x31, 0x44, 0x53, 0x32, 0x22, 0x00,
+    0xb9, 0xcc, 0xbc, 0xac, 0xaa, 0x09, 0x30, 0x63, 0x43, 0x33, 0x23, 0x01, 0xa9, 0xcd, 0xcb, 0xcb,
+    0xaa, 0x88, 0x20, 0x53, 0x53, 0x33, 0x22, 0x02, 0x99, 0xcc, 0xbc, 0xbc, 0xab, 0x89, 0x10, 0x44,
+    0x53, 0x33, 0x23, 0x02, 0x98, 0xcc, 0xbc, 0xbc, 0xab, 0x9a, 0x20, 0x53, 0x44, 0x33, 0x33, 0x11,
+    0x90, 0xbc, 0xbe, 0xcb, 0xab, 0x9a, 0x18, 0x43, 0x44, 0x24, 0x33, 0x11, 0x80, 0xcb, 0xcc, 0xcb,
+    0xba, 0x9a, 0x18, 0x42, 0x34, 0x35, 0x32, 0x12, 0x91, 0xba, 0xbe, 0xad, 0xbb, 0x9a, 0x09, 0x42,
+    0x63, 0x33, 0x33, 0x23, 0x81, 0xca, 0xbd, 0xcc, 0xba, 0xaa, 0x08, 0x31, 0x54, 0x43, 0x23, 0x13,
+    0x01, 0xb9, 0xcd, 0xcb, 0xbb, 0xab, 0x89, 0x31, 0x45, 0x34, 0x33, 0x14, 0x01, 0xa9, 0xbc, 0xbd,
+    0xbc, 0xaa, 0x09, 0x20, 0x44, 0x53, 0x23, 0x23, 0x01, 0xa8, 0xcc, 0xbc, 0xbc, 0xaa, 0x8a, 0x11,
+    0x44, 0x53, 0x33, 0x32, 0x11, 0xa8, 0xeb, 0xdb, 0xab, 0xbb, 0x99, 0x20, 0x53, 0x44, 0x33, 0x23,
+    0x12, 0x98, 0xeb, 0xcb, 0xbc, 0xba, 0x99, 0x18, 0x43, 0x35, 0x34, 0x33, 0x11, 0x90, 0xda, 0xbc,
+    0xbc, 0xac, 0x99, 0x18, 0x41, 0x53, 0x43, 0x22, 0x12, 0x80, 0xba, 0xcd, 0xcb, 0xab, 0xaa, 0x08,
+    0x42, 0x34, 0x35, 0x23, 0x13, 0x81, 0xca, 0xcc, 0xcb, 0xbb, 0x9a, 0x09, 0x41, 0x34, 0x35, 0x33,
+    0x13, 0x01, 0xba, 0xbe, 0xbd, 0xba, 0xab, 0x89, 0x32, 0x45, 0x53, 0x32, 0x22, 0x01, 0xb9, 0xcc,
+    0xbc, 0xac, 0x9b, 0x89, 0x30, 0x63, 0x43, 0x33, 0x33, 0x01, 0xb8, 0xdc, 0xcb, 0xac, 0xaa, 0x89,
+    0x10, 0x34, 0x35, 0x24, 0x23, 0x11, 0x99, 0xbc, 0xcd, 0xba, 0xab, 0x8a, 0x28, 0x63, 0x43, 0x43,
+    0x22, 0x02, 0x90, 0xdb, 0xcb, 0xbc, 0xba, 0x99, 0x10, 0x52, 0x34, 0x34, 0x23, 0x12, 0x90, 0xdb,
+    0xbc, 0xbc, 0xac, 0x99, 0x18, 0x32, 0x45, 0x33, 0x24, 0x12, 0x90, 0xc9, 0xbc, 0xad, 0xbb, 0x9a,
+    0x08, 0x42, 0x34, 0x35, 0x33, 0x12, 0x81, 0xca, 0xcc, 0xcb, 0xbb, 0xaa, 0x08, 0x41, 0x34, 0x35,
+    0x33, 0x23, 0x00, 0xba, 0xce, 0xbb, 0xbc, 0xaa, 0x09, 0x31, 0x45, 0x43, 0x33, 0x22, 0x01, 0xb9,
+    0xcd, 0xdb, 0xba, 0xaa, 0x09, 0x30, 0x44, 0x53, 0x23, 0x23, 0x01, 0xb8, 0xcc, 0xbc, 0xbc, 0xaa,
+    0x99, 0x21, 0x63, 0x43, 0x43, 0x22, 0x01, 0x98, 0xdb, 0xbc, 0xcb, 0xaa, 0x8a, 0x10, 0x63, 0x33,
+    0x34, 0x14, 0x02, 0x98, 0xca, 0xcc, 0xbb, 0xab, 0x9a, 0x10, 0x63, 0x43, 0x43, 0x23, 0x12, 0x98,
+    0xcb, 0xbd, 0xac, 0xbb, 0x9a, 0x18, 0x43, 0x35, 0x34, 0x33, 0x22, 0x90, 0xcb, 0xbd, 0xbd, 0xba,
+    0x9a, 0x08, 0x42, 0x44, 0x33, 0x34, 0x12, 0x80, 0xba, 0xcd, 0xac, 0xbb, 0x9b, 0x09, 0x32, 0x36,
+    0x35, 0x32, 0x13, 0x81, 0xb9, 0xbe, 0xbc, 0xac, 0xaa, 0x88, 0x31, 0x44, 0x34, 0x43, 0x12, 0x01,
+    0xb9, 0xeb, 0xcb, 0xbb, 0xab, 0x09, 0x31, 0x54, 0x43, 0x43, 0x12, 0x01, 0xa8, 0xdb, 0xbc, 0xcb,
+    0xaa, 0x89, 0x20, 0x34, 0x35, 0x34, 0x32, 0x01, 0xa9, 0xeb, 0xcb, 0xbb, 0x9c, 0x8a, 0x20, 0x43,
+    0x44, 0x33, 0x33, 0x02, 0xb0, 0xeb, 0xdb, 0xbb, 0xbb, 0x99, 0x28, 0x53, 0x44, 0x33, 0x33, 0x13,
+    0xa0, 0xeb, 0xdb, 0xbb, 0xbb, 0x9b, 0x18, 0x63, 0x53, 0x33, 0x33, 0x12, 0x91, 0xdb, 0xbc, 0xbd,
+    0xab, 0x9a, 0x18, 0x32, 0x36, 0x34, 0x24, 0x12, 0x80, 0xba, 0xbd, 0xbd, 0xba, 0x9b, 0x19, 0x32,
+    0x36, 0x25, 0x33, 0x22, 0x91, 0xc9, 0xdb, 0xac, 0xbb, 0xab, 0x09, 0x41, 0x34, 0x35, 0x24, 0x22,
+    0x00, 0xb9, 0xbc, 0xae, 0xbb, 0xab, 0x09, 0x31, 0x45, 0x33, 0x34, 0x32, 0x01, 0xb9, 0xbd, 0xbd,
+    0xbb, 0xab, 0x0a, 0x31, 0x35, 0x34, 0x53, 0x12, 0x11, 0xa9, 0xda, 0xdb, 0xba, 0xba, 0x99, 0x21,
+    0x63, 0x33, 0x33, 0x24, 0x11, 0x99, 0xeb, 0xba, 0xcb, 0xba, 0x99, 0x11, 0x53, 0x43, 0x32, 0x33,
+    0x12, 0x90, 0xdb, 0xbb, 0xbc, 0xab, 0x9a, 0x19, 0x43, 0x43, 0x33, 0x24, 0x12, 0x99, 0xbb, 0xbd,
+    0xcb, 0xaa, 0x9a, 0x10, 0x33, 0x35, 0x32, 0x24, 0x12, 0x90, 0xbb, 0xbc, 0x70, 0x77, 0x77, 0x77,
+    0x07, 0x98, 0x99, 0xaa, 0xba, 0xab, 0xaa, 0x09, 0x20, 0x44, 0x34, 0x44, 0x32, 0x32, 0x11, 0x80,
+    0xba, 0xcd, 0xbc, 0xbc, 0xbb, 0xab, 0x89, 0x20, 0x63, 0x34, 0x34, 0x34, 0x23, 0x12, 0x81, 0xba,
+    0xdc, 0xbc, 0xbc, 0xbb, 0xab, 0x9a, 0x20, 0x53, 0x44, 0x34, 0x43, 0x32, 0x21, 0x00, 0xa9, 0xcc,
+    0xcc, 0xbb, 0xac, 0xab, 0x99, 0x18, 0x42, 0x44, 0x43, 0x24, 0x33, 0x12, 0x01, 0xa8, 0xcc, 0xdb,
+    0xac, 0xbb, 0xbb, 0x9a, 0x08, 0x42, 0x44, 0x34, 0x34, 0x33, 0x23, 0x01, 0x98, 0xcc, 0xcc, 0xcb,
+    0xbb, 0xbb, 0x9a, 0x09, 0x32, 0x45, 0x44, 0x33, 0x24, 0x23, 0x01, 0x90, 0xcb, 0xcc, 0xbc, 0xcb,
+    0xba, 0x9a, 0x09, 0x21, 0x44, 0x34, 0x44, 0x32, 0x32, 0x11, 0x90, 0xba, 0xbe, 0xbd, 0xcb, 0xba,
+    0xaa, 0x89, 0x20, 0x44, 0x53, 0x43, 0x33, 0x33, 0x12, 0x80, 0xba, 0xce, 0xcb, 0xac, 0xbb, 0xaa,
+    0x99, 0x20, 0x53, 0x34, 0x35, 0x43, 0x32, 0x21, 0x80, 0xa9, 0xdc, 0xcb, 0xcb, 0xbb, 0xba, 0x99,
+    0x10, 0x52, 0x34, 0x35, 0x43, 0x32, 0x12, 0x01, 0xa9, 0xcc, 0xbc, 0xad, 0xbb, 0xbb, 0x99, 0x08,
+    0x52, 0x53, 0x53, 0x32, 0x33, 0x23, 0x01, 0xa8, 0xcc, 0xcc, 0xcb, 0xbb, 0xbb, 0x9a, 0x08, 0x41,
+    0x44, 0x34, 0x34, 0x33, 0x23, 0x11, 0xa8, 0xdb, 0xbd, 0xbc, 0xbc, 0xab, 0xaa, 0x88, 0x31, 0x45,
+    0x53, 0x33, 0x24, 0x23, 0x11, 0x98, 0xca, 0xcc, 0xdb, 0xba, 0xbb, 0xaa, 0x89, 0x21, 0x54, 0x53,
+    0x33, 0x24, 0x23, 0x12, 0x90, 0xba, 0xcd, 0xbc, 0xbc, 0xbb, 0xab, 0x89, 0x20, 0x44, 0x44, 0x43,
+    0x33, 0x33, 0x12, 0x80, 0xc9, 0xcc, 0xdb, 0xbb, 0xac, 0x9b, 0x8a, 0x10, 0x43, 0x44, 0x34, 0x43,
+    0x22, 0x22, 0x00, 0xb9, 0xeb, 0xbc, 0xbc, 0xbb, 0xbb, 0x8a, 0x18, 0x43, 0x45, 0x34, 0x43, 0x32,
+    0x12, 0x01, 0xa8, 0xcc, 0xbc, 0xcc, 0xba, 0xab, 0x8a, 0x08, 0x32, 0x45, 0x34, 0x34, 0x33, 0x23,
+    0x01, 0xa8, 0xeb, 0xbc, 0xbc, 0xbc, 0xab, 0x9a, 0x09, 0x32, 0x54, 0x34, 0x34, 0x33, 0x23, 0x02,
+    0xa0, 0xdb, 0xcc, 0xbc, 0xcb, 0xba, 0xa9, 0x88, 0x21, 0x44, 0x44, 0x33, 0x24, 0x23, 0x11, 0x90,
+    0xca, 0xcc, 0xcb, 0xac, 0xbb, 0x9a, 0x89, 0x20, 0x44, 0x34, 0x44, 0x32, 0x23, 0x21, 0x90, 0xc9,
+    0xeb, 0xbb, 0xad, 0xbb, 0xaa, 0x99, 0x20, 0x53, 0x44, 0x43, 0x33, 0x33, 0x12, 0x81, 0xc9, 0xbc,
+    0xbe, 0xcb, 0xab, 0xab, 0x8a, 0x10, 0x52, 0x34, 0x35, 0x43, 0x32, 0x12, 0x81, 0xb8, 0xeb, 0xbc,
+    0xbc, 0xbb, 0xbb, 0x9a, 0x18, 0x43, 0x45, 0x53, 0x32, 0x33, 0x23, 0x01, 0xa9, 0xcc, 0xcc, 0xcb,
+    0xbb, 0xbb, 0x9a, 0x08, 0x42, 0x44, 0x34, 0x34, 0x33, 0x23, 0x11, 0x99, 0xeb, 0xdb, 0xcb, 0xbb,
+    0xbb, 0x9b, 0x09, 0x32, 0x45, 0x44, 0x33, 0x24, 0x23, 0x01, 0x90, 0xca, 0xcc, 0xbc, 0xcb, 0xba,
+    0x9a, 0x89, 0x21, 0x44, 0x34, 0x44, 0x32, 0x23, 0x11, 0x90, 0xc9, 0xcc, 0xcb, 0xac, 0xbb, 0xaa,
+    0x09, 0x10, 0x44, 0x53, 0x43, 0x33, 0x33, 0x12, 0x80, 0xc9, 0xcc, 0xbc, 0xbc, 0xbb, 0xab, 0x99,
+    0x20, 0x53, 0x35, 0x34, 0x34, 0x23, 0x22, 0x00, 0xb9, 0xcd, 0xdb, 0xbb, 0xac, 0xab, 0x99, 0x10,
+    0x42, 0x44, 0x53, 0x32, 0x33, 0x22, 0x01, 0xa9, 0xdc, 0xdb, 0xbb, 0xac, 0xab, 0x9a, 0x18, 0x32,
+    0x45, 0x34, 0x34, 0x33, 0x23, 0x01, 0xa8, 0xcc, 0xcc, 0xcb, 0xbb, 0xbb, 0x9a, 0x08, 0x41, 0x44,
+    0x53, 0x33, 0x24, 0x13, 0x02, 0x98, 0xcb, 0xcc, 0xbc, 0xcb, 0xaa, 0xaa, 0x88, 0x31, 0x63, 0x34,
+    0x34, 0x33, 0x33, 0x02, 0x90, 0xcb, 0xcd, 0xbc, 0xcb, 0xba, 0x9a, 0x89, 0x20, 0x44, 0x34, 0x44,
+    0x32, 0x23, 0x02, 0x80, 0xba, 0xcd, 0xbc, 0xbc, 0xbb, 0xab, 0x89, 0x20, 0x63, 0x34, 0x34, 0x34,
+    0x23, 0x12, 0x81, 0xba, 0xdc, 0xbc, 0xbc, 0xbb, 0xab, 0x8a, 0x28, 0x53, 0x44, 0x34, 0x43, 0x32,
+    0x21, 0x00, 0xa9, 0xcc, 0xcc, 0xbb, 0xac, 0xab, 0x99, 0x18, 0x42, 0x44, 0x43, 0x24, 0x33, 0x12,
+    0x01, 0xa8, 0xcc, 0xbc, 0xcc, 0xba, 0xab, 0xa9, 0x18, 0x41, 0x63, 0x33, 0x25, 0x33, 0x22, 0x11,
+    0xa8, 0xdb, 0xcc, 0xcb, 0xbb, 0xbb, 0x9a, 0x09, 0x41, 0x34, 0x36, 0x43, 0x23, 0x23, 0x02, 0x98,
+    0xda, 0xbc, 0xbd, 0xcb, 0xba, 0x9a, 0x09, 0x30, 0x63, 0x34, 0x34, 0x33, 0x33, 0x12, 0x90, 0xcb,
+    0xcd, 0xdb, 0xba, 0xbb, 0xab, 0x89, 0x21, 0x44, 0x44, 0x43, 0x33, 0x33, 0x12, 0x80, 0xca, 0xcc,
+    0xbc, 0xbc, 0xbb, 0xab, 0x99, 0x11, 0x63, 0x53, 0x43, 0x33, 0x33, 0x13, 0x81, 0xba, 0xcd, 0xcc,
+    0xbb, 0xac, 0xab, 0x89, 0x18, 0x42, 0x44, 0x34, 0x43, 0x32, 0x12, 0x01, 0xa9, 0xcc, 0xbc, 0xcc,
+    0xba, 0xab, 0x99, 0x18, 0x41, 0x44, 0x43, 0x24, 0x33, 0x22, 0x81, 0x98, 0xcc, 0xdb, 0xcb, 0xbb,
+    0xbb, 0x9a, 0x08, 0x41, 0x44, 0x34, 0x34, 0x33, 0x23, 0x11, 0xa8, 0xdb, 0xbd, 0xbc, 0xbc, 0xab,
+    0xaa, 0x88, 0x31, 0x45, 0x53, 0x33, 0x24, 0x23, 0x11, 0x98, 0xca, 0xcc, 0xdb, 0xba, 0xbb, 0xaa,
+    0x89, 0x21, 0x54, 0x53, 0x33, 0x24, 0x23, 0x12, 0x90, 0xba, 0xcd, 0xbc, 0xbc, 0xbb, 0xab, 0x89,
+    0x20, 0x44, 0x44, 0x43, 0x33, 0x33, 0x12, 0x80, 0xc9, 0xcc, 0xdb, 0xbb, 0xac, 0x9b, 0x8a, 0x10,
+    0x43, 0x44, 0x34, 0x43, 0x22, 0x22, 0x00, 0xb9, 0xeb, 0xbc, 0xbc, 0xbb, 0xbb, 0x8a, 0x18, 0x43,
+    0x45, 0x34, 0x43, 0x32, 0x12, 0x01, 0xa8, 0xcc, 0xbc, 0xcc, 0xba, 0xab, 0x8a, 0x08, 0x32, 0x45,
+    0x34, 0x34, 0x33, 0x23, 0x01, 0xa8, 0xeb, 0xbc, 0xbc, 0xbc, 0xab, 0x9a, 0x09, 0x32, 0x54, 0x34,
+    0x34, 0x33, 0x23, 0x02, 0xa0, 0xdb, 0xcc, 0xbc, 0xcb, 0xba, 0xa9, 0x88, 0x21, 0x44, 0x44, 0x33,
+    0x24, 0x23, 0x11, 0x90, 0xca, 0xcc, 0xcb, 0xac, 0xbb, 0x9a, 0x89, 0x20, 0x44, 0x34, 0x44, 0x32,
+    0x23, 0x21, 0x90, 0xc9, 0xeb, 0xbb, 0xad, 0xbb, 0xaa, 0x99, 0x20, 0x53, 0x44, 0x43, 0x33, 0x33,
+    0x12, 0x81, 0xc9, 0xbc, 0xbe, 0xcb, 0xab, 0xab, 0x8a, 0x10, 0x52, 0x34, 0x35, 0x43, 0x32, 0x12,
+    0x81, 0xb8, 0xeb, 0xbc, 0xbc, 0xbb, 0xbb, 0x9a, 0x18, 0x43, 0x45, 0x53, 0x32, 0x33, 0x23, 0x01,
+    0xa9, 0xcc, 0xcc, 0xcb, 0xbb, 0xbb, 0x9a, 0x08, 0x42, 0x44, 0x34, 0x34, 0x33, 0x23, 0x11, 0x99,
+    0xeb, 0xdb, 0xcb, 0xbb, 0xbb, 0x9b, 0x09, 0x32, 0x45, 0x44, 0x33, 0x24, 0x23, 0x01, 0x90, 0xca,
+    0xcc, 0xbc, 0xcb, 0xba, 0x9a, 0x89, 0x21, 0x44, 0x34, 0x44, 0x32, 0x23, 0x11, 0x90, 0xc9, 0xcc,
+    0xcb, 0xac, 0xbb, 0xaa, 0x09, 0x10, 0x44, 0x53, 0x43, 0x33, 0x33, 0x12, 0x80, 0xc9, 0xcc, 0xbc,
+    0xbc, 0xbb, 0xab, 0x99, 0x20, 0x53, 0x35, 0x34, 0x34, 0x23, 0x22, 0x00, 0xb9, 0xcd, 0xdb, 0xbb,
+    0xac, 0xab, 0x99, 0x10, 0x42, 0x44, 0x53, 0x32, 0x33, 0x22, 0x01, 0xa9, 0xdc, 0xdb, 0xbb, 0xac,
+    0xab, 0x9a, 0x18, 0x32, 0x45, 0x34, 0x34, 0x33, 0x23, 0x01, 0xa8, 0xcc, 0xcc, 0xcb, 0xbb, 0xbb,
+    0x9a, 0x08, 0x41, 0x44, 0x53, 0x33, 0x24, 0x13, 0x02, 0x98, 0xcb, 0xcc, 0xbc, 0xcb, 0xaa, 0xaa,
+    0x88, 0x31, 0x63, 0x34, 0x44, 0x23, 0x22, 0x80, 0xba, 0xbe, 0xbd, 0xba, 0x9b, 0x09, 0x41, 0x34,
+    0x35, 0x24, 0x12, 0x01, 0xb9, 0xcc, 0xbc, 0xbb, 0x9c, 0x89, 0x21, 0x44, 0x53, 0x32, 0x23, 0x01,
+    0xb8, 0xeb, 0xbc, 0xcb, 0xaa, 0x99, 0x11, 0x53, 0x34, 0x34, 0x23, 0x12, 0xa8, 0xdb, 0xcc, 0xcb,
+    0xaa, 0x99, 0x00, 0x43, 0x44, 0x33, 0x24, 0x11, 0x90, 0xca, 0xbc, 0xbd, 0xba, 0x9a, 0x18, 0x42,
+    0x44, 0x43, 0x33, 0x12, 0x80, 0xba, 0xbe, 0xad, 0xbb, 0x9b, 0x09, 0x32, 0x45, 0x34, 0x24, 0x12,
+    0x81, 0xa9, 0xcc, 0xbc, 0xcb, 0x9a, 0x89, 0x21, 0x44, 0x53, 0x23, 0x23, 0x01, 0xa9, 0xcc, 0xbc,
+    0xbc, 0xab, 0x89, 0x20, 0x63, 0x53, 0x23, 0x33, 0x11, 0xa8, 0xeb, 0xdb, 0xba, 0xbb, 0x8a, 0x28,
+    0x53, 0x44, 0x33, 0x33, 0x13, 0x98, 0xdb, 0xcc, 0xbc, 0xba, 0x9a, 0x18, 0x42, 0x44, 0x34, 0x32,
+    0x12, 0x91, 0xba, 0xbe, 0xbd, 0xba, 0x9b, 0x88, 0x42, 0x34, 0x35, 0x43, 0x12, 0x81, 0xb9, 0xcc,
+    0xbc, 0xbb, 0xbb, 0x09, 0x31, 0x55, 0x43, 0x33, 0x23, 0x01, 0xa9, 0xcd, 0xdb, 0xba, 0xab, 0x99,
+    0x21, 0x63, 0x34, 0x43, 0x22, 0x02, 0xa8, 0xcb, 0xbd, 0xbc, 0xbb, 0x99, 0x10, 0x53, 0x44, 0x43,
+    0x22, 0x02, 0x90, 0xca, 0xcc, 0xbb, 0xac, 0x9a, 0x00, 0x42, 0x34, 0x35, 0x32, 0x12, 0x80, 0xca,
+    0xcc, 0xcb, 0xbb, 0x9a, 0x09, 0x42, 0x34, 0x35, 0x24, 0x12, 0x81, 0xb9, 0xcc, 0xbc, 0xcb, 0x9a,
+    0x09, 0x30, 0x44, 0x53, 0x23, 0x13, 0x82, 0xb8, 0xcc, 0xcc, 0xba, 0xab, 0x89, 0x20, 0x44, 0x44,
+    0x32, 0x23, 0x02, 0xa8, 0xeb, 0xdb, 0xba, 0xbb, 0x99, 0x10, 0x63, 0x43, 0x24, 0x23, 0x12, 0x98,
+    0xda, 0xdb, 0xbb, 0xac, 0x8a, 0x08, 0x42, 0x44, 0x33, 0x24, 0x12, 0x90, 0xc9, 0xbc, 0xad, 0xbb,
+    0xaa, 0x08, 0x42, 0x34, 0x35, 0x24, 0x12, 0x00, 0xaa, 0xcc, 0xbc, 0xac, 0x9a, 0x89, 0x31, 0x44,
+    0x34, 0x33, 0x14, 0x01, 0xa9, 0xcc, 0xdb, 0xab, 0xab, 0x89, 0x21, 0x63, 0x34, 0x43, 0x22, 0x11,
+    0xa8, 0xdb, 0xbc, 0xbc, 0xab, 0x9a, 0x20, 0x53, 0x44, 0x43, 0x22, 0x11, 0x88, 0xcb, 0xcc, 0xbb,
+    0xac, 0x99, 0x18, 0x42, 0x34, 0x35, 0x32, 0x12, 0x90, 0xca, 0xcc, 0xcb, 0xbb, 0x9a, 0x08, 0x41,
+    0x44, 0x43, 0x33, 0x22, 0x00, 0xba, 0xbe, 0xcc, 0xba, 0xaa, 0x09, 0x31, 0x54, 0x43, 0x33, 0x23,
+    0x81, 0xa9, 0xcd, 0xbc, 0xcb, 0xaa, 0x09, 0x20, 0x63, 0x43, 0x33, 0x33, 0x01, 0xa8, 0xdc, 0xdb,
+    0xba, 0xbb, 0x99, 0x20, 0x63, 0x53, 0x32, 0x33, 0x02, 0xa0, 0xdb, 0xcc, 0xbb, 0xbb, 0x9b, 0x10,
+    0x53, 0x44, 0x34, 0x32, 0x12, 0x90, 0xca, 0xcc, 0xbc, 0xba, 0x9a, 0x19, 0x32, 0x36, 0x35, 0x32,
+    0x13, 0x00, 0xca, 0xbc, 0xbd, 0xcb, 0x9a, 0x09, 0x31, 0x44, 0x34, 0x33, 0x33, 0x81, 0xb9, 0xdd,
+    0xcb, 0xbb, 0xab, 0x89, 0x21, 0x45, 0x53, 0x32, 0x23, 0x11, 0xa9, 0xeb, 0xbc, 0xcb, 0xaa, 0x8a,
+    0x20, 0x43, 0x35, 0x34, 0x33, 0x11, 0x98, 0xeb, 0xcb, 0xac, 0xab, 0x9a, 0x18, 0x43, 0x35, 0x34,
+    0x33, 0x12, 0x90, 0xda, 0xbc, 0xbd, 0xba, 0x9a, 0x08, 0x42, 0x44, 0x43, 0x33, 0x12, 0x81, 0xba,
+    0xbe, 0xbd, 0xba, 0x9b, 0x09, 0x31, 0x45, 0x34, 0x24, 0x12, 0x01, 0xa9, 0xcc, 0xbc, 0xcb, 0xaa,
+    0x09, 0x20, 0x44, 0x34, 0x43, 0x22, 0x01, 0x99, 0xbc, 0xcd, 0xab, 0xab, 0x8a, 0x20, 0x63, 0x53,
+    0x32, 0x33, 0x11, 0x98, 0xbc, 0xbe, 0xcb, 0xab, 0x99, 0x18, 0x43, 0x35, 0x34, 0x33, 0x12, 0x90,
+    0xcb, 0xcd, 0xbb, 0xac, 0x9a, 0x08, 0x42, 0x34, 0x25, 0x33, 0x22, 0x80, 0xba, 0xbe, 0xbd, 0xba,
+    0x9b, 0x09, 0x41, 0x63, 0x33, 0x34, 0x12, 0x01, 0xb9, 0xdc, 0xcb, 0xbb, 0xab, 0x89, 0x31, 0x54,
+    0x34, 0x43, 0x22, 0x01, 0xa8, 0xcc, 0xdb, 0xba, 0xab, 0x8a, 0x20, 0x44, 0x34, 0x34, 0x23, 0x02,
+    0x98, 0xbc, 0xbe, 0xcb, 0xab, 0x99, 0x18, 0x53, 0x53, 0x43, 0x22, 0x12, 0x88, 0xbb, 0xbe, 0xbc,
+    0xbb, 0xaa, 0x18, 0x52, 0x34, 0x25, 0x33, 0x22, 0x80, 0xca, 0xcc, 0xcb, 0xbb, 0xaa, 0x08, 0x41,
+    0x63, 0x33, 0x34, 0x12, 0x81, 0xa9, 0xcd, 0xcb, 0xbb, 0xba, 0x88, 0x21, 0x45, 0x34, 0x43, 0x22,
+    0x01, 0xa9, 0xeb, 0xcb, 0xbb, 0xbb, 0x89, 0x20, 0x54, 0x53, 0x32, 0x33, 0x11, 0xa8, 0xeb, 0xdb,
+    0xba, 0xbb, 0x8a, 0x28, 0x53, 0x44, 0x33, 0x33, 0x13, 0x98, 0xdb, 0xcc, 0xbc, 0xba, 0x9a, 0x18,
+    0x42, 0x44, 0x34, 0x32, 0x12, 0x91, 0xba, 0xbe, 0xbd, 0xba, 0x9b, 0x88, 0x42, 0x34, 0x35, 0x43,
+    0x12, 0x81, 0xb9, 0xcc, 0xbc, 0xbb, 0xbb, 0x09, 0x31, 0x55, 0x43, 0x33, 0x23, 0x01, 0xa9, 0xcd,
+    0xdb, 0xba, 0xab, 0x99, 0x21, 0x63, 0x34, 0x43, 0x22, 0x02, 0xa8, 0xcb, 0xbd, 0xbc, 0xbb, 0x99,
+    0x10, 0x63, 0x43, 0x24, 0x23, 0x12, 0x90, 0xcb, 0xbd, 0xbc, 0xbb, 0x9a, 0x18, 0x52, 0x34, 0x35,
+    0x32, 0x12, 0x80, 0xca, 0xcc, 0xcb, 0xbb, 0x9a, 0x09, 0x32, 0x36, 0x35, 0x32, 0x13, 0x81, 0xb9,
+    0xcd, 0xbc, 0xac, 0x9a, 0x89, 0x21, 0x44, 0x34, 0x43, 0x22, 0x81, 0xa8, 0xcc, 0xbc, 0xcb, 0xaa,
+    0x89, 0x20, 0x44, 0x43, 0x24, 0x23, 0x01, 0x98, 0xdb, 0xbc, 0xbc, 0xab, 0x9a, 0x20, 0x53, 0x44,
+    0x33, 0x24, 0x11, 0x98, 0xca, 0xcc, 0xbb, 0xac, 0x99, 0x18, 0x32, 0x36, 0x34, 0x33, 0x22, 0x90,
+    0xca, 0xcd, 0xbb, 0xac, 0x9a, 0x09, 0x32, 0x45, 0x43, 0x33, 0x22, 0x81, 0xba, 0xcd, 0xbc, 0xcb,
+    0x9a, 0x09, 0x21, 0x44, 0x34, 0x43, 0x12, 0x01, 0xa9, 0xcc, 0xdb, 0xba, 0xab, 0x89, 0x30, 0x44,
+    0x34, 0x34, 0x23, 0x01, 0x98, 0xcc, 0xbc, 0xbc, 0xab, 0x8a, 0x28, 0x53, 0x44, 0x43, 0x22, 0x11,
+    0x88, 0xcb, 0xcc, 0xbb, 0xac, 0x99, 0x18, 0x42, 0x34, 0x35, 0x32, 0x12, 0x90, 0xca, 0xcc, 0xcb,
+    0xbb, 0x9a, 0x08, 0x32, 0x36, 0x25, 0x33, 0x13, 0x81, 0xba, 0xcd, 0xbc, 0xac, 0x9a, 0x09, 0x21,
+    0x44, 0x34, 0x43, 0x12, 0x01, 0xa9, 0xcc, 0xdb, 0xab, 0xab, 0x89, 0x21, 0x44, 0x34, 0x34, 0x23,
+    0x01, 0xa8, 0xeb, 0xdb, 0xab, 0xbb, 0x99, 0x20, 0x63, 0x53, 0x32, 0x33, 0x02, 0xa0, 0xdb, 0xcc,
+    0xbb, 0xbb, 0x9b, 0x10, 0x53, 0x44, 0x34, 0x32, 0x12, 0x90, 0xca, 0xcc, 0xbc, 0xba, 0x9a, 0x19,
+    0x32, 0x36, 0x35, 0x32, 0x13, 0x00, 0xca, 0xeb, 0xbb, 0xbc, 0x9a, 0x09, 0x31, 0x54, 0x43, 0x33,
+    0x23, 0x00, 0xb9, 0xdc, 0xbc, 0xcb, 0xaa, 0x09, 0x20, 0x34, 0x45, 0x23, 0x23, 0x11, 0xa9, 0xeb,
+    0xbc, 0xcb, 0xaa, 0x8a, 0x20, 0x43, 0x35, 0x34, 0x33, 0x11, 0x98, 0xeb, 0xcb, 0xac, 0xab, 0x9a,
+    0x18, 0x43, 0x35, 0x34, 0x33, 0x12, 0x90, 0xda, 0xbc, 0xbd, 0xba, 0x9a, 0x08, 0x42, 0x44, 0x43,
+    0x33, 0x12, 0x81, 0xba, 0xbe, 0xbd, 0xba, 0x9b, 0x09, 0x31, 0x45, 0x34, 0x24, 0x12, 0x01, 0xa9,
+    0xcc, 0xbc, 0xcb, 0xaa, 0x09, 0x20, 0x44, 0x34, 0x43, 0x22, 0x01, 0x99, 0xbc, 0xcd, 0xab, 0xab,
+    0x8a, 0x20, 0x63, 0x53, 0x32, 0x33, 0x11, 0x98, 0xbc, 0xbe, 0xcb, 0xab, 0x99, 0x18, 0x43, 0x35,
+    0x34, 0x33, 0x12, 0x90, 0xcb, 0xcd, 0xbb, 0xac, 0x9a, 0x08, 0x42, 0x34, 0x35, 0x33, 0x12, 0xb8,
+    0xdc, 0xbc, 0xbb, 0x9a, 0x20, 0x44, 0x44, 0x32, 0x11, 0x90, 0xdb, 0xdb, 0xba, 0x9a, 0x18, 0x43,
+    0x44, 0x33, 0x22, 0x90, 0xda, 0xdb, 0xbb, 0xab, 0x08, 0x42, 0x35, 0x34, 0x22, 0x81, 0xc9, 0xbc,
+    0xad, 0xab, 0x88, 0x31, 0x54, 0x33, 0x33, 0x01, 0xb9, 0xcd, 0xbc, 0xab, 0x8a, 0x30, 0x54, 0x43,
+    0x23, 0x02, 0xa8, 0xcc, 0xdb, 0xba, 0x99, 0x10, 0x53, 0x34, 0x33, 0x12, 0x90, 0xcc, 0xbc, 0xac,
+    0xaa, 0x00, 0x43, 0x44, 0x33, 0x22, 0x80, 0xcb, 0xbd, 0xbc, 0xaa, 0x08, 0x32, 0x36, 0x34, 0x22,
+    0x81, 0xb9, 0xbe, 0xbc, 0xba, 0x09, 0x31, 0x45, 0x43, 0x23, 0x81, 0xb8, 0xcc, 0xbc, 0xab, 0x8a,
+    0x30, 0x54, 0x43, 0x23, 0x02, 0xa8, 0xeb, 0xcb, 0xab, 0x9a, 0x10, 0x63, 0x43, 0x23, 0x13, 0x98,
+    0xdb, 0xbc, 0xac, 0x9b, 0x18, 0x52, 0x43, 0x24, 0x12, 0x91, 0xba, 0xcd, 0xbb, 0x9b, 0x09, 0x42,
+    0x44, 0x24, 0x13, 0x81, 0xb9, 0xdc, 0xbb, 0xbb, 0x89, 0x32, 0x55, 0x33, 0x33, 0x11, 0xb9, 0xdd,
+    0xbb, 0xbb, 0x8a, 0x20, 0x45, 0x34, 0x33, 0x02, 0xa8, 0xfb, 0xbb, 0xac, 0x8a, 0x18, 0x53, 0x34,
+    0x33, 0x22, 0x98, 0xdb, 0xbd, 0xbb, 0x9b, 0x19, 0x53, 0x44, 0x33, 0x13, 0x91, 0xca, 0xbd, 0xbc,
+    0xaa, 0x88, 0x42, 0x34, 0x25, 0x13, 0x01, 0xba, 0xcc, 0xbc, 0xab, 0x89, 0x31, 0x45, 0x43, 0x23,
+    0x01, 0xa9, 0xcc, 0xbc, 0xbb, 0x99, 0x21, 0x54, 0x43, 0x23, 0x02, 0xa0, 0xcc, 0xdb, 0xba, 0x99,
+    0x28, 0x52, 0x34, 0x33, 0x22, 0x90, 0xcc, 0xbc, 0xac, 0x9b, 0x18, 0x42, 0x44, 0x33, 0x22, 0x91,
+    0xca, 0xcc, 0xac, 0x9b, 0x09, 0x32, 0x35, 0x25, 0x13, 0x01, 0xb9, 0xbd, 0xad, 0xab, 0x89, 0x31,
+    0x44, 0x34, 0x23, 0x02, 0xa9, 0xbd, 0xbd, 0xbb, 0x8a, 0x20, 0x35, 0x35, 0x33, 0x12, 0xa8, 0xcc,
+    0xcc, 0xba, 0x99, 0x18, 0x53, 0x53, 0x32, 0x12, 0x90, 0xda, 0xdb, 0xba, 0x9a, 0x19, 0x42, 0x44,
+    0x33, 0x13, 0x81, 0xda, 0xdb, 0xbb, 0xab, 0x09, 0x42, 0x44, 0x43, 0x22, 0x01, 0xb9, 0xbd, 0xad,
+    0xab, 0x89, 0x21, 0x35, 0x44, 0x22, 0x01, 0xa8, 0xbc, 0xbd, 0xbb, 0x99, 0x20, 0x54, 0x43, 0x23,
+    0x12, 0xa8, 0xdb, 0xbc, 0xac, 0x9a, 0x18, 0x43, 0x35, 0x33, 0x13, 0x90, 0xdb, 0xcc, 0xbb, 0xaa,
+    0x08, 0x43, 0x35, 0x34, 0x22, 0x80, 0xba, 0xbe, 0xbc, 0xaa, 0x09, 0x31, 0x36, 0x34, 0x32, 0x81,
+    0xb9, 0xcd, 0xcb, 0xab, 0x89, 0x31, 0x44, 0x34, 0x23, 0x02, 0xb8, 0xdc, 0xcb, 0xab, 0x8a, 0x20,
+    0x63, 0x43, 0x23, 0x12, 0x98, 0xeb, 0xcb, 0xab, 0xaa, 0x10, 0x53, 0x34, 0x24, 0x13, 0x90, 0xda,
+    0xcb, 0xac, 0x9a, 0x19, 0x41, 0x34, 0x34, 0x22, 0x80, 0xc9, 0xcc, 0xbb, 0xab, 0x09, 0x41, 0x44,
+    0x24, 0x23, 0x00, 0xa9, 0xbd, 0xad, 0xab, 0x89, 0x30, 0x44, 0x34, 0x23, 0x02, 0xa8, 0xbd, 0xbd,
+    0xbb, 0x8a, 0x10, 0x54, 0x43, 0x23, 0x12, 0xa0, 0xdb, 0xcc, 0xba, 0x9a, 0x10, 0x52, 0x53, 0x32,
+    0x12, 0x80, 0xcb, 0xcc, 0xbb, 0xaa, 0x08, 0x52, 0x53, 0x33, 0x23, 0x00, 0xca, 0xbd, 0xbc, 0xaa,
+    0x89, 0x32, 0x45, 0x43, 0x13, 0x01, 0xa9, 0xbd, 0xcc, 0xaa, 0x89, 0x21, 0x53, 0x34, 0x33, 0x11,
+    0xa9, 0xdc, 0xcb, 0xab, 0x8a, 0x28, 0x44, 0x53, 0x32, 0x11, 0xa0, 0xda, 0xbc, 0xbb, 0xaa, 0x18,
+    0x44, 0x34, 0x24, 0x13, 0x90, 0xca, 0xcc, 0xbb, 0xaa, 0x19, 0x42, 0x44, 0x24, 0x13, 0x81, 0xba,
+    0xbd, 0xad, 0x9b, 0x89, 0x31, 0x35, 0x25, 0x23, 0x01, 0xb9, 0xcc, 0xbc, 0xab, 0x8a, 0x21, 0x35,
+    0x35, 0x33, 0x02, 0xa8, 0xbd, 0xbd, 0xbb, 0x9a, 0x20, 0x44, 0x44, 0x32, 0x11, 0x90, 0xdb, 0xdb,
+    0xba, 0x9a, 0x18, 0x52, 0x53, 0x32, 0x12, 0x91, 0xca, 0xcc, 0xbb, 0x9b, 0x09, 0x52, 0x53, 0x33,
+    0x23, 0x81, 0xca, 0xcc, 0xcb, 0xaa, 0x89, 0x31, 0x35, 0x25, 0x23, 0x01, 0xa9, 0xbd, 0xcc, 0xaa,
+    0x89, 0x20, 0x34, 0x35, 0x33, 0x11, 0xa8, 0xdc, 0xcb, 0xab, 0x9a, 0x20, 0x53, 0x34, 0x24, 0x12,
+    0x90, 0xcb, 0xbd, 0xbb, 0x9b, 0x18, 0x53, 0x44, 0x33, 0x22, 0x80, 0xcb, 0xbd, 0xbc, 0xaa, 0x08,
+    0x32, 0x36, 0x34, 0x22, 0x81, 0xb9, 0xbe, 0xbc, 0xba, 0x09, 0x31, 0x45, 0x43, 0x23, 0x01, 0xb9,
+    0xcc, 0xbc, 0xab, 0x8a, 0x30, 0x54, 0x43, 0x23, 0x02, 0xa8, 0xeb, 0xcb, 0xab, 0x9a, 0x10, 0x63,
+    0x43, 0x23, 0x13, 0x98, 0xdb, 0xbc, 0xbc, 0x9a, 0x18, 0x43, 0x44, 0x33, 0x22, 0x80, 0xcb, 0xdc,
+    0xba, 0x9b, 0x09, 0x42, 0x34, 0x25, 0x13, 0x81, 0xb9, 0xbd, 0xad, 0xab, 0x88, 0x21, 0x35, 0x25,
+    0x23, 0x01, 0xb8, 0xcc, 0xbc, 0xab, 0x8a, 0x20, 0x35, 0x35, 0x33, 0x02, 0x98, 0xbd, 0xbd, 0xbb,
+    0x9a, 0x10, 0x44, 0x34, 0x24, 0x12, 0x90, 0xda, 0xdb, 0xba, 0x9a, 0x08, 0x43, 0x44, 0x33, 0x22,
+    0x80, 0xda, 0xdb, 0xbb, 0xab, 0x88, 0x42, 0x35, 0x34, 0x22, 0x01, 0xba, 0xcd, 0xcb, 0x9b, 0x89,
+    0x21, 0x35, 0x44, 0x22, 0x01, 0xa9, 0xdb, 0xbc, 0xbb, 0x99, 0x21, 0x54, 0x43, 0x23, 0x02, 0xa0,
+    0xcc, 0xdb, 0xba, 0x99, 0x28, 0x52, 0x34, 0x33, 0x22, 0x90, 0xcc, 0xbc, 0xac, 0x9b, 0x18, 0x42,
+    0x44, 0x33, 0x22, 0x91, 0xca, 0xcc, 0xac, 0x9b, 0x09, 0x32, 0x35, 0x25, 0x13, 0x01, 0xb9, 0xbd,
+    0xad, 0xab, 0x89, 0x31, 0x44, 0x34, 0x23, 0x02, 0xa9, 0xcd, 0xcb, 0xba, 0x99, 0x20, 0x44, 0x34,
+    0x33, 0x12, 0xa8, 0xcc, 0xcc, 0xba, 0x99, 0x18, 0x53, 0x53, 0x32, 0x12, 0x90, 0xcb, 0xcc, 0xbb,
+    0xaa, 0x18, 0x42, 0x35, 0x34, 0x22, 0x80, 0xca, 0xbc, 0xad, 0x9b, 0x09, 0x32, 0x54, 0x33, 0x23,
+    0x01, 0xc9, 0xcc, 0xcb, 0xba, 0x09, 0x30, 0x44, 0x34, 0x23, 0x02, 0xb8, 0xdc, 0xcb, 0xab, 0x8a,
+    0x20, 0x44, 0x53, 0x32, 0x11, 0x98, 0xdb, 0xbc, 0xbb, 0xaa, 0x10, 0x44, 0x34, 0x24, 0x22, 0x88,
+    0xcb, 0xcc, 0xbb, 0xaa, 0x08, 0x43, 0x35, 0x34, 0x22, 0x80, 0xba, 0xbe, 0xbc, 0xaa, 0x09, 0x41,
+    0x53, 0x24, 0x23, 0x00, 0xb9, 0xcc, 0xbc, 0xab, 0x89, 0x30, 0x45, 0x43, 0x32, 0x01, 0xa8, 0xcc,
+    0xbc, 0xbb, 0x99, 0x20, 0x44, 0x44, 0x32, 0x11, 0x98, 0xdb, 0xdb, 0xba, 0x9a, 0x10, 0x43, 0x44,
+    0x33, 0x12, 0x80, 0xdb, 0xdb, 0xbb, 0x9b, 0x19, 0x52, 0x53, 0x33, 0x23, 0x80, 0xca, 0xcc, 0xac,
+    0xaa, 0x09, 0x31, 0x35, 0x25, 0x23, 0x81, 0xa9, 0xbd, 0xad, 0xab, 0x89, 0x30, 0x44, 0x34, 0x23,
+    0x02, 0xa8, 0xbd, 0xbd, 0xbb, 0x8a, 0x10, 0x54, 0x43, 0x23, 0x12, 0xa0, 0xdb, 0xcc, 0xba, 0x8a,
+    0x18, 0x52, 0x43, 0x24, 0x12, 0x90, 0xba, 0xcd, 0xbb, 0x9b, 0x19, 0x42, 0x35, 0x34, 0x22, 0x80,
+    0xc9, 0xbc, 0xad, 0x9b, 0x89, 0x32, 0x54, 0x33, 0x23, 0x02, 0xba, 0xcd, 0xbc, 0xab, 0x8a, 0x21,
+    0x45, 0x43, 0x23, 0x11, 0xa9, 0xeb, 0xcb, 0xab, 0x9a, 0x20, 0x63, 0x43, 0x23, 0x12, 0x90, 0xbc,
+    0xcd, 0xba, 0x9a, 0x00, 0x43, 0x44, 0x33, 0x22, 0x90, 0xda, 0xdb, 0xbb, 0x9b, 0x09, 0x43, 0x44,
+    0x24, 0x22, 0x81, 0xba, 0xbd, 0xad, 0x9b, 0x89, 0x31, 0x35, 0x25, 0x23, 0x01, 0xb9, 0xcc, 0xbc,
+    0xab, 0x8a, 0x21, 0x35, 0x45, 0x23, 0x90, 0xeb, 0xbb, 0x9b, 0x20, 0x44, 0x34, 0x11, 0xb8, 0xcc,
+    0xbb, 0x8a, 0x41, 0x44, 0x23, 0x81, 0xca, 0xbc, 0xbb, 0x08, 0x44, 0x34, 0x12, 0x90, 0xcc, 0xbb,
+    0x9b, 0x20, 0x45, 0x24, 0x11, 0xb9, 0xbc, 0xbc, 0x89, 0x42, 0x34, 0x14, 0x81, 0xca, 0xbc, 0xaa,
+    0x18, 0x53, 0x34, 0x12, 0x98, 0xcc, 0xcb, 0x99, 0x30, 0x34, 0x34, 0x01, 0xb9, 0xcd, 0xab, 0x09,
+    0x42, 0x34, 0x33, 0x90, 0xdb, 0xcc, 0x9a, 0x10, 0x43, 0x34, 0x02, 0xa8, 0xcc, 0xcb, 0x89, 0x21,
+    0x44, 0x23, 0x01, 0xca, 0xbc, 0xbb, 0x19, 0x53, 0x34, 0x23, 0x90, 0xcc, 0xbc, 0x9a, 0x20, 0x44,
+    0x33, 0x03, 0xb8, 0xbe, 0xac, 0x0a, 0x31, 0x35, 0x24, 0x80, 0xc9, 0xbc, 0xaa, 0x19, 0x53, 0x34,
+    0x12, 0x90, 0xcc, 0xcb, 0x8a, 0x20, 0x34, 0x25, 0x01, 0xb8, 0xcc, 0xab, 0x89, 0x42, 0x34, 0x14,
+    0x91, 0xba, 0xae, 0x9b, 0x18, 0x53, 0x43, 0x12, 0xa8, 0xeb, 0xba, 0x8a, 0x30, 0x44, 0x24, 0x81,
+    0xa9, 0xbd, 0xab, 0x09, 0x52, 0x53, 0x12, 0x91, 0xcb, 0xcb, 0x9b, 0x28, 0x44, 0x33, 0x13, 0xb8,
+    0xcd, 0xac, 0x89, 0x21, 0x44, 0x23, 0x01, 0xca, 0xbc, 0x9c, 0x09, 0x43, 0x53, 0x12, 0x90, 0xcb,
+    0xbc, 0x9a, 0x20, 0x44, 0x43, 0x01, 0xa8, 0xcc, 0xbb, 0x89, 0x32, 0x36, 0x23, 0x81, 0xda, 0xdb,
+    0x9a, 0x08, 0x43, 0x24, 0x13, 0xa0, 0xcc, 0xcb, 0x99, 0x20, 0x44, 0x33, 0x01, 0xb9, 0xcd, 0xab,
+    0x89, 0x42, 0x44, 0x22, 0x80, 0xcb, 0xdb, 0x9a, 0x18, 0x43, 0x34, 0x12, 0xa8, 0xcc, 0xcb, 0x89,
+    0x30, 0x34, 0x34, 0x01, 0xba, 0xbe, 0xab, 0x09, 0x43, 0x35, 0x13, 0x90, 0xdb, 0xbc, 0x9a, 0x10,
+    0x44, 0x43, 0x11, 0xa8, 0xcc, 0xbb, 0x89, 0x31, 0x36, 0x33, 0x81, 0xda, 0xdb, 0xaa, 0x08, 0x43,
+    0x34, 0x12, 0x90, 0xbc, 0xbd, 0x9a, 0x20, 0x44, 0x24, 0x11, 0xb9, 0xbc, 0xbc, 0x89, 0x42, 0x34,
+    0x33, 0x81, 0xdb, 0xcc, 0x9a, 0x18, 0x42, 0x34, 0x12, 0xa0, 0xcc, 0xcb, 0x99, 0x30, 0x63, 0x32,
+    0x01, 0xb9, 0xbd, 0xac, 0x09, 0x42, 0x53, 0x12, 0x91, 0xca, 0xbc, 0xaa, 0x10, 0x44, 0x43, 0x11,
+    0xa8, 0xdb, 0xac, 0x89, 0x30, 0x44, 0x23, 0x01, 0xca, 0xbc, 0x9c, 0x09, 0x42, 0x34, 0x22, 0x90,
+    0xdb, 0xbc, 0x9a, 0x10, 0x44, 0x24, 0x02, 0xb8, 0xbc, 0xad, 0x89, 0x31, 0x44, 0x23, 0x81, 0xca,
+    0xbc, 0x9c, 0x08, 0x52, 0x33, 0x13, 0xa0, 0xcc, 0xbc, 0x8a, 0x20, 0x44, 0x43, 0x01, 0xa9, 0xcc,
+    0xab, 0x89, 0x32, 0x36, 0x23, 0x81, 0xdb, 0xbc, 0xaa, 0x18, 0x34, 0x35, 0x12, 0x98, 0xcc, 0xac,
+    0x8a, 0x21, 0x44, 0x23, 0x01, 0xb9, 0xbe, 0xab, 0x89, 0x43, 0x35, 0x23, 0x90, 0xdb, 0xbc, 0x9a,
+    0x18, 0x44, 0x43, 0x02, 0xa8, 0xbc, 0xad, 0x89, 0x21, 0x44, 0x23, 0x01, 0xca, 0xbc, 0x9c, 0x09,
+    0x33, 0x26, 0x13, 0x90, 0xdb, 0xcb, 0x9a, 0x20, 0x34, 0x25, 0x11, 0xa9, 0xcc, 0xab, 0x0a, 0x41,
+    0x34, 0x14, 0x81, 0xba, 0xcd, 0x9a, 0x08, 0x43, 0x34, 0x12, 0xa0, 0xcc, 0xcb, 0x99, 0x20, 0x44,
+    0x23, 0x02, 0xb9, 0xcd, 0xab, 0x09, 0x41, 0x44, 0x22, 0x80, 0xcb, 0xdb, 0x9a, 0x18, 0x43, 0x34,
+    0x12, 0xa8, 0xcc, 0xbb, 0x8b, 0x31, 0x55, 0x22, 0x82, 0xb9, 0xbd, 0xac, 0x08, 0x32, 0x45, 0x12,
+    0x80, 0xcb, 0xbc, 0x9a, 0x28, 0x44, 0x43, 0x11, 0xa8, 0xcc, 0xbb, 0x89, 0x31, 0x45, 0x23, 0x81,
+    0xc9, 0xcc, 0xaa, 0x18, 0x42, 0x53, 0x12, 0x90, 0xdb, 0xbb, 0x9a, 0x20, 0x54, 0x33, 0x02, 0xb9,
+    0xcd, 0xab, 0x89, 0x41, 0x34, 0x24, 0x80, 0xca, 0xdb, 0x9a, 0x18, 0x42, 0x34, 0x12, 0xa0, 0xcc,
+    0xcb, 0x99, 0x30, 0x63, 0x32, 0x01, 0xb9, 0xbd, 0xac, 0x88, 0x32, 0x26, 0x23, 0x80, 0xcb, 0xad,
+    0x9b, 0x10, 0x53, 0x43, 0x02, 0xa8, 0xdb, 0xac, 0x89, 0x30, 0x44, 0x32, 0x01, 0xba, 0xbe, 0xab,
+    0x09, 0x43, 0x35, 0x13, 0x90, 0xdb, 0xbc, 0x9a, 0x10, 0x44, 0x24, 0x02, 0xb8, 0xeb, 0xba, 0x89,
+    0x31, 0x35, 0x24, 0x81, 0xca, 0xcb, 0xab, 0x19, 0x53, 0x34, 0x22, 0x98, 0xcc, 0xcb, 0x99, 0x20,
+    0x53, 0x24, 0x01, 0xb8, 0xcc, 0xab, 0x89, 0x42, 0x34, 0x14, 0x81, 0xca, 0xbc, 0x9b, 0x18, 0x53,
+    0x34, 0x12, 0xa0, 0xcc, 0xac, 0x8a, 0x21, 0x34, 0x25, 0x01, 0xb9, 0xbd, 0xab, 0x09, 0x42, 0x35,
+    0x23, 0x90, 0xdb, 0xbc, 0x9a, 0x18, 0x44, 0x43, 0x02, 0xa8, 0xeb, 0xba, 0x99, 0x31, 0x35, 0x24,
+    0x81, 0xb9, 0xae, 0xab, 0x19, 0x42, 0x25, 0x13, 0x90, 0xdb, 0xcb, 0x9a, 0x20, 0x53, 0x24, 0x02,
+    0xa9, 0xcc, 0xab, 0x0a, 0x41, 0x34, 0x14, 0x81, 0xc9, 0xbc, 0x9b, 0x19, 0x53, 0x34, 0x12, 0x90,
+    0xcc, 0xac, 0x8a, 0x20, 0x34, 0x25, 0x01, 0xa9, 0xcc, 0xab, 0x89, 0x42, 0x34, 0x14, 0x91, 0xca,
+    0xdb, 0x9a, 0x18, 0x43, 0x34, 0x12, 0xa8, 0xcc, 0xcb, 0x89, 0x20, 0x44, 0x33, 0x01, 0xba, 0xbe,
+    0xab, 0x09, 0x52, 0x53, 0x12, 0x80, 0xcb, 0xac, 0x9b, 0x28, 0x44, 0x43, 0x11, 0xa8, 0xcc, 0xbb,
+    0x89, 0x31, 0x45, 0x23, 0x01, 0xca, 0xcc, 0xaa, 0x08, 0x43, 0x53, 0x12, 0x90, 0xcb, 0xbc, 0x9a,
+    0x20, 0x44, 0x43, 0x01, 0xb8, 0xbc, 0xbc, 0x89, 0x32, 0x36, 0x23, 0x81, 0xcb, 0xbd, 0xaa, 0x08,
+    0x34, 0x35, 0x12, 0xa0, 0xeb, 0xbb, 0x9a, 0x21, 0x45, 0x23, 0x02, 0xc9, 0xdb, 0xab, 0x09, 0x41,
+    0x44, 0x22, 0x90, 0xca, 0xbc, 0xaa, 0x10, 0x44, 0x33, 0x13, 0xa8, 0xcd, 0xac, 0x99, 0x31, 0x34,
+    0x34, 0x01, 0xca, 0xbc, 0xbb, 0x09, 0x53, 0x44, 0x12, 0x80, 0xcb, 0xbc, 0x9a, 0x28, 0x44, 0x43,
+    0x11, 0xa9, 0xeb, 0xba, 0x89, 0x31, 0x35, 0x24, 0x81, 0xca, 0xdb, 0x9a, 0x19, 0x42, 0x34, 0x22,
+    0x98, 0xcc, 0xcb, 0x99, 0x20, 0x53, 0x24, 0x01, 0xb8, 0xcc, 0xab, 0x89, 0x42, 0x34, 0x14, 0x81,
+    0xca, 0xbc, 0xaa, 0x18, 0x53, 0x34, 0x12, 0x98, 0xcc, 0xac, 0x8a, 0x30, 0x34, 0x25, 0x01, 0xb9,
+    0xcc, 0xab, 0x09, 0x42, 0x34, 0x14, 0x80, 0xda, 0xbb, 0x9b, 0x28, 0x44, 0x34, 0x02, 0xa8, 0xcc,
+    0xcb, 0x89, 0x21, 0x44, 0x23, 0x01, 0xba, 0xbe, 0xab, 0x09, 0x53, 0x34, 0x22, 0x90, 0xeb, 0xbb,
+    0x9b, 0x20, 0x35, 0x25, 0x02, 0xa9, 0xcc, 0xab, 0x89, 0x31, 0x36, 0x23, 0x01, 0xcb, 0xbd, 0x9b,
+    0x19, 0x53, 0x34, 0x12, 0x90, 0xcc, 0xac, 0x8a, 0x20, 0x63, 0x32, 0x01, 0xb8, 0xbd, 0xac, 0x09,
+    0x41, 0x43, 0x23, 0x81, 0xdb, 0xbc, 0xaa, 0x28, 0x53, 0x34, 0x12, 0xa8, 0xcc, 0xcb, 0x89, 0x20,
+    0x44, 0x23, 0x02, 0xba, 0xbe, 0xab, 0x09, 0x52, 0x53, 0x12, 0x80, 0xcb, 0xcb, 0x9b, 0x28, 0x44,
+    0x43, 0x11, 0xa8, 0xcc, 0xab, 0x8a, 0x31, 0x45, 0x23, 0x81, 0xc9, 0xbc, 0x9c, 0x09, 0x43, 0x53,
+    0x12, 0x90, 0xcb, 0xbc, 0x9a, 0x20, 0x44, 0x43, 0x01, 0xa8, 0xbd, 0xbb, 0x89, 0x42, 0x44, 0x23,
+    0x80, 0xca, 0xbc, 0xbb, 0x18, 0x44, 0x34, 0x12, 0xa0, 0xcc, 0xcb, 0x99, 0x20, 0x44, 0x33, 0x01,
+    0xb9, 0xcd, 0xab, 0x09, 0x41, 0x44, 0x22, 0x80, 0xcb, 0xbc, 0x9a, 0x18, 0x63, 0x33, 0x12, 0xb0,
+    0xdc, 0xbb, 0x8a, 0x31, 0x45, 0x23, 0x01, 0xc9, 0xbc, 0xac, 0x08, 0x42, 0x33, 0x33, 0x02, 0xa8,
+    0xdc, 0xcb, 0xab, 0x9a, 0x20, 0x63, 0x43, 0x23, 0x12, 0x90, 0xdb, 0xcc, 0xba, 0x9a, 0x18, 0x43,
+    0x44, 0x33, 0x22, 0x90, 0xca, 0xbd, 0xbc, 0xaa, 0x08, 0x42, 0x34, 0x25, 0x22, 0x81, 0xb9, 0xcd,
+    0xbb, 0xab, 0x0a, 0x41, 0x44, 0x43, 0x32, 0x81, 0xb8, 0xcc, 0xbc, 0xab, 0x8a, 0x30, 0x54, 0x43,
+    0x23, 0x02, 0xa8, 0xcc, 0xdb, 0xba, 0x99, 0x10, 0x53, 0x34, 0x33, 0x22, 0x98, 0xcc, 0xbc, 0xac,
+    0xaa, 0x00, 0x43, 0x44, 0x33, 0x22, 0x80, 0xcb, 0xbd, 0xbc, 0xaa, 0x08, 0x32, 0x36, 0x34, 0x22,
+    0x81, 0xc9, 0xdb, 0xac, 0xab, 0x88, 0x31, 0x44, 0x34, 0x23, 0x01, 0xb8, 0xcd, 0xcb, 0xba, 0x89,
+    0x20, 0x44, 0x34, 0x33, 0x11, 0xa8, 0xcc, 0xcc, 0xba, 0x99, 0x10, 0x53, 0x53, 0x32, 0x02, 0x90,
+    0xda, 0xdb, 0xba, 0x9a, 0x08, 0x43, 0x44, 0x33, 0x22, 0x80, 0xda, 0xdb, 0xbb, 0xab, 0x08, 0x32,
+    0x37, 0x43, 0x22, 0x00, 0xaa, 0xcd, 0xbb, 0xab, 0x0a, 0x31, 0x36, 0x25, 0x23, 0x01, 0xb8, 0xcc,
+    0xbc, 0xab, 0x8a, 0x20, 0x54, 0x43, 0x23, 0x02, 0xa0, 0xcc, 0xdb, 0xba, 0x99, 0x28, 0x43, 0x35,
+    0x33, 0x22, 0xa0, 0xdb, 0xbd, 0xbb, 0x9b, 0x19, 0x53, 0x44, 0x33, 0x13, 0x91, 0xca, 0xbd, 0xbc,
+    0xaa, 0x88, 0x42, 0x34, 0x25, 0x13, 0x01, 0xaa, 0xcd, 0xbb, 0xbb, 0x89, 0x32, 0x45, 0x34, 0x23,
+    0x02, 0xa9, 0xcd, 0xcb, 0xab, 0x99, 0x21, 0x63, 0x43, 0x23, 0x12, 0xa8, 0xeb, 0xcb, 0xab, 0x9a,
+    0x18, 0x34, 0x45, 0x32, 0x12, 0x88, 0xcb, 0xcc, 0xbb, 0xaa, 0x18, 0x52, 0x53, 0x33, 0x13, 0x81,
+    0xda, 0xdb, 0xbb, 0xab, 0x09, 0x42, 0x44, 0x24, 0x13, 0x01, 0xaa, 0xcd, 0xbb, 0xab, 0x8a, 0x41,
+    0x44, 0x43, 0x32, 0x01, 0xa9, 0xcc, 0xbc, 0xab, 0x9a, 0x21, 0x44, 0x44, 0x22, 0x12, 0xa8, 0xcb,
+    0xbd, 0xbb, 0x9a, 0x18, 0x44, 0x34, 0x34, 0x21, 0x88, 0xcb, 0xcc, 0xbb, 0xaa, 0x08, 0x43, 0x35,
+    0x34, 0x22, 0x80, 0xca, 0xcc, 0xbb, 0x9b, 0x89, 0x42, 0x44, 0x24, 0x13, 0x01, 0xb9, 0xdc, 0xbb,
+    0xbb, 0x89, 0x31, 0x45, 0x34, 0x23, 0x02, 0xb8, 0xdc, 0xcb, 0xab, 0x8a, 0x20, 0x44, 0x53, 0x32,
+    0x11, 0x98, 0xdb, 0xbc, 0xbb, 0xaa, 0x10, 0x44, 0x34, 0x24, 0x22, 0x88, 0xcb, 0xcc, 0xbb, 0xaa,
+    0x08, 0x43, 0x35, 0x34, 0x22, 0x80, 0xba, 0xbe, 0xbc, 0xaa, 0x09, 0x31, 0x36, 0x34, 0x32, 0x81,
+    0xb9, 0xcd, 0xcb, 0xab, 0x09, 0x30, 0x44, 0x34, 0x23, 0x02, 0xb8, 0xdc, 0xcb, 0xab, 0x8a, 0x20,
+    0x63, 0x43, 0x23, 0x12, 0x98, 0xeb, 0xcb, 0xab, 0x9b, 0x10, 0x53, 0x34, 0x24, 0x13, 0x90, 0xda,
+    0xcb, 0xac, 0x9a, 0x19, 0x32, 0x45, 0x33, 0x13, 0x81, 0xca, 0xcc, 0xac, 0x9b, 0x09, 0x31, 0x54,
+    0x33, 0x33, 0x01, 0xba, 0xdd, 0xbb, 0xbb, 0x99, 0x31, 0x55, 0x33, 0x33, 0x12, 0xb9, 0xdc, 0xbc,
+    0xbb, 0x8a, 0x20, 0x44, 0x34, 0x24, 0x12, 0x98, 0xdb, 0xdb, 0xba, 0x9a, 0x10, 0x52, 0x53, 0x32,
+    0x12, 0x80, 0xcb, 0xcc, 0xbb, 0xaa, 0x08, 0x42, 0x35, 0x34, 0x22, 0x81, 0xca, 0xbc, 0xad, 0x9b,
+    0x89, 0x32, 0x54, 0x33, 0x23, 0x02, 0xba, 0xcd, 0xbc, 0xab, 0x8a, 0x21, 0x45, 0x43, 0x23, 0x11,
+    0xa9, 0xeb, 0xcb, 0xab, 0x9a, 0x20, 0x63, 0x43, 0x23, 0x12, 0x90, 0xbc, 0xcd, 0xba, 0x9a, 0x00,
+    0x43, 0x44, 0x33, 0x22, 0x90, 0xda, 0xdb, 0xbb, 0x9b, 0x09, 0x43, 0x44, 0x24, 0x22, 0x81, 0xba,
+    0xbd, 0xad, 0x9b, 0x89, 0x31, 0x35, 0x25, 0x23, 0x01, 0xb9, 0xcc, 0xbc, 0xab, 0x8a, 0x21, 0x45,
+    0x43, 0x32, 0x11, 0xa8, 0xcc, 0xbc, 0xbb, 0x9a, 0x20, 0x44, 0x44, 0x32, 0x11, 0x90, 0xdb, 0xdb,
+    0xba, 0x9a, 0x18, 0x43, 0x44, 0x33, 0x22, 0x90, 0xca, 0xbd, 0xbc, 0xaa, 0x08, 0x42, 0x34, 0x25,
+    0x13, 0x81, 0xba, 0xdc, 0xbb, 0xab, 0x89, 0x41, 0x44, 0x43, 0x32, 0x81, 0xb8, 0xcc, 0xbc, 0xab,
+    0x8a, 0x30, 0x54, 0x43, 0x23, 0x02, 0xa8, 0xcc, 0xdb, 0xba, 0x99, 0x10, 0x53, 0x34, 0x33, 0x22,
+    0x98, 0xcc, 0xbc, 0xac, 0xaa, 0x00, 0x43, 0x44, 0x33, 0x22, 0x80, 0xcb, 0xbd, 0xbc, 0xaa, 0x08,
+    0x32, 0x36, 0x34, 0x22, 0x81, 0xc9, 0xdb, 0xac, 0xab, 0x88, 0x31, 0x44, 0x34, 0x23, 0x01, 0xb8,
+    0xcd, 0xcb, 0xba, 0x89, 0x20, 0x44, 0x34, 0x33, 0x11, 0xa8, 0xcc, 0xcc, 0xba, 0x99, 0x10, 0x53,
+    0x53, 0x32, 0x12, 0x98, 0xcb, 0xcc, 0xbb, 0x9a, 0x08, 0x53, 0x53, 0x33, 0x13, 0x91, 0xda, 0xdb,
+    0xbb, 0xab, 0x08, 0x42, 0x44, 0x24, 0x22, 0x81, 0xb9, 0xbd, 0xad, 0xab, 0x09, 0x21, 0x35, 0x25,
+    0x23, 0x01, 0xb8, 0xcc, 0xbc, 0xab, 0x8a, 0x20, 0x35, 0x35, 0x33, 0x02, 0x98, 0xdc, 0xcb, 0xab,
+    0x9a, 0x28, 0x53, 0x44, 0x32, 0x02, 0x90, 0xda, 0xcb, 0xac, 0x9a, 0x18, 0x32, 0x45, 0x33, 0x13,
+    0x91, 0xca, 0xbd, 0xbc, 0xaa, 0x08, 0x41, 0x34, 0x25, 0x13, 0x01, 0xba, 0xdc, 0xbb, 0xab, 0x8a,
+    0x32, 0x45, 0x34, 0x23, 0x02, 0xa9, 0xcd, 0xcb, 0xab, 0x99, 0x21, 0x63, 0x43, 0x23, 0x12, 0xa8,
+    0xeb, 0xcb, 0xab, 0x9a, 0x18, 0x34, 0x45, 0x32, 0x12, 0x88, 0xcb, 0xcc, 0xbb, 0xaa, 0x18, 0x52,
+    0x53, 0x33, 0x13, 0x81, 0xcb, 0xcc, 0xac, 0xaa, 0x09, 0x32, 0x35, 0x25, 0x13, 0x01, 0xb9, 0xbd,
+    0xad, 0xab, 0x89, 0x31, 0x44, 0x34, 0x23, 0x02, 0xa9, 0xbd, 0xbd, 0xbb, 0x8a, 0x20, 0x35, 0x35,
+    0x33, 0x12, 0xa8, 0xcc, 0xcc, 0xba, 0x99, 0x18, 0x53, 0x53, 0x32, 0x12, 0x90, 0xda, 0xdb, 0xba,
+    0x9a, 0x19, 0x42, 0x44, 0x33, 0x13, 0x81, 0xda, 0xdb, 0xbb, 0xab, 0x09, 0x42, 0x44, 0x43, 0x22,
+    0x01, 0xb9, 0xbd, 0xad, 0xab, 0x89, 0x21, 0x35, 0x44, 0x22, 0x01, 0xa8, 0xbc, 0xbd, 0xbb, 0x99,
+    0x20, 0x54, 0x43, 0x23, 0x12, 0xa8, 0xdb, 0xbc, 0xac, 0x9a, 0x18, 0x43, 0x35, 0x33, 0x13, 0x90,
+    0xdb, 0xcc, 0xbb, 0xaa, 0x08, 0x43, 0x35, 0x34, 0x22, 0x80, 0xba, 0xbe, 0xbc, 0xaa, 0x09, 0x31,
+    0x36, 0x34, 0x32, 0x81, 0xb9, 0xcd, 0xcb, 0xab, 0x89, 0x31, 0x44, 0x34, 0x23, 0x02, 0xb8, 0xdc,
+    0xcb, 0xab, 0x8a, 0x20, 0x63, 0x43, 0x23, 0x12, 0x98, 0xeb, 0xcb, 0xab, 0x9b, 0x10, 0x53, 0x34,
+    0x34, 0x12, 0x90, 0xcb, 0xcc, 0xbb, 0xaa, 0x08, 0x43, 0x54, 0x32, 0x13, 0x81, 0xca, 0xbc, 0xad,
+    0x9b, 0x09, 0x31, 0x35, 0x25, 0x23, 0x00, 0xa9, 0xbd, 0xad, 0xab, 0x89, 0x30, 0x44, 0x34, 0x23,
+    0x02, 0xa8, 0xbd, 0xbd, 0xbb, 0x8a, 0x10, 0x35, 0x35, 0x33, 0x12, 0x98, 0xcc, 0xbc, 0xac, 0x9a,
+    0x18, 0x52, 0x53, 0x32, 0x12, 0x80, 0xcb, 0xcc, 0xbb, 0xaa, 0x08, 0x52, 0x53, 0x33, 0x23, 0x00,
+    0xca, 0xbd, 0xbc, 0xaa, 0x89, 0x32, 0x45, 0x43, 0x13, 0x01, 0xa9, 0xbd, 0xcc, 0xaa, 0x89, 0x21,
+    0x53, 0x34, 0x33, 0x11, 0xa9, 0xdc, 0xcb, 0xab, 0x8a, 0x28, 0x44, 0x53, 0x32, 0x11, 0xa0, 0xda,
+    0xbc, 0xbb, 0xaa, 0x18, 0x44, 0x34, 0x24, 0x13, 0x90, 0xca, 0xcc, 0xbb, 0xaa, 0x19, 0x42, 0x44,
+    0x24, 0x13, 0x81, 0xba, 0xbd, 0xad, 0x9b, 0x89, 0x31, 0x35, 0x25, 0x23, 0x01, 0xb9, 0xcc, 0xbc,
+    0xab, 0x8a, 0x21, 0x45, 0x33, 0x33, 0x13, 0x81, 0xca, 0xbd, 0xbd, 0xba, 0x9b, 0x09, 0x41, 0x34,
+    0x35, 0x24, 0x12, 0x01, 0xb9, 0xcc, 0xbc, 0xbb, 0x9c, 0x89, 0x21, 0x44, 0x53, 0x32, 0x23, 0x01,
+    0xa8, 0xdc, 0xcb, 0xbb, 0xab, 0x8a, 0x20, 0x44, 0x35, 0x43, 0x22, 0x02, 0xa0, 0xcb, 0xbd, 0xbc,
+    0xbb, 0x99, 0x18, 0x34, 0x45, 0x33, 0x24, 0x02, 0x90, 0xca, 0xbc, 0xad, 0xbb, 0x9a, 0x18, 0x42,
+    0x44, 0x43, 0x33, 0x12, 0x80, 0xba, 0xbe, 0xbd, 0xba, 0x9b, 0x09, 0x32, 0x36, 0x44, 0x32, 0x22,
+    0x81, 0xb9, 0xdc, 0xcb, 0xbb, 0xab, 0x09, 0x30, 0x45, 0x34, 0x43, 0x22, 0x81, 0xa8, 0xeb, 0xcb,
+    0xbb, 0xbb, 0x89, 0x20, 0x54, 0x53, 0x32, 0x33, 0x11, 0xa8, 0xeb, 0xdb, 0xba, 0xbb, 0x8a, 0x28,
+    0x53, 0x44, 0x33, 0x33, 0x13, 0x98, 0xdb, 0xcc, 0xbc, 0xba, 0x9a, 0x18, 0x42, 0x44, 0x34, 0x32,
+    0x12, 0x91, 0xba, 0xbe, 0xbd, 0xba, 0x9b, 0x88, 0x42, 0x34, 0x35, 0x24, 0x12, 0x81, 0xb9, 0xcc,
+    0xbc, 0xbb, 0xbb, 0x09, 0x31, 0x55, 0x43, 0x33, 0x23, 0x01, 0xa9, 0xcd, 0xdb, 0xba, 0xab, 0x89,
+    0x20, 0x63, 0x34, 0x43, 0x22, 0x02, 0xa8, 0xcb, 0xbd, 0xbc, 0xab, 0x9a, 0x10, 0x53, 0x44, 0x43,
+    0x22, 0x02, 0x90, 0xca, 0xcc, 0xbb, 0xac, 0x9a, 0x00, 0x42, 0x34, 0x35, 0x32, 0x12, 0x80, 0xca,
+    0xcc, 0xcb, 0xbb, 0x9a, 0x09, 0x32, 0x36, 0x35, 0x32, 0x13, 0x81, 0xb9, 0xcd, 0xbc, 0xac, 0x9a,
+    0x89, 0x21, 0x44, 0x34, 0x43, 0x22, 0x81, 0xa8, 0xcc, 0xdb, 0xab, 0xab, 0x89, 0x20, 0x44, 0x34,
+    0x34, 0x23, 0x11, 0xa8, 0xcc, 0xbc, 0xbc, 0xab, 0x8a, 0x10, 0x53, 0x44, 0x43, 0x22, 0x11, 0x90,
+    0xcb, 0xbc, 0xbd, 0xba, 0x99, 0x08, 0x43, 0x44, 0x24, 0x33, 0x12, 0x80, 0xca, 0xcc, 0xac, 0xbb,
+    0xaa, 0x08, 0x32, 0x36, 0x35, 0x32, 0x13, 0x81, 0xc9, 0xbc, 0xbd, 0xac, 0x9a, 0x09, 0x30, 0x44,
+    0x34, 0x33, 0x33, 0x01, 0xb9, 0xdd, 0xcb, 0xbb, 0xab, 0x89, 0x20, 0x45, 0x53, 0x32, 0x23, 0x02,
+    0xa8, 0xcc, 0xbc, 0xbc, 0xab, 0x8a, 0x10, 0x63, 0x43, 0x24, 0x23, 0x12, 0x98, 0xcb, 0xbd, 0xbc,
+    0xbb, 0x9a, 0x10, 0x52, 0x44, 0x33, 0x24, 0x12, 0x90, 0xba, 0xbe, 0xbc, 0xbb, 0xaa, 0x08, 0x42,
+    0x54, 0x33, 0x24, 0x13, 0x80, 0xb9, 0xbd, 0xbd, 0xac, 0x9a, 0x09, 0x21, 0x44, 0x34, 0x43, 0x12,
+    0x01, 0xa9, 0xcc, 0xdb, 0xab, 0xab, 0x89, 0x21, 0x44, 0x44, 0x32, 0x23, 0x11, 0xa9, 0xeb, 0xdb,
+    0xab, 0xab, 0x9a, 0x20, 0x63, 0x43, 0x34, 0x22, 0x02, 0x90, 0xdb, 0xdb, 0xcb, 0xaa, 0x8a, 0x18,
+    0x42, 0x34, 0x35, 0x32, 0x12, 0x90, 0xca, 0xcc, 0xac, 0xbb, 0x9a, 0x19, 0x32, 0x36, 0x35, 0x32,
+    0x22, 0x81, 0xca, 0xbc, 0xbd, 0xac, 0x9a, 0x09, 0x31, 0x44, 0x34, 0x33, 0x33, 0x81, 0xb9, 0xdd,
+    0xcb, 0xbb, 0xab, 0x89, 0x21, 0x45, 0x43, 0x24, 0x23, 0x01, 0x99, 0xbc, 0xcd, 0xba, 0xab, 0x8a,
+    0x10, 0x44, 0x34, 0x34, 0x23, 0x02, 0xa0, 0xdb, 0xcc, 0xbb, 0xac, 0x99, 0x00, 0x43, 0x34, 0x25,
+    0x33, 0x12, 0x88, 0xda, 0xdb, 0xbb, 0xac, 0x9a, 0x08, 0x32, 0x45, 0x24, 0x33, 0x22, 0x80, 0xc9,
+    0xcc, 0xcb, 0xbb, 0xaa, 0x09, 0x32, 0x45, 0x34, 0x43, 0x12, 0x81, 0xb8, 0xcc, 0xbc, 0xbb, 0x9c,
+    0x89, 0x21, 0x63, 0x43, 0x33, 0x23, 0x02, 0xa9, 0xdc, 0xdb, 0xab, 0xab, 0x8a, 0x20, 0x63, 0x43,
+    0x24, 0x23, 0x02, 0x98, 0xcb, 0xbd, 0xbc, 0xbb, 0x99, 0x18, 0x53, 0x44, 0x33, 0x24, 0x02, 0x80,
+    0xbb, 0xbe, 0xbc, 0xbb, 0xaa, 0x18, 0x42, 0x45, 0x33, 0x24, 0x12, 0x81, 0xba, 0xcd, 0xcb, 0xbb,
+    0xaa, 0x09, 0x32, 0x45, 0x34, 0x43, 0x12, 0x81, 0xa9, 0xcc, 0xbc, 0xcb, 0x9a, 0x89, 0x21, 0x63,
+    0x43, 0x33, 0x23, 0x02, 0xa9, 0xdc, 0xbc, 0xcb, 0xaa, 0x99, 0x11, 0x53, 0x34, 0x34, 0x23, 0x12,
+    0xa8, 0xdb, 0xcc, 0xcb, 0xaa, 0x99, 0x00, 0x43, 0x44, 0x33, 0x24, 0x11, 0x90, 0xca, 0xbc, 0xbd,
+    0xba, 0x9a, 0x18, 0x42, 0x44, 0x43, 0x33, 0x12, 0x80, 0xc9, 0xcc, 0xcb, 0xbb, 0xaa, 0x88, 0x32,
+    0x36, 0x44, 0x32, 0x22, 0x81, 0xb9, 0xdc, 0xcb, 0xbb, 0xab, 0x09, 0x21, 0x45, 0x34, 0x43, 0x22,
+    0x81, 0xa8, 0xeb, 0xcb, 0xbb, 0xbb, 0x89, 0x20, 0x54, 0x53, 0x32, 0x33, 0x11, 0xa8, 0xeb, 0xdb,
+    0xba, 0xbb, 0x8a, 0x28, 0x53, 0x44, 0x33, 0x33, 0x13, 0x98, 0xdb, 0xcc, 0xbc, 0xba, 0x9a, 0x18,
+    0x42, 0x44, 0x34, 0x32, 0x12, 0x91, 0xba, 0xbe, 0xbd, 0xba, 0x9b, 0x88, 0x42, 0x34, 0x35, 0x43,
+    0x12, 0x81, 0xb9, 0xcc, 0xbc, 0xbb, 0xbb, 0x09, 0x31, 0x55, 0x43, 0x33, 0x23, 0x01, 0xa9, 0xcd,
+    0xdb, 0xba, 0xab, 0x99, 0x21, 0x63, 0x34, 0x43, 0x22, 0x02, 0xa8, 0xcb, 0xbd, 0xbc, 0xbb, 0x99,
+    0x10, 0x53, 0x44, 0x43, 0x22, 0x02, 0x90, 0xca, 0xcc, 0xbb, 0xac, 0x9a, 0x00, 0x42, 0x34, 0x35,
+    0x32, 0x12, 0x80, 0xca, 0xcc, 0xcb, 0xbb, 0x9a, 0x09, 0x42, 0x34, 0x35, 0x24, 0x12, 0x81, 0xb9,
+    0xcc, 0xbc, 0xcb, 0x9a, 0x09, 0x30, 0x44, 0x53, 0x23, 0x13, 0x82, 0xb8, 0xcc, 0xcc, 0xba, 0xab,
+    0x89, 0x20, 0x44, 0x44, 0x32, 0x23, 0x02, 0xa8, 0xeb, 0xdb, 0xba, 0xbb, 0x99, 0x10, 0x63, 0x43,
+    0x24, 0x23, 0x12, 0x98, 0xda, 0xdb, 0xbb, 0xac, 0x8a, 0x08, 0x42, 0x44, 0x33, 0x24, 0x12, 0x90,
+    0xc9, 0xbc, 0xad, 0xbb, 0xaa, 0x08, 0x42, 0x34, 0x35, 0x24, 0x12, 0x00, 0xaa, 0xcc, 0xbc, 0xac,
+    0x9a, 0x89, 0x31, 0x44, 0x34, 0x33, 0x14, 0x01, 0xa9, 0xcc, 0xdb, 0xba, 0xab, 0x89, 0x20, 0x54,
+    0x43, 0x33, 0x23, 0x02, 0xa8, 0xcc, 0xbd, 0xcb, 0xaa, 0x8a, 0x28, 0x43, 0x35, 0x34, 0x33, 0x11,
+    0x90, 0xbc, 0xcd, 0xbb, 0xac, 0x8a, 0x18, 0x42, 0x34, 0x25, 0x33, 0x12, 0x90, 0xca, 0xcc, 0xcb,
+    0xbb, 0x9a, 0x08, 0x32, 0x36, 0x35, 0x32, 0x13, 0x81, 0xba, 0xbe, 0xcc, 0xba, 0xaa, 0x09, 0x31,
+    0x54, 0x43, 0x33, 0x23, 0x81, 0xb8, 0xcd, 0xbc, 0xcb, 0xaa, 0x09, 0x20, 0x63, 0x43, 0x33, 0x33,
+    0x01, 0xa8, 0xdc, 0xdb, 0xba, 0xbb, 0x99, 0x20, 0x63, 0x53, 0x32, 0x33, 0x02, 0xa0, 0xdb, 0xcc,
+    0xbb, 0xbb, 0x9b, 0x10, 0x53, 0x44, 0x34, 0x32, 0x12, 0x90, 0xca, 0xcc, 0xbc, 0xba, 0x9a, 0x19,
+    0x32, 0x36, 0x35, 0x32, 0x13, 0x00, 0xca, 0xbc, 0xbd, 0xac, 0x9a, 0x09, 0x31, 0x44, 0x34, 0x33,
+    0x33, 0x81, 0xb9, 0xdd, 0xcb, 0xbb, 0xab, 0x89, 0x21, 0x45, 0x53, 0x32, 0x23, 0x01, 0xa8, 0xeb,
+    0xbc, 0xcb, 0xaa, 0x8a, 0x20, 0x43, 0x35, 0x34, 0x23, 0x12, 0x98, 0xdb, 0xcc, 0xcb, 0xaa, 0x8a,
+    0x18, 0x42, 0x44, 0x33, 0x24, 0x12, 0x88, 0xca, 0xbc, 0xbd, 0xba, 0x9a, 0x08, 0x42, 0x44, 0x43,
+    0x33, 0x12, 0x81, 0xba, 0xbe, 0xbd, 0xba, 0x9b, 0x09, 0x31, 0x45, 0x34, 0x24, 0x12, 0x01, 0xa9,
+    0xcc, 0xbc, 0xcb, 0xaa, 0x09, 0x20, 0x44, 0x53, 0x23, 0x23, 0x01, 0xa8, 0xcc, 0xbc, 0xbc, 0xab,
+    0x99, 0x20, 0x44, 0x34, 0x34, 0x23, 0x02, 0x98, 0xdb, 0xcc, 0xcb, 0xaa, 0x99, 0x18, 0x43, 0x34,
+    0x35, 0x32, 0x11, 0x80, 0xcb, 0xcc, 0xac, 0xbb, 0x9a, 0x08, 0x42, 0x44,
+};
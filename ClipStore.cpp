@@ -0,0 +1,105 @@
+/**
+ * @file ClipStore.cpp
+ * @brief Short IMA-ADPCM clips kept in on-chip flash: UI sounds, chimes & the fallback loop
+**/
+#include "ClipStore.h"
+#include <string.h>
+
+/**
+ * @brief IMA-ADPCM quantizer step sizes
+**/
+static const int16_t imaSteps[89] =
+{
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80,
+    88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544,
+    598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749,
+    3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635,
+    13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+/**
+ * @brief Change of the step index after each code
+**/
+static const int8_t imaIndexStep[16] = {-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8};
+
+ClipStore::ClipStore(const uint8_t *image)
+{
+    const ClipImageHeader *header = (const ClipImageHeader *)image;
+    this->image = image;
+    entries = (const ClipEntry *)(image + sizeof(ClipImageHeader));
+    num_clips = header->magic == CLIP_MAGIC ? header->count : 0;
+}
+
+int ClipStore::find(const char *name) const
+{
+    for (int i = 0; i < num_clips; i++)
+    {
+        if (strncmp(entries[i].name, name, CLIP_NAME_LEN) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void ClipVoice::start(const uint8_t *data, const ClipEntry &entry, uint32_t tick_rate)
+{
+    active = false;
+    this->data = data;
+    samples = entry.samples;
+    rate = entry.rate;
+    loop = (entry.flags & CLIP_LOOP) != 0;
+    position = 0;
+    predictor = 0;
+    index = 0;
+    retime(tick_rate);
+    // The first tick decodes the first sample
+    phase = step < 0x10000 ? 0x10000 - step : 0;
+    active = samples > 0;
+}
+
+void ClipVoice::retime(uint32_t tick_rate)
+{
+    step = tick_rate ? (rate << 16) / tick_rate : 0x10000;
+}
+
+int32_t ClipVoice::next()
+{
+    phase += step;
+    while (phase >= 0x10000)
+    {
+        phase -= 0x10000;
+        if (position == samples)
+        {
+            if (!loop)
+            {
+                active = false;
+                return 0;
+            }
+            position = 0;
+            predictor = 0;
+            index = 0;
+        }
+        int code = (data[position >> 1] >> ((position & 1) * 4)) & 0x0F;
+        position++;
+        int32_t quantum = imaSteps[index];
+        int32_t diff = quantum >> 3;
+        if (code & 1)
+        {
+            diff += quantum >> 2;
+        }
+        if (code & 2)
+        {
+            diff += quantum >> 1;
+        }
+        if (code & 4)
+        {
+            diff += quantum;
+        }
+        predictor += (code & 8) ? -diff : diff;
+        predictor = predictor > 32767 ? 32767 : (predictor < -32768 ? -32768 : predictor);
+        index += imaIndexStep[code];
+        index = index < 0 ? 0 : (index > 88 ? 88 : index);
+    }
+    return predictor;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file ClipStore.h
+ * @brief Short IMA-ADPCM clips kept in on-chip flash: UI sounds, chimes & the fallback loop
+ * @details tools/pack_clips.py packs the clips into ClipData.cpp as one const image: a header, an
+ * index of the clips & their ADPCM data. Being const, the image stays in flash, & a voice decodes
+ * straight from it in the sample interrupt, so a clip plays without the card & without a copy in RAM.
+ * Each clip is one mono stream of 4 bit codes, low nibble first, decoded from a predictor & step
+ * index of 0, which is also where a looping clip starts over.
+**/
+#ifndef CLIPSTORE_H
+#define CLIPSTORE_H
+
+#include "mbed.h"
+
+// Marks a clip image ("CLIP")
+#define CLIP_MAGIC 0x50494C43
+#define CLIP_NAME_LEN 12
+
+// ClipEntry flags
+#define CLIP_LOOP 0x01          // Plays until stopped, starting over at its end
+
+/**
+ * @brief Start of the image
+**/
+struct ClipImageHeader
+{
+    uint32_t magic;
+    uint16_t count;             // Entries following the header
+    uint16_t reserved;
+};
+
+/**
+ * @brief One clip of the index
+**/
+struct ClipEntry
+{
+    char name[CLIP_NAME_LEN];   // Zero padded
+    uint32_t offset;            // Of the ADPCM data, from the start of the image
+    uint32_t samples;
+    uint16_t rate;
+    uint8_t flags;
+    uint8_t reserved;
+};
+
+/**
+ * @brief The image built into the firmware by ClipData.cpp
+**/
+extern const uint8_t clipImage[];
+
+/**
+ * @brief Index of a clip image
+**/
+class ClipStore
+{
+public:
+    /**
+     * @param image Start of the image, e.g. clipImage
+    **/
+    ClipStore(const uint8_t *image);
+
+    /**
+     * @brief Number of clips; 0 if the image is missing or not a clip image
+    **/
+    int count() const { return num_clips; }
+
+    /**
+     * @brief Looks up a clip by name
+     * @return Clip number, or -1 if there is no such clip
+    **/
+    int find(const char *name) const;
+
+    const ClipEntry &entry(int clip) const { return entries[clip]; }
+    const uint8_t *data(int clip) const { return image + entries[clip].offset; }
+
+private:
+    const uint8_t *image;
+    const ClipEntry *entries;
+    int num_clips;
+};
+
+/**
+ * @brief Decoder of one clip playing, stepped by the sample interrupt
+**/
+struct ClipVoice
+{
+    const uint8_t *data;
+    uint32_t samples;
+    uint32_t position;          // Next sample to decode
+    uint32_t phase;             // Fraction of a clip sample, 16.16, for clips at another rate than the clock
+    uint32_t step;              // Clip samples per clock tick, 16.16
+    uint32_t rate;
+    int32_t predictor;
+    int index;
+    bool loop;
+    volatile bool active;
+
+    /**
+     * @brief Starts a clip from its first sample, looping it if the entry is flagged CLIP_LOOP
+     * @param tick_rate Rate of the sample clock it is mixed at
+    **/
+    void start(const uint8_t *data, const ClipEntry &entry, uint32_t tick_rate);
+
+    /**
+     * @brief Sets the rate of the sample clock the voice is mixed at
+    **/
+    void retime(uint32_t tick_rate);
+
+    /**
+     * @brief Advances one clock tick & returns the clip's signed sample there; clears active at the end
+    **/
+    int32_t next();
+};
+
+#endif
@@ -0,0 +1,472 @@
+/**
+ * @file ClockGovernor.cpp
+ * @brief Scales the CPU clock to the measured load & the decode cost of the playing stream
+**/
+#include "ClockGovernor.h"
+#include "TrackStream.h"
+
+// PCLKSEL field of each peripheral: register * 32 + bit
+#define PCLK_TIMER0 2
+#define PCLK_TIMER1 4
+#define PCLK_UART0  6
+#define PCLK_UART1  8
+#define PCLK_I2C0   14
+#define PCLK_SSP1   20
+#define PCLK_I2C1   (32 + 6)
+#define PCLK_SSP0   (32 + 10)
+#define PCLK_TIMER2 (32 + 12)
+#define PCLK_TIMER3 (32 + 14)
+#define PCLK_UART2  (32 + 16)
+#define PCLK_UART3  (32 + 18)
+#define PCLK_I2C2   (32 + 20)
+
+// PCONP power bits
+#define PCONP_TIMER0 (1 << 1)
+#define PCONP_TIMER1 (1 << 2)
+#define PCONP_UART0  (1 << 3)
+#define PCONP_UART1  (1 << 4)
+#define PCONP_I2C0   (1 << 7)
+#define PCONP_SSP1   (1 << 10)
+#define PCONP_I2C1   (1 << 19)
+#define PCONP_SSP0   (1 << 21)
+#define PCONP_TIMER2 (1 << 22)
+#define PCONP_TIMER3 (1 << 23)
+#define PCONP_UART2  (1 << 24)
+#define PCONP_UART3  (1 << 25)
+#define PCONP_I2C2   (1 << 26)
+
+// Slowest clock step the governor will use
+#define GOVERNOR_MIN_HZ 12000000
+
+/**
+ * @brief Peripheral clock of a peripheral at a given CCLK
+**/
+static uint32_t pclk(uint32_t cclk, int field)
+{
+    static const uint8_t div[4] = {4, 1, 2, 8};
+    uint32_t sel = (field < 32 ? LPC_SC->PCLKSEL0 : LPC_SC->PCLKSEL1) >> (field % 32);
+    return cclk / div[sel & 3];
+}
+
+/**
+ * @brief Flash accelerator wait states for a CCLK
+**/
+static uint32_t flash_config(uint32_t cclk)
+{
+    uint32_t wait = cclk <= 20000000 ? 0 : cclk <= 40000000 ? 1 : cclk <= 60000000 ? 2 : cclk <= 80000000 ? 3 : 4;
+    return (LPC_SC->FLASHCFG & 0x0FFF) | (wait << 12);
+}
+
+/**
+ * @brief Divisor settings of one UART, current & planned
+**/
+struct UartPlan
+{
+    bool active;
+    uint16_t dl;
+    uint8_t fdr;
+    uint16_t new_dl;
+    uint8_t new_fdr;
+};
+
+template <class UART> static void read_uart(UART *uart, UartPlan *plan)
+{
+    __disable_irq();
+    uint8_t lcr = uart->LCR;
+    uart->LCR = lcr | 0x80;
+    plan->dl = uart->DLL | (uart->DLM << 8);
+    uart->LCR = lcr;
+    plan->fdr = uart->FDR;
+    __enable_irq();
+}
+
+template <class UART> static bool uart_unchanged(UART *uart, const UartPlan &plan)
+{
+    uint8_t lcr = uart->LCR;
+    uart->LCR = lcr | 0x80;
+    uint16_t dl = uart->DLL | (uart->DLM << 8);
+    uart->LCR = lcr;
+    return dl == plan.dl && (uint8_t)uart->FDR == plan.fdr;
+}
+
+template <class UART> static void write_uart(UART *uart, const UartPlan &plan)
+{
+    uint8_t lcr = uart->LCR;
+    uart->LCR = lcr | 0x80;
+    uart->DLL = plan.new_dl & 0xFF;
+    uart->DLM = plan.new_dl >> 8;
+    uart->LCR = lcr;
+    uart->FDR = plan.new_fdr;
+}
+
+/**
+ * @brief Finds divisor & fractional divider values that keep a UART at its baud rate on a new PCLK
+ * @return false if no setting is within GOVERNOR_BAUD_TOLERANCE
+**/
+static bool plan_baud(uint32_t old_pclk, uint32_t new_pclk, UartPlan *plan)
+{
+    uint32_t mul = plan->fdr >> 4;
+    uint32_t add = plan->fdr & 0x0F;
+    if (mul == 0)
+    {
+        mul = 1;
+    }
+    uint64_t den = 16ULL * plan->dl * (mul + add);
+    uint32_t baud = (uint32_t)(((uint64_t)old_pclk * mul + den / 2) / den);
+
+    uint32_t best = 0xFFFFFFFF;
+    for (uint32_t m = 1; m <= 15; m++)
+    {
+        for (uint32_t a = 0; a < m; a++)
+        {
+            uint64_t step = 16ULL * baud * (m + a);
+            uint32_t dl = (uint32_t)(((uint64_t)new_pclk * m + step / 2) / step);
+            // A fractional divider needs a divisor of at least 3
+            if (dl == 0 || dl > 0xFFFF || (a > 0 && dl < 3))
+            {
+                continue;
+            }
+            uint32_t actual = (uint32_t)((uint64_t)new_pclk * m / (16ULL * dl * (m + a)));
+            uint32_t err = actual > baud ? actual - baud : baud - actual;
+            if (err < best)
+            {
+                best = err;
+                plan->new_dl = dl;
+                plan->new_fdr = (m << 4) | a;
+            }
+        }
+    }
+    return (uint64_t)best * 1000 <= (uint64_t)baud * GOVERNOR_BAUD_TOLERANCE;
+}
+
+/**
+ * @brief Finds the fastest SSP prescaler & clock rate at or below the current SPI clock on a new PCLK
+**/
+static bool plan_ssp(LPC_SSP_TypeDef *ssp, uint32_t old_pclk, uint32_t new_pclk, uint32_t *cpsr, uint32_t *scr)
+{
+    uint32_t rate = old_pclk / (ssp->CPSR * (((ssp->CR0 >> 8) & 0xFF) + 1));
+    uint32_t best = 0;
+    for (uint32_t p = 2; p <= 254 && best != rate; p += 2)
+    {
+        uint32_t s = (new_pclk + p * rate - 1) / (p * rate);
+        if (s == 0)
+        {
+            s = 1;
+        }
+        if (s > 256)
+        {
+            continue;
+        }
+        uint32_t r = new_pclk / (p * s);
+        if (r <= rate && r > best)
+        {
+            best = r;
+            *cpsr = p;
+            *scr = s - 1;
+        }
+    }
+    return best > 0;
+}
+
+ClockGovernor::ClockGovernor()
+{
+    fcco = 0;
+    num_levels = 0;
+    level = 0;
+    hold = 0;
+    idle_count = 0;
+    last_idle = 0;
+    idle_per_mhz_ms = 0;
+    load_percent = 0;
+    switch_count = 0;
+    refused_count = 0;
+}
+
+void ClockGovernor::idle()
+{
+    while (true)
+    {
+        idle_count++;
+    }
+}
+
+bool ClockGovernor::calibrate(uint32_t window_ms)
+{
+    // PLL0 must be enabled & connected
+    uint32_t stat = LPC_SC->PLL0STAT;
+    if ((stat & (3 << 24)) != (3 << 24))
+    {
+        Thread::wait(window_ms);
+        return false;
+    }
+    uint32_t m = (stat & 0x7FFF) + 1;
+    uint32_t n = ((stat >> 16) & 0xFF) + 1;
+    uint32_t fin = (LPC_SC->CLKSRCSEL & 3) == 1 ? 12000000 : 4000000;
+    fcco = (uint32_t)(2ULL * m * fin / n);
+
+    // Keep dividers that give whole MHz on the CPU and on the us_ticker timer
+    uint32_t first = LPC_SC->CCLKCFG + 1;
+    num_levels = 0;
+    for (uint32_t d = first; d <= 256 && num_levels < GOVERNOR_MAX_LEVELS; d++)
+    {
+        uint32_t hz = fcco / d;
+        if (hz < GOVERNOR_MIN_HZ)
+        {
+            break;
+        }
+        if (fcco % d == 0 && hz % 1000000 == 0 && pclk(hz, PCLK_TIMER3) % 1000000 == 0)
+        {
+            dividers[num_levels++] = d;
+        }
+    }
+    level = 0;
+
+    // Measure the idle loop rate with nothing else running
+    uint32_t start = idle_count;
+    Thread::wait(window_ms);
+    uint32_t passes = idle_count - start;
+    last_idle = idle_count;
+    idle_per_mhz_ms = passes / window_ms / (SystemCoreClock / 1000000);
+    if (idle_per_mhz_ms == 0)
+    {
+        num_levels = 0;
+    }
+    return num_levels > 1;
+}
+
+/**
+ * @brief Moves CCLK to one of the clock steps, re-deriving every clock-dependent divider
+ * @details Dividers are planned with interrupts enabled, then applied together in one short critical
+ * section, so the sample interrupt is delayed by a few microseconds at most. The step is refused if
+ * the card is in use, if a UART is sending, if a baud rate cannot be kept or if a divider changed since
+ * it was planned.
+**/
+bool ClockGovernor::switch_to(int index)
+{
+    uint32_t old_hz = SystemCoreClock;
+    uint32_t new_hz = fcco / dividers[index];
+    uint32_t pconp = LPC_SC->PCONP;
+    bool ok = true;
+
+    // UARTs
+    UartPlan uart[4];
+    uint32_t uart_power[4] = {PCONP_UART0, PCONP_UART1, PCONP_UART2, PCONP_UART3};
+    int uart_pclk[4] = {PCLK_UART0, PCLK_UART1, PCLK_UART2, PCLK_UART3};
+    for (int i = 0; i < 4; i++)
+    {
+        uart[i].active = (pconp & uart_power[i]) != 0;
+        if (!uart[i].active)
+        {
+            continue;
+        }
+        switch (i)
+        {
+            case 0: read_uart(LPC_UART0, &uart[i]); break;
+            case 1: read_uart(LPC_UART1, &uart[i]); break;
+            case 2: read_uart(LPC_UART2, &uart[i]); break;
+            default: read_uart(LPC_UART3, &uart[i]); break;
+        }
+        uart[i].active = uart[i].dl != 0;
+        if (uart[i].active)
+        {
+            ok = ok && plan_baud(pclk(old_hz, uart_pclk[i]), pclk(new_hz, uart_pclk[i]), &uart[i]);
+        }
+    }
+
+    // SSP (SD card on SSP1)
+    LPC_SSP_TypeDef *ssp[2] = {LPC_SSP0, LPC_SSP1};
+    uint32_t ssp_power[2] = {PCONP_SSP0, PCONP_SSP1};
+    int ssp_pclk[2] = {PCLK_SSP0, PCLK_SSP1};
+    bool ssp_active[2];
+    uint32_t ssp_cpsr[2];
+    uint32_t ssp_scr[2];
+    for (int i = 0; i < 2; i++)
+    {
+        ssp_active[i] = (pconp & ssp_power[i]) && ssp[i]->CPSR != 0;
+        if (ssp_active[i])
+        {
+            ok = ok && plan_ssp(ssp[i], pclk(old_hz, ssp_pclk[i]), pclk(new_hz, ssp_pclk[i]), &ssp_cpsr[i], &ssp_scr[i]);
+        }
+    }
+
+    // Timers (the us_ticker on TIMER3 drives every Ticker, including the sample clock)
+    LPC_TIM_TypeDef *timer[4] = {LPC_TIM0, LPC_TIM1, LPC_TIM2, LPC_TIM3};
+    uint32_t timer_power[4] = {PCONP_TIMER0, PCONP_TIMER1, PCONP_TIMER2, PCONP_TIMER3};
+    int timer_pclk[4] = {PCLK_TIMER0, PCLK_TIMER1, PCLK_TIMER2, PCLK_TIMER3};
+    bool timer_active[4];
+    uint32_t timer_pr[4];
+    for (int i = 0; i < 4; i++)
+    {
+        timer_active[i] = (pconp & timer_power[i]) && (timer[i]->TCR & 1);
+        if (timer_active[i])
+        {
+            uint64_t scaled = (uint64_t)(timer[i]->PR + 1) * pclk(new_hz, timer_pclk[i]);
+            uint32_t from = pclk(old_hz, timer_pclk[i]);
+            ok = ok && scaled % from == 0;
+            timer_pr[i] = (uint32_t)(scaled / from) - 1;
+        }
+    }
+
+    // I2C (accelerometer on I2C1); rounded up so the bus never gets faster
+    LPC_I2C_TypeDef *i2c[3] = {LPC_I2C0, LPC_I2C1, LPC_I2C2};
+    uint32_t i2c_power[3] = {PCONP_I2C0, PCONP_I2C1, PCONP_I2C2};
+    int i2c_pclk[3] = {PCLK_I2C0, PCLK_I2C1, PCLK_I2C2};
+    bool i2c_active[3];
+    uint32_t i2c_high[3];
+    uint32_t i2c_low[3];
+    for (int i = 0; i < 3; i++)
+    {
+        i2c_active[i] = (pconp & i2c_power[i]) && i2c[i]->I2SCLH != 0;
+        if (i2c_active[i])
+        {
+            uint32_t from = pclk(old_hz, i2c_pclk[i]);
+            uint32_t to = pclk(new_hz, i2c_pclk[i]);
+            i2c_high[i] = (uint32_t)(((uint64_t)i2c[i]->I2SCLH * to + from - 1) / from);
+            i2c_low[i] = (uint32_t)(((uint64_t)i2c[i]->I2SCLL * to + from - 1) / from);
+            i2c_high[i] = i2c_high[i] < 4 ? 4 : i2c_high[i];
+            i2c_low[i] = i2c_low[i] < 4 ? 4 : i2c_low[i];
+        }
+    }
+
+    if (!ok)
+    {
+        refused_count++;
+        return false;
+    }
+
+    // Apply everything between two samples; the SD card must not be mid-transfer. The governor runs
+    // as a timer job, which must not wait out a directory scan or a long write for the card
+    if (!sdMutex.trylock())
+    {
+        refused_count++;
+        return false;
+    }
+    __disable_irq();
+    bool idle_uarts = true;
+    if (uart[0].active) idle_uarts = idle_uarts && (LPC_UART0->LSR & 0x40) && uart_unchanged(LPC_UART0, uart[0]);
+    if (uart[1].active) idle_uarts = idle_uarts && (LPC_UART1->LSR & 0x40) && uart_unchanged(LPC_UART1, uart[1]);
+    if (uart[2].active) idle_uarts = idle_uarts && (LPC_UART2->LSR & 0x40) && uart_unchanged(LPC_UART2, uart[2]);
+    if (uart[3].active) idle_uarts = idle_uarts && (LPC_UART3->LSR & 0x40) && uart_unchanged(LPC_UART3, uart[3]);
+    if (idle_uarts)
+    {
+        if (new_hz > old_hz)
+        {
+            LPC_SC->FLASHCFG = flash_config(new_hz);
+        }
+        for (int i = 0; i < 2; i++)
+        {
+            if (ssp_active[i])
+            {
+                uint32_t cr1 = ssp[i]->CR1;
+                ssp[i]->CR1 = cr1 & ~2;
+                ssp[i]->CPSR = ssp_cpsr[i];
+                ssp[i]->CR0 = (ssp[i]->CR0 & 0xFF) | (ssp_scr[i] << 8);
+                ssp[i]->CR1 = cr1;
+            }
+        }
+
+        LPC_SC->CCLKCFG = dividers[index] - 1;
+
+        if (uart[0].active) write_uart(LPC_UART0, uart[0]);
+        if (uart[1].active) write_uart(LPC_UART1, uart[1]);
+        if (uart[2].active) write_uart(LPC_UART2, uart[2]);
+        if (uart[3].active) write_uart(LPC_UART3, uart[3]);
+        for (int i = 0; i < 4; i++)
+        {
+            if (timer_active[i])
+            {
+                timer[i]->PR = timer_pr[i];
+                timer[i]->PC = 0;
+            }
+        }
+        for (int i = 0; i < 3; i++)
+        {
+            if (i2c_active[i])
+            {
+                i2c[i]->I2SCLH = i2c_high[i];
+                i2c[i]->I2SCLL = i2c_low[i];
+            }
+        }
+        // RTOS tick stays at 1 ms
+        SysTick->LOAD = new_hz / 1000 - 1;
+        SysTick->VAL = 0;
+        if (new_hz < old_hz)
+        {
+            LPC_SC->FLASHCFG = flash_config(new_hz);
+        }
+        SystemCoreClock = new_hz;
+        level = index;
+        switch_count++;
+    }
+    __enable_irq();
+    sdMutex.unlock();
+    if (!idle_uarts)
+    {
+        refused_count++;
+    }
+    return idle_uarts;
+}
+
+bool ClockGovernor::update(uint32_t window_ms, uint32_t stream_Bps, uint32_t stream_rate)
+{
+    uint32_t count = idle_count;
+    uint32_t passes = count - last_idle;
+    last_idle = count;
+    if (num_levels < 2 || window_ms == 0)
+    {
+        return false;
+    }
+
+    // Share of the window not spent in the idle thread
+    uint64_t full = (uint64_t)idle_per_mhz_ms * window_ms * (SystemCoreClock / 1000000);
+    load_percent = passes >= full ? 0 : (unsigned)(100 - passes * 100ULL / full);
+
+    // Clock needed for the measured work and for decoding the current stream, with headroom
+    uint64_t need = (uint64_t)SystemCoreClock * load_percent / GOVERNOR_TARGET_LOAD;
+    uint64_t decode = ((uint64_t)stream_Bps * GOVERNOR_CYCLES_PER_BYTE + (uint64_t)stream_rate * GOVERNOR_CYCLES_PER_SAMPLE) * 100 / GOVERNOR_TARGET_LOAD;
+    if (decode > need)
+    {
+        need = decode;
+    }
+    int target = 0;
+    for (int i = num_levels - 1; i >= 0; i--)
+    {
+        if (fcco / dividers[i] >= need)
+        {
+            target = i;
+            break;
+        }
+    }
+
+    // Step up at once, step down only after a few quiet windows
+    if (target < level)
+    {
+        hold = 0;
+        for (int i = target; i >= 0; i--)
+        {
+            if (switch_to(i))
+            {
+                return true;
+            }
+        }
+    }
+    else if (target > level)
+    {
+        if (++hold >= GOVERNOR_HOLD_WINDOWS)
+        {
+            hold = 0;
+            for (int i = target; i > level; i--)
+            {
+                if (switch_to(i))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    else
+    {
+        hold = 0;
+    }
+    return false;
+}
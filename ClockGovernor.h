@@ -0,0 +1,79 @@
+/**
+ * @file ClockGovernor.h
+ * @brief Scales the CPU clock to the measured load & the decode cost of the playing stream
+ * @details CCLK is stepped by changing the divider after PLL0, which keeps PLL0 locked so every step
+ * is glitch-free. Each step re-derives the SSP, UART, I2C & timer dividers, the flash wait states
+ * and the RTOS tick so baud rates, the SD clock and the 1 MHz us_ticker behind the sample clock
+ * stay exact. Steps that would move a baud rate, or that find the card in use, are refused.
+**/
+#ifndef CLOCKGOVERNOR_H
+#define CLOCKGOVERNOR_H
+
+#include "mbed.h"
+
+// Largest number of clock steps derived from PLL0
+#define GOVERNOR_MAX_LEVELS 6
+// Percentage of the chosen clock the measured work may use
+#define GOVERNOR_TARGET_LOAD 70
+// Consecutive quiet windows required before stepping down
+#define GOVERNOR_HOLD_WINDOWS 4
+// CPU cycles to fetch one byte of a stream from the card over polled SPI
+#define GOVERNOR_CYCLES_PER_BYTE 120
+// CPU cycles to decode one sample & write it to the DAC from the sample interrupt
+#define GOVERNOR_CYCLES_PER_SAMPLE 200
+// Largest baud rate error a step may leave on any UART, in parts per thousand
+#define GOVERNOR_BAUD_TOLERANCE 1
+
+/**
+ * @brief CPU clock governor for the LPC1768
+**/
+class ClockGovernor
+{
+public:
+    ClockGovernor();
+
+    /**
+     * @brief Derives the clock steps from PLL0 & measures the idle loop rate
+     * @details Call before the other threads start, with the idle thread already running, so that
+     * the window is spent entirely in idle().
+     * @param window_ms Length of the calibration window
+     * @return false if PLL0 is not in use, in which case the governor stays at full speed
+    **/
+    bool calibrate(uint32_t window_ms);
+
+    /**
+     * @brief Counts idle time; body of a thread at osPriorityIdle. Never returns.
+    **/
+    void idle();
+
+    /**
+     * @brief Measures the load of the last window & steps the clock if needed
+     * @param window_ms Time since the previous call
+     * @param stream_Bps Bytes per second of the playing stream, 0 when nothing plays
+     * @param stream_rate Sample rate of the playing stream, 0 when nothing plays
+     * @return true if the clock was changed
+    **/
+    bool update(uint32_t window_ms, uint32_t stream_Bps, uint32_t stream_rate);
+
+    uint32_t cpu_hz() const { return SystemCoreClock; }
+    unsigned load() const { return load_percent; }
+    unsigned transitions() const { return switch_count; }
+    unsigned refusals() const { return refused_count; }
+
+private:
+    bool switch_to(int index);
+
+    uint32_t fcco;                              // PLL0 output frequency
+    uint32_t dividers[GOVERNOR_MAX_LEVELS];     // CCLK dividers, fastest first
+    int num_levels;
+    int level;
+    int hold;
+    volatile uint32_t idle_count;
+    uint32_t last_idle;
+    uint32_t idle_per_mhz_ms;                   // Idle loop passes per ms per MHz of CCLK
+    unsigned load_percent;
+    unsigned switch_count;
+    unsigned refused_count;
+};
+
+#endif
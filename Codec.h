@@ -0,0 +1,124 @@
+/**
+ * @file Codec.h
+ * @brief Codec interface & the registry of codecs compiled into the build
+ * @details A codec is chosen once per stream, from the format's comp_code, and bound to the stream as
+ * a Decoder holding the block function for that exact format. The player then makes one indirect call
+ * per block; nothing is dispatched per sample. Which codecs are built is set by the CODEC_ flags below,
+ * which a build profile can override with -D.
+**/
+#ifndef CODEC_H
+#define CODEC_H
+
+#include "mbed.h"
+// FMT_STRUCT comes through SampleSource.h; wave_player.h has no include guard
+#include "SampleSource.h"
+
+// Build profile: set a flag to 0 to leave that codec out of the build
+#ifndef CODEC_PCM
+#define CODEC_PCM 1
+#endif
+#ifndef CODEC_G711
+#define CODEC_G711 1
+#endif
+
+// FMT_STRUCT::comp_code values
+#define WAVE_FORMAT_PCM   1
+#define WAVE_FORMAT_ALAW  6
+#define WAVE_FORMAT_MULAW 7
+
+// First bytes of a RIFF file, read little-endian
+#define MAGIC_RIFF 0x46464952
+// Largest frame (block_align) any decoder accepts
+#define CODEC_MAX_ALIGN 16
+
+struct Decoder;
+
+/**
+ * @brief Decodes whole frames into unsigned 16 bit DAC samples
+ * @param decoder Decoder bound to the stream
+ * @param in Raw frames, block_align bytes each
+ * @param frames Number of frames to decode
+ * @param out Destination of one sample per frame
+ * @return Samples written
+**/
+typedef int (*BlockDecoder)(const Decoder &decoder, const uint8_t *in, int frames, uint16_t *out);
+
+/**
+ * @brief A codec bound to one stream
+**/
+struct Decoder
+{
+    const struct Codec *codec;
+    BlockDecoder decode;        // Block function for the stream's exact format
+    const uint16_t *table;      // Expansion table of table-driven codecs
+    int channels;
+    int align;
+};
+
+/**
+ * @brief One entry of the codec registry
+**/
+struct Codec
+{
+    const char *name;
+    int comp_code;              // FMT_STRUCT::comp_code the codec decodes
+    const char *extensions;     // File name extensions it is found in, e.g. ".wav"
+    uint32_t magic;             // First 4 bytes of the files it is found in
+
+    /**
+     * @brief Checks that the codec can decode a format
+    **/
+    bool (*probe)(const FMT_STRUCT &format);
+
+    /**
+     * @brief Binds the codec to a stream, choosing the block function for its format
+    **/
+    void (*open)(const FMT_STRUCT &format, Decoder *decoder);
+
+    /**
+     * @brief Byte offset within the data of the frame holding a sample
+    **/
+    uint32_t (*seek)(const Decoder &decoder, uint32_t sample);
+};
+
+/**
+ * @brief Finds the codec for a stream format by comp_code
+ * @return The codec, or NULL if no codec in the build can decode the format
+**/
+const Codec *codec_for_format(const FMT_STRUCT &format);
+
+/**
+ * @brief Finds a codec for a file by the extension of its name, ignoring case
+ * @return The first codec found in files with that extension, or NULL
+**/
+const Codec *codec_for_name(const char *name);
+
+/**
+ * @brief Finds a codec for a file by its first 4 bytes
+ * @return The first codec found in files starting with those bytes, or NULL
+**/
+const Codec *codec_for_magic(uint32_t magic);
+
+/**
+ * @brief Chooses & binds the codec for a stream; the once-per-stream dispatch
+ * @return false if the format is malformed or no codec in the build can decode it
+**/
+bool open_decoder(const FMT_STRUCT &format, Decoder *decoder);
+
+/**
+ * @brief Decodes a block through a bound decoder; the once-per-block dispatch
+**/
+inline int decode_block(const Decoder &decoder, const uint8_t *in, int frames, uint16_t *out)
+{
+    return decoder.decode(decoder, in, frames, out);
+}
+
+/**
+ * @brief Byte offset within the data of the frame holding a sample
+**/
+inline uint32_t decoder_seek(const Decoder &decoder, uint32_t sample)
+{
+    return decoder.codec->seek(decoder, sample);
+}
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * @file CodecG711.cpp
+ * @brief G.711 mu-law & A-law codecs, one table load per sample
+**/
+#include "Codec.h"
+#include "G711.h"
+
+#if CODEC_G711
+
+static int decode_g711_mono(const Decoder &decoder, const uint8_t *in, int frames, uint16_t *out)
+{
+    const uint16_t *table = decoder.table;
+    int align = decoder.align;
+    for (int i = 0; i < frames; i++, in += align)
+    {
+        out[i] = table[in[0]];
+    }
+    return frames;
+}
+
+static int decode_g711(const Decoder &decoder, const uint8_t *in, int frames, uint16_t *out)
+{
+    const uint16_t *table = decoder.table;
+    int channels = decoder.channels;
+    int align = decoder.align;
+    for (int i = 0; i < frames; i++, in += align)
+    {
+        int sum = 0;
+        for (int c = 0; c < channels; c++)
+        {
+            sum += table[in[c]] - 32768;
+        }
+        out[i] = (uint16_t)(sum / channels + 32768);
+    }
+    return frames;
+}
+
+static bool probe_g711(const FMT_STRUCT &format)
+{
+    return format.sig_bps == 8 && format.block_align >= format.num_channels;
+}
+
+static void open_mulaw(const FMT_STRUCT &format, Decoder *decoder)
+{
+    decoder->table = g711MuLawTable;
+    decoder->decode = format.num_channels == 1 ? decode_g711_mono : decode_g711;
+}
+
+static void open_alaw(const FMT_STRUCT &format, Decoder *decoder)
+{
+    decoder->table = g711ALawTable;
+    decoder->decode = format.num_channels == 1 ? decode_g711_mono : decode_g711;
+}
+
+static uint32_t seek_g711(const Decoder &decoder, uint32_t sample)
+{
+    return sample * decoder.align;
+}
+
+extern const Codec muLawCodec =
+{
+    "mu-law", WAVE_FORMAT_MULAW, ".wav", MAGIC_RIFF, probe_g711, open_mulaw, seek_g711
+};
+
+extern const Codec aLawCodec =
+{
+    "a-law", WAVE_FORMAT_ALAW, ".wav", MAGIC_RIFF, probe_g711, open_alaw, seek_g711
+};
+
+#endif
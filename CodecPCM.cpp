@@ -0,0 +1,103 @@
+/**
+ * @file CodecPCM.cpp
+ * @brief Linear PCM codec: 8 bit unsigned, 16 & 32 bit signed
+**/
+#include "Codec.h"
+
+#if CODEC_PCM
+
+/**
+ * @brief 8 bit wave data is unsigned
+**/
+static int decode_pcm8(const Decoder &decoder, const uint8_t *in, int frames, uint16_t *out)
+{
+    int channels = decoder.channels;
+    int align = decoder.align;
+    for (int i = 0; i < frames; i++, in += align)
+    {
+        int sum = 0;
+        for (int c = 0; c < channels; c++)
+        {
+            sum += in[c];
+        }
+        out[i] = (uint16_t)((sum / channels) << 8);
+    }
+    return frames;
+}
+
+static int decode_pcm16_mono(const Decoder &decoder, const uint8_t *in, int frames, uint16_t *out)
+{
+    int align = decoder.align;
+    for (int i = 0; i < frames; i++, in += align)
+    {
+        out[i] = (uint16_t)((short)(in[0] | (in[1] << 8)) + 32768);
+    }
+    return frames;
+}
+
+static int decode_pcm16(const Decoder &decoder, const uint8_t *in, int frames, uint16_t *out)
+{
+    int channels = decoder.channels;
+    int align = decoder.align;
+    for (int i = 0; i < frames; i++, in += align)
+    {
+        int sum = 0;
+        for (int c = 0; c < channels; c++)
+        {
+            sum += (short)(in[2 * c] | (in[2 * c + 1] << 8));
+        }
+        out[i] = (uint16_t)(sum / channels + 32768);
+    }
+    return frames;
+}
+
+static int decode_pcm32(const Decoder &decoder, const uint8_t *in, int frames, uint16_t *out)
+{
+    int channels = decoder.channels;
+    int align = decoder.align;
+    for (int i = 0; i < frames; i++, in += align)
+    {
+        long long sum = 0;
+        for (int c = 0; c < channels; c++)
+        {
+            const uint8_t *s = in + 4 * c;
+            sum += (int)(s[0] | (s[1] << 8) | (s[2] << 16) | ((uint32_t)s[3] << 24));
+        }
+        out[i] = (uint16_t)(((sum / channels) >> 16) + 32768);
+    }
+    return frames;
+}
+
+static bool probe_pcm(const FMT_STRUCT &format)
+{
+    return (format.sig_bps == 8 || format.sig_bps == 16 || format.sig_bps == 32) &&
+           format.block_align >= format.num_channels * format.sig_bps / 8;
+}
+
+static void open_pcm(const FMT_STRUCT &format, Decoder *decoder)
+{
+    switch (format.sig_bps)
+    {
+        case 8:
+            decoder->decode = decode_pcm8;
+            break;
+        case 16:
+            decoder->decode = format.num_channels == 1 ? decode_pcm16_mono : decode_pcm16;
+            break;
+        default:
+            decoder->decode = decode_pcm32;
+            break;
+    }
+}
+
+static uint32_t seek_pcm(const Decoder &decoder, uint32_t sample)
+{
+    return sample * decoder.align;
+}
+
+extern const Codec pcmCodec =
+{
+    "pcm", WAVE_FORMAT_PCM, ".wav .wave", MAGIC_RIFF, probe_pcm, open_pcm, seek_pcm
+};
+
+#endif
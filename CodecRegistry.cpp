@@ -0,0 +1,106 @@
+/**
+ * @file CodecRegistry.cpp
+ * @brief Registry of the codecs compiled into the build
+**/
+#include "Codec.h"
+#include <ctype.h>
+#include <string.h>
+
+#if CODEC_PCM
+extern const Codec pcmCodec;
+#endif
+#if CODEC_G711
+extern const Codec muLawCodec;
+extern const Codec aLawCodec;
+#endif
+
+// Codecs in the build, in order of preference; fixed at compile time
+static const Codec *const codecRegistry[] =
+{
+#if CODEC_PCM
+    &pcmCodec,
+#endif
+#if CODEC_G711
+    &muLawCodec,
+    &aLawCodec,
+#endif
+    NULL
+};
+
+const Codec *codec_for_format(const FMT_STRUCT &format)
+{
+    for (const Codec *const *codec = codecRegistry; *codec != NULL; codec++)
+    {
+        if ((*codec)->comp_code == format.comp_code && (*codec)->probe(format))
+        {
+            return *codec;
+        }
+    }
+    return NULL;
+}
+
+const Codec *codec_for_name(const char *name)
+{
+    const char *dot = strrchr(name, '.');
+    if (dot == NULL)
+    {
+        return NULL;
+    }
+    int len = strlen(dot);
+    for (const Codec *const *codec = codecRegistry; *codec != NULL; codec++)
+    {
+        // Match the extension against each space-separated entry of the list
+        const char *ext = (*codec)->extensions;
+        while (*ext)
+        {
+            int n = 0;
+            while (ext[n] && ext[n] != ' ')
+            {
+                n++;
+            }
+            int i = 0;
+            while (i < n && i < len && tolower((uint8_t)dot[i]) == ext[i])
+            {
+                i++;
+            }
+            if (i == n && n == len)
+            {
+                return *codec;
+            }
+            ext += ext[n] ? n + 1 : n;
+        }
+    }
+    return NULL;
+}
+
+const Codec *codec_for_magic(uint32_t magic)
+{
+    for (const Codec *const *codec = codecRegistry; *codec != NULL; codec++)
+    {
+        if ((*codec)->magic == magic)
+        {
+            return *codec;
+        }
+    }
+    return NULL;
+}
+
+bool open_decoder(const FMT_STRUCT &format, Decoder *decoder)
+{
+    if (format.num_channels <= 0 || format.sample_rate == 0 || format.block_align <= 0 ||
+        format.block_align > CODEC_MAX_ALIGN)
+    {
+        return false;
+    }
+    const Codec *codec = codec_for_format(format);
+    if (codec == NULL)
+    {
+        return false;
+    }
+    decoder->codec = codec;
+    decoder->table = NULL;
+    decoder->channels = format.num_channels;
+    decoder->align = format.block_align;
+    codec->open(format, decoder);
+    return true;
+}
@@ -0,0 +1,350 @@
+/**
+ * @file Compositor.cpp
+ * @brief Shadow framebuffer of the uLCD that uploads only the tiles that changed
+**/
+#include "Compositor.h"
+#include <string.h>
+
+// Rows of the framebuffer held in each 16 KB AHB SRAM bank
+#define BANK_ROWS (COMPOSITOR_HEIGHT / 2)
+
+static uint16_t frameTop[BANK_ROWS][COMPOSITOR_WIDTH] __attribute__((section("AHBSRAM0")));
+static uint16_t frameBottom[BANK_ROWS][COMPOSITOR_WIDTH] __attribute__((section("AHBSRAM1")));
+
+static uint16_t to_rgb565(int color)
+{
+    return ((color >> 8) & 0xF800) | ((color >> 5) & 0x07E0) | ((color >> 3) & 0x001F);
+}
+
+/**
+ * @brief Widens RGB565 to the uLCD's 24-bit format; the driver narrows it back losslessly
+**/
+static int to_rgb888(uint16_t color)
+{
+    return ((color & 0xF800) << 8) | ((color & 0x07E0) << 5) | ((color & 0x001F) << 3);
+}
+
+Compositor::Compositor(uLCD_4DGL *lcd)
+{
+    this->lcd = lcd;
+    next_tile = 0;
+    memset(&frame_stats, 0, sizeof(frame_stats));
+    memset(tiles, 0, sizeof(tiles));
+}
+
+uint16_t *Compositor::row(int y)
+{
+    return y < BANK_ROWS ? frameTop[y] : frameBottom[y - BANK_ROWS];
+}
+
+/**
+ * @brief Grows the dirty boxes of the tiles a clipped rectangle touches
+**/
+void Compositor::mark(int x, int y, int w, int h)
+{
+    int x_end = x + w - 1;
+    int y_end = y + h - 1;
+    for (int ty = y / COMPOSITOR_TILE; ty <= y_end / COMPOSITOR_TILE; ty++)
+    {
+        for (int tx = x / COMPOSITOR_TILE; tx <= x_end / COMPOSITOR_TILE; tx++)
+        {
+            TileState &tile = tiles[ty * COMPOSITOR_TILES_X + tx];
+            int left = tx * COMPOSITOR_TILE;
+            int top = ty * COMPOSITOR_TILE;
+            int x0 = (x > left ? x : left) - left;
+            int y0 = (y > top ? y : top) - top;
+            int x1 = (x_end < left + COMPOSITOR_TILE - 1 ? x_end : left + COMPOSITOR_TILE - 1) - left;
+            int y1 = (y_end < top + COMPOSITOR_TILE - 1 ? y_end : top + COMPOSITOR_TILE - 1) - top;
+            if (!tile.dirty)
+            {
+                tile.dirty = true;
+                tile.x0 = x0;
+                tile.y0 = y0;
+                tile.x1 = x1;
+                tile.y1 = y1;
+                continue;
+            }
+            if (x0 < tile.x0)
+            {
+                tile.x0 = x0;
+            }
+            if (y0 < tile.y0)
+            {
+                tile.y0 = y0;
+            }
+            if (x1 > tile.x1)
+            {
+                tile.x1 = x1;
+            }
+            if (y1 > tile.y1)
+            {
+                tile.y1 = y1;
+            }
+        }
+    }
+}
+
+void Compositor::reset(int color)
+{
+    uint16_t pixel = to_rgb565(color);
+    for (int y = 0; y < COMPOSITOR_HEIGHT; y++)
+    {
+        uint16_t *p = row(y);
+        for (int x = 0; x < COMPOSITOR_WIDTH; x++)
+        {
+            p[x] = pixel;
+        }
+    }
+    for (int i = 0; i < COMPOSITOR_TILES; i++)
+    {
+        tiles[i].dirty = false;
+        tiles[i].hash = hash_tile(i);
+    }
+    next_tile = 0;
+}
+
+void Compositor::fill(int x, int y, int w, int h, int color)
+{
+    if (x < 0)
+    {
+        w += x;
+        x = 0;
+    }
+    if (y < 0)
+    {
+        h += y;
+        y = 0;
+    }
+    if (x + w > COMPOSITOR_WIDTH)
+    {
+        w = COMPOSITOR_WIDTH - x;
+    }
+    if (y + h > COMPOSITOR_HEIGHT)
+    {
+        h = COMPOSITOR_HEIGHT - y;
+    }
+    if (w <= 0 || h <= 0)
+    {
+        return;
+    }
+    uint16_t pixel = to_rgb565(color);
+    for (int j = 0; j < h; j++)
+    {
+        uint16_t *p = row(y + j) + x;
+        for (int i = 0; i < w; i++)
+        {
+            p[i] = pixel;
+        }
+    }
+    mark(x, y, w, h);
+}
+
+void Compositor::pixel(int x, int y, int color)
+{
+    fill(x, y, 1, 1, color);
+}
+
+void Compositor::blit(int x, int y, int w, int h, const int *colors)
+{
+    int stride = w;
+    int x0 = x < 0 ? -x : 0;
+    int y0 = y < 0 ? -y : 0;
+    int x1 = x + w > COMPOSITOR_WIDTH ? COMPOSITOR_WIDTH - x : w;
+    int y1 = y + h > COMPOSITOR_HEIGHT ? COMPOSITOR_HEIGHT - y : h;
+    if (x0 >= x1 || y0 >= y1)
+    {
+        return;
+    }
+    for (int j = y0; j < y1; j++)
+    {
+        uint16_t *p = row(y + j) + x;
+        for (int i = x0; i < x1; i++)
+        {
+            p[i] = to_rgb565(colors[j * stride + i]);
+        }
+    }
+    mark(x + x0, y + y0, x1 - x0, y1 - y0);
+}
+
+/**
+ * @brief FNV-1a hash of the pixels of a tile
+**/
+uint32_t Compositor::hash_tile(int tile)
+{
+    int left = (tile % COMPOSITOR_TILES_X) * COMPOSITOR_TILE;
+    int top = (tile / COMPOSITOR_TILES_X) * COMPOSITOR_TILE;
+    uint32_t hash = 2166136261u;
+    for (int j = 0; j < COMPOSITOR_TILE; j++)
+    {
+        const uint16_t *p = row(top + j) + left;
+        for (int i = 0; i < COMPOSITOR_TILE; i++)
+        {
+            hash = (hash ^ p[i]) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+/**
+ * @brief Covers the dirty box of a tile with rectangles of one colour
+ * @details Each row of the box is split into runs; a run with the same extent & colour as a run on
+ * the row above extends that rectangle downwards, so flat areas & vertical bars collapse to a few
+ * rectangles.
+ * @param limit Stop counting once more rectangles than this are needed; ignored when emitting
+ * @param emit Send the rectangles rather than only count them
+ * @return Number of rectangles
+**/
+int Compositor::send_runs(int tile, int limit, bool emit)
+{
+    const TileState &state = tiles[tile];
+    int left = (tile % COMPOSITOR_TILES_X) * COMPOSITOR_TILE;
+    int top = (tile / COMPOSITOR_TILES_X) * COMPOSITOR_TILE;
+    // Rectangles still growing down from the previous row, left to right
+    uint8_t open_x0[COMPOSITOR_TILE], open_x1[COMPOSITOR_TILE], open_y0[COMPOSITOR_TILE];
+    uint16_t open_color[COMPOSITOR_TILE];
+    int open_count = 0;
+    int count = 0;
+
+    for (int y = state.y0; y <= state.y1 + 1; y++)
+    {
+        // Runs of this row; the row past the box has none, which closes every open rectangle
+        uint8_t run_x0[COMPOSITOR_TILE], run_x1[COMPOSITOR_TILE];
+        uint16_t run_color[COMPOSITOR_TILE];
+        int run_count = 0;
+        if (y <= state.y1)
+        {
+            const uint16_t *p = row(top + y) + left;
+            for (int x = state.x0; x <= state.x1; x++)
+            {
+                if (run_count > 0 && p[x] == run_color[run_count - 1])
+                {
+                    run_x1[run_count - 1] = x;
+                    continue;
+                }
+                run_x0[run_count] = x;
+                run_x1[run_count] = x;
+                run_color[run_count] = p[x];
+                run_count++;
+            }
+        }
+
+        uint8_t run_y0[COMPOSITOR_TILE];
+        for (int r = 0; r < run_count; r++)
+        {
+            run_y0[r] = y;
+        }
+        for (int o = 0; o < open_count; o++)
+        {
+            int r = 0;
+            while (r < run_count && run_x0[r] < open_x0[o])
+            {
+                r++;
+            }
+            if (r < run_count && run_x0[r] == open_x0[o] && run_x1[r] == open_x1[o] && run_color[r] == open_color[o])
+            {
+                run_y0[r] = open_y0[o];
+                continue;
+            }
+            count++;
+            if (emit)
+            {
+                lcd->filled_rectangle(left + open_x0[o], top + open_y0[o], left + open_x1[o], top + y - 1,
+                                      to_rgb888(open_color[o]));
+            }
+            else if (count > limit)
+            {
+                return count;
+            }
+        }
+        memcpy(open_x0, run_x0, run_count);
+        memcpy(open_x1, run_x1, run_count);
+        memcpy(open_y0, run_y0, run_count);
+        memcpy(open_color, run_color, run_count * sizeof(uint16_t));
+        open_count = run_count;
+    }
+    return count;
+}
+
+/**
+ * @brief Sends the dirty box of a tile as one BLIT
+**/
+void Compositor::send_blit(int tile)
+{
+    const TileState &state = tiles[tile];
+    int left = (tile % COMPOSITOR_TILES_X) * COMPOSITOR_TILE;
+    int top = (tile / COMPOSITOR_TILES_X) * COMPOSITOR_TILE;
+    int w = state.x1 - state.x0 + 1;
+    int h = state.y1 - state.y0 + 1;
+    for (int j = 0; j < h; j++)
+    {
+        const uint16_t *p = row(top + state.y0 + j) + left + state.x0;
+        for (int i = 0; i < w; i++)
+        {
+            colors[j * w + i] = to_rgb888(p[i]);
+        }
+    }
+    lcd->BLIT(left + state.x0, top + state.y0, w, h, colors);
+}
+
+uint32_t Compositor::present(uint32_t budget)
+{
+    uint32_t sent = 0;
+    int start = next_tile;
+    for (int n = 0; n < COMPOSITOR_TILES; n++)
+    {
+        int index = (start + n) % COMPOSITOR_TILES;
+        TileState &tile = tiles[index];
+        if (!tile.dirty)
+        {
+            continue;
+        }
+        uint32_t hash = hash_tile(index);
+        if (hash == tile.hash)
+        {
+            // Redrawn with what the screen already shows
+            tile.dirty = false;
+            frame_stats.tiles_unchanged++;
+            continue;
+        }
+
+        // Cost the box both ways
+        uint32_t blit_bytes = COMPOSITOR_BLIT_BYTES + 2 * (tile.x1 - tile.x0 + 1) * (tile.y1 - tile.y0 + 1);
+        int limit = blit_bytes / COMPOSITOR_RECT_BYTES;
+        int rects = send_runs(index, limit, false);
+        uint32_t bytes = rects <= limit ? rects * COMPOSITOR_RECT_BYTES : blit_bytes;
+        if (sent > 0 && sent + bytes > budget)
+        {
+            // Leave the rest for the next frame, starting from this tile
+            next_tile = index;
+            for (int m = n; m < COMPOSITOR_TILES; m++)
+            {
+                if (tiles[(start + m) % COMPOSITOR_TILES].dirty)
+                {
+                    frame_stats.tiles_deferred++;
+                }
+            }
+            break;
+        }
+        if (rects <= limit)
+        {
+            send_runs(index, limit, true);
+        }
+        else
+        {
+            send_blit(index);
+        }
+        sent += bytes;
+        tile.hash = hash;
+        tile.dirty = false;
+        frame_stats.tiles_sent++;
+    }
+
+    frame_stats.frames++;
+    frame_stats.last_bytes = sent;
+    frame_stats.total_bytes += sent;
+    if (sent > frame_stats.max_bytes)
+    {
+        frame_stats.max_bytes = sent;
+    }
+    return sent;
+}
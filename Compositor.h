@@ -0,0 +1,109 @@
+/**
+ * @file Compositor.h
+ * @brief Shadow framebuffer of the uLCD that uploads only the tiles that changed
+ * @details Drawing goes into a 128x128 RGB565 copy of the screen held in the two AHB SRAM banks,
+ * which the music player does not otherwise use. The screen is split into 16x16 tiles; each keeps the
+ * bounding box of what was drawn into it & a hash of its content as last uploaded. present() skips
+ * tiles whose hash has not changed and sends each dirty box as whichever is fewer bytes: a BLIT of its
+ * pixels, or its runs of one colour as filled_rectangle commands. Text drawn straight to the uLCD is
+ * left alone as long as the compositor does not draw over it.
+**/
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include "mbed.h"
+#include "uLCD_4DGL.h"
+
+#define COMPOSITOR_WIDTH 128
+#define COMPOSITOR_HEIGHT 128
+// Tile edge in pixels; a power of two that divides the height of each SRAM bank
+#define COMPOSITOR_TILE 16
+#define COMPOSITOR_TILES_X (COMPOSITOR_WIDTH / COMPOSITOR_TILE)
+#define COMPOSITOR_TILES (COMPOSITOR_TILES_X * (COMPOSITOR_HEIGHT / COMPOSITOR_TILE))
+// Bytes present() may send per frame; about 3 ms of the uLCD UART at 3 Mbaud
+#define COMPOSITOR_FRAME_BUDGET 1024
+// UART bytes of one filled_rectangle command, including its 0xFF prefix
+#define COMPOSITOR_RECT_BYTES 12
+// UART bytes of a BLIT command before its pixels
+#define COMPOSITOR_BLIT_BYTES 10
+
+/**
+ * @brief Upload state of one tile
+**/
+struct TileState
+{
+    uint32_t hash;          // Content hash as last uploaded
+    bool dirty;             // Drawn into since the last upload
+    uint8_t x0, y0;         // Dirty box, tile-relative & inclusive
+    uint8_t x1, y1;
+};
+
+/**
+ * @brief UART traffic of the compositor
+**/
+struct CompositorStats
+{
+    unsigned frames;            // Calls to present()
+    uint32_t last_bytes;        // Bytes sent by the last present()
+    uint32_t max_bytes;
+    uint64_t total_bytes;
+    unsigned tiles_sent;
+    unsigned tiles_unchanged;   // Dirty tiles whose content hash had not changed
+    unsigned tiles_deferred;    // Dirty tiles left for a later frame by the byte budget
+};
+
+/**
+ * @brief Dirty-tile compositor for the 128x128 uLCD-144-G2
+**/
+class Compositor
+{
+public:
+    /**
+     * @brief Creates a compositor for a screen; call reset() once the screen has been cleared
+    **/
+    Compositor(uLCD_4DGL *lcd);
+
+    /**
+     * @brief Records that the screen has just been cleared to one colour
+     * @param color 24-bit RGB colour, as for uLCD_4DGL
+    **/
+    void reset(int color);
+
+    /**
+     * @brief Fills a rectangle of the shadow framebuffer, clipped to the screen
+    **/
+    void fill(int x, int y, int w, int h, int color);
+
+    void pixel(int x, int y, int color);
+
+    /**
+     * @brief Copies a block of 24-bit RGB pixels into the shadow framebuffer, clipped to the screen
+    **/
+    void blit(int x, int y, int w, int h, const int *colors);
+
+    /**
+     * @brief Uploads the dirty tiles, oldest first, within a byte budget
+     * @details The first changed tile of a frame is always sent so a budget smaller than one tile
+     * still makes progress. Tiles over the budget stay dirty & lead the next frame.
+     * @param budget Largest number of UART bytes to send
+     * @return Bytes sent
+    **/
+    uint32_t present(uint32_t budget);
+
+    const CompositorStats &stats() const { return frame_stats; }
+
+private:
+    uint16_t *row(int y);
+    void mark(int x, int y, int w, int h);
+    uint32_t hash_tile(int tile);
+    int send_runs(int tile, int limit, bool emit);
+    void send_blit(int tile);
+
+    uLCD_4DGL *lcd;
+    TileState tiles[COMPOSITOR_TILES];
+    int next_tile;                                      // Tile present() starts from
+    CompositorStats frame_stats;
+    int colors[COMPOSITOR_TILE * COMPOSITOR_TILE];      // BLIT pixels in the uLCD's 24-bit format
+};
+
+#endif
@@ -0,0 +1,734 @@
+/**
+ * @file ContentChain.cpp
+ * @brief Copies the library from one player to others linked in a ring over UART3
+**/
+#include "ContentChain.h"
+#include <string.h>
+
+// FatFs work areas, kept off the thread stacks; guarded by sdMutex
+static FIL chainFile;
+static FATFS_DIR chainDir;
+static FILINFO chainInfo;
+static char chainName[_MAX_LFN + 1];
+static char chainPath[_MAX_LFN + 64];
+// Journal sector being written, kept off the thread stacks
+static uint8_t journalSector[SECTOR_SIZE];
+
+/**
+ * @brief Adler-32 of a block, continued from an earlier value; start from 1
+**/
+static uint32_t adler32(uint32_t adler, const uint8_t *data, uint32_t length)
+{
+    uint32_t a = adler & 0xFFFF;
+    uint32_t b = adler >> 16;
+    while (length > 0)
+    {
+        // 5552 bytes is the most that can be summed before b could overflow
+        uint32_t n = length < 5552 ? length : 5552;
+        length -= n;
+        while (n-- > 0)
+        {
+            a += *data++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return (b << 16) | a;
+}
+
+/**
+ * @brief Checksum of a journal record
+**/
+static uint32_t journal_check(const ChainJournal &journal)
+{
+    return journal.magic + journal.entry.size + journal.entry.signature + journal.committed +
+           adler32(1, (const uint8_t *)journal.entry.name, CHAIN_NAME_LEN);
+}
+
+/**
+ * @brief true if two entries describe the same version of the same file
+**/
+static bool same_entry(const ChainEntry &a, const ChainEntry &b)
+{
+    return a.size == b.size && a.signature == b.signature && strncmp(a.name, b.name, CHAIN_NAME_LEN) == 0;
+}
+
+ContentChain::ContentChain(SDCard *card, const char *dir) : serial(CHAIN_TX, CHAIN_RX)
+{
+    this->card = card;
+    this->dir = dir;
+    rx_head = 0;
+    rx_tail = 0;
+    memset(&header, 0, sizeof(header));
+    receiving = false;
+    current_file = 0;
+    memset(&state, 0, sizeof(state));
+    batch_count = 0;
+    batches_unjournalled = 0;
+    changed = false;
+    memset(&chain_stats, 0, sizeof(chain_stats));
+}
+
+/**
+ * @details The journal file is made on the first start & never moves after, so it is rewritten in
+ * place through its sector.
+**/
+void ContentChain::start()
+{
+    serial.baud(CHAIN_BAUD);
+    serial.attach(this, &ContentChain::rx_isr);
+
+    if (!journal.open(card, CHAIN_JOURNAL_NAME))
+    {
+        sdMutex.lock();
+        snprintf(chainPath, sizeof(chainPath), "%d:/%s", card->_fsid, CHAIN_JOURNAL_NAME);
+        if (f_open(&chainFile, chainPath, FA_CREATE_ALWAYS | FA_WRITE) == FR_OK)
+        {
+            f_lseek(&chainFile, SECTOR_SIZE);
+            f_close(&chainFile);
+        }
+        invalidate_fat_cache();
+        sdMutex.unlock();
+        journal.open(card, CHAIN_JOURNAL_NAME);
+    }
+    if (journal.read_sector(0, journalSector))
+    {
+        memcpy(&state, journalSector, sizeof(state));
+    }
+    if (state.magic != CHAIN_JOURNAL_MAGIC || state.check != journal_check(state))
+    {
+        memset(&state, 0, sizeof(state));
+    }
+}
+
+/**
+ * @brief Moves every byte the UART holds into the RX buffer
+**/
+void ContentChain::rx_isr()
+{
+    while (serial.readable())
+    {
+        uint8_t c = serial.getc();
+        if (rx_head - rx_tail < CHAIN_RX_BUFFER)
+        {
+            rx[rx_head & (CHAIN_RX_BUFFER - 1)] = c;
+            rx_head++;
+        }
+        else
+        {
+            chain_stats.overruns++;
+        }
+    }
+}
+
+/**
+ * @brief Takes one byte from the RX buffer; there must be one
+**/
+uint8_t ContentChain::take()
+{
+    uint8_t c = rx[rx_tail & (CHAIN_RX_BUFFER - 1)];
+    rx_tail++;
+    return c;
+}
+
+/**
+ * @brief Reads the next good frame into header & payload, skipping anything that is not one
+ * @param timeout_ms Time to wait for the frame to start; once it has, the rest has CHAIN_FRAME_MS
+ * @return false if no good frame arrived in time
+**/
+bool ContentChain::read_frame(uint32_t timeout_ms)
+{
+    Timer timer;
+    timer.start();
+    uint8_t *raw = (uint8_t *)&header;
+    uint32_t have = 0;
+    uint32_t need = sizeof(header);
+    while (true)
+    {
+        if (available() == 0)
+        {
+            if ((uint32_t)timer.read_ms() >= (have ? CHAIN_FRAME_MS : timeout_ms))
+            {
+                if (have)
+                {
+                    chain_stats.bad_frames++;
+                }
+                return false;
+            }
+            Thread::wait(1);
+            continue;
+        }
+        uint8_t c = take();
+        if ((have == 0 && c != CHAIN_SYNC0) || (have == 1 && c != CHAIN_SYNC1))
+        {
+            // Hunt for the start of a frame; a lone first sync byte may begin one
+            have = (c == CHAIN_SYNC0) ? 1 : 0;
+            raw[0] = c;
+            continue;
+        }
+        if (have < sizeof(header))
+        {
+            raw[have++] = c;
+            if (have == sizeof(header))
+            {
+                if (header.length > SECTOR_SIZE)
+                {
+                    chain_stats.bad_frames++;
+                    have = 0;
+                    continue;
+                }
+                need = sizeof(header) + header.length;
+                timer.reset();
+            }
+        }
+        else
+        {
+            payload[have++ - sizeof(header)] = c;
+        }
+        if (have >= sizeof(header) && have == need)
+        {
+            uint32_t check = header.check;
+            header.check = 0;
+            uint32_t sum = adler32(adler32(1, raw, sizeof(header)), payload, header.length);
+            header.check = check;
+            if (sum == check && header.hops < CHAIN_MAX_HOPS)
+            {
+                chain_stats.frames_in++;
+                return true;
+            }
+            chain_stats.bad_frames++;
+            have = 0;
+            need = sizeof(header);
+            timer.reset();
+        }
+    }
+}
+
+/**
+ * @brief Fills in the sync bytes, length & check of a frame & sends it to the next unit
+**/
+void ContentChain::send_frame(ChainHeader *h, const uint8_t *data)
+{
+    h->sync0 = CHAIN_SYNC0;
+    h->sync1 = CHAIN_SYNC1;
+    h->check = 0;
+    h->check = adler32(adler32(1, (const uint8_t *)h, sizeof(*h)), data, h->length);
+    const uint8_t *raw = (const uint8_t *)h;
+    for (uint32_t i = 0; i < sizeof(*h); i++)
+    {
+        serial.putc(raw[i]);
+    }
+    for (uint32_t i = 0; i < h->length; i++)
+    {
+        serial.putc(data[i]);
+    }
+    chain_stats.frames_out++;
+}
+
+/**
+ * @brief Sends a control frame & waits for it to come back round the ring, sending it again if lost
+ * @return true with the frame, as the other units left it, in header & payload
+**/
+bool ContentChain::exchange(ChainHeader *h, const uint8_t *data)
+{
+    for (int attempt = 0; attempt < CHAIN_RETRIES; attempt++)
+    {
+        h->hops = 0;
+        send_frame(h, data);
+        while (read_frame(CHAIN_TIMEOUT_MS))
+        {
+            // Data frames still going round from before are let through
+            if (header.type == h->type && header.file == h->file)
+            {
+                chain_stats.units = header.hops + 1;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Adler-32 of the first sector & of the bytes of the last sector within the file
+ * @param name Path from the root of the card
+ * @return false if the file could not be read
+**/
+bool ContentChain::signature(const char *name, uint32_t size, uint32_t *sig)
+{
+    TrackStream stream;
+    if (!stream.open(card, name) || stream.file_size != size)
+    {
+        return false;
+    }
+    uint32_t last = (size - 1) / SECTOR_SIZE;
+    uint32_t sum = 1;
+    if (!stream.read_sector(0, journalSector))
+    {
+        return false;
+    }
+    sum = adler32(sum, journalSector, last == 0 ? size : SECTOR_SIZE);
+    if (last > 0)
+    {
+        if (!stream.read_sector(last, journalSector))
+        {
+            return false;
+        }
+        sum = adler32(sum, journalSector, size - last * SECTOR_SIZE);
+    }
+    *sig = sum;
+    return true;
+}
+
+/**
+ * @brief true if the card lacks the file or holds a different version of it
+**/
+bool ContentChain::needs(const ChainEntry &entry)
+{
+    char name[CHAIN_NAME_LEN + 1];
+    strncpy(name, entry.name, CHAIN_NAME_LEN);
+    name[CHAIN_NAME_LEN] = 0;
+    uint32_t sig;
+    return !signature(name, entry.size, &sig) || sig != entry.signature;
+}
+
+/**
+ * @brief Gets ready to receive a file into the temporary file, resuming a copy cut short if the
+ * journal holds one of the same file
+**/
+void ContentChain::begin_file(const ChainEntry &entry)
+{
+    current_file = header.file;
+    batch_count = 0;
+    if (receiving && same_entry(state.entry, entry))
+    {
+        // Another round of the file being received; it starts at or before what is written
+        return;
+    }
+    temp.close();
+    receiving = false;
+    if (state.magic == CHAIN_JOURNAL_MAGIC && same_entry(state.entry, entry) &&
+        temp.open(card, CHAIN_TEMP_NAME) && temp.file_size == entry.size)
+    {
+        receiving = true;
+        return;
+    }
+
+    // Journal the new file first, so a reset while the temporary file is remade never resumes into it
+    memset(&state, 0, sizeof(state));
+    state.magic = CHAIN_JOURNAL_MAGIC;
+    state.entry = entry;
+    state.entry.needed = 0;
+    save_journal();
+    bool ok = false;
+    sdMutex.lock();
+    snprintf(chainPath, sizeof(chainPath), "%d:/%s", card->_fsid, CHAIN_TEMP_NAME);
+    if (f_open(&chainFile, chainPath, FA_CREATE_ALWAYS | FA_WRITE) == FR_OK)
+    {
+        // Allocate the whole file now, so the data is written by sector without touching the FAT
+        ok = f_lseek(&chainFile, entry.size) == FR_OK && chainFile.fptr == entry.size;
+        ok = f_close(&chainFile) == FR_OK && ok;
+    }
+    invalidate_fat_cache();
+    sdMutex.unlock();
+    receiving = ok && temp.open(card, CHAIN_TEMP_NAME);
+}
+
+/**
+ * @brief Adds a sector to the batch if it is the next one the file needs
+**/
+void ContentChain::store(uint32_t sector, const uint8_t *data)
+{
+    if (sector != state.committed + batch_count)
+    {
+        return;
+    }
+    memcpy(batch + batch_count * SECTOR_SIZE, data, SECTOR_SIZE);
+    batch_count++;
+    if (batch_count == CHAIN_BATCH_SECTORS || state.committed + batch_count == sectors())
+    {
+        flush_batch();
+    }
+}
+
+/**
+ * @brief Writes the batch to the temporary file, one multi-block write per run of contiguous sectors
+ * @details Sectors written before a failure still count; the rest are sent again in the next round.
+ * @return false on card error
+**/
+bool ContentChain::flush_batch()
+{
+    uint32_t done = 0;
+    bool ok = true;
+    while (done < batch_count && ok)
+    {
+        uint32_t disk_sector;
+        uint32_t count = temp.run(state.committed + done, &disk_sector);
+        if (count > batch_count - done)
+        {
+            count = batch_count - done;
+        }
+        sdMutex.lock();
+        ok = count > 0 && card->disk_write_blocks(batch + done * SECTOR_SIZE, disk_sector, count) == 0;
+        sdMutex.unlock();
+        if (ok)
+        {
+            done += count;
+        }
+    }
+    state.committed += done;
+    batch_count = 0;
+    if (++batches_unjournalled >= CHAIN_JOURNAL_BATCHES)
+    {
+        save_journal();
+    }
+    return ok;
+}
+
+/**
+ * @brief Writes the state to the journal sector
+**/
+void ContentChain::save_journal()
+{
+    state.check = journal_check(state);
+    memset(journalSector, 0, sizeof(journalSector));
+    memcpy(journalSector, &state, sizeof(state));
+    journal.write_sector(0, journalSector);
+    batches_unjournalled = 0;
+}
+
+/**
+ * @brief Puts the whole temporary file in place of the file it is a copy of & clears the journal
+**/
+void ContentChain::end_file()
+{
+    char name[CHAIN_NAME_LEN + 1];
+    strncpy(name, state.entry.name, CHAIN_NAME_LEN);
+    name[CHAIN_NAME_LEN] = 0;
+    receiving = false;
+    temp.close();
+    sdMutex.lock();
+    // Make the directories on the way, then replace any older version
+    snprintf(chainPath, sizeof(chainPath), "%d:/%s", card->_fsid, name);
+    for (char *p = strchr(chainPath + 3, '/'); p != NULL; p = strchr(p + 1, '/'))
+    {
+        *p = 0;
+        f_mkdir(chainPath);
+        *p = '/';
+    }
+    f_unlink(chainPath);
+    snprintf(chainPath, sizeof(chainPath), "%d:/%s", card->_fsid, CHAIN_TEMP_NAME);
+    // FatFs takes the new name without a drive number
+    bool ok = f_rename(chainPath, name) == FR_OK;
+    invalidate_fat_cache();
+    sdMutex.unlock();
+    memset(&state, 0, sizeof(state));
+    save_journal();
+    if (ok)
+    {
+        chain_stats.files_received++;
+        changed = true;
+    }
+}
+
+/**
+ * @brief Fills in a received frame, forwards it, then acts on it
+**/
+void ContentChain::handle_frame()
+{
+    header.hops++;
+    switch (header.type)
+    {
+    case CHAIN_ANNOUNCE:
+    {
+        ChainEntry *entries = (ChainEntry *)payload;
+        for (uint32_t i = 0; i < header.length / sizeof(ChainEntry); i++)
+        {
+            if (!entries[i].needed && needs(entries[i]))
+            {
+                entries[i].needed = 1;
+            }
+        }
+        send_frame(&header, payload);
+        break;
+    }
+    case CHAIN_BEGIN:
+    {
+        ChainEntry entry;
+        memcpy(&entry, payload, sizeof(entry));
+        if (needs(entry))
+        {
+            begin_file(entry);
+            if (receiving && state.committed < header.sector)
+            {
+                header.sector = state.committed;
+            }
+        }
+        else if (receiving && header.file == current_file)
+        {
+            receiving = false;
+        }
+        send_frame(&header, payload);
+        break;
+    }
+    case CHAIN_DATA:
+        send_frame(&header, payload);
+        if (receiving && header.file == current_file)
+        {
+            store(header.sector, payload);
+        }
+        break;
+    case CHAIN_END:
+    {
+        bool whole = false;
+        if (receiving && header.file == current_file)
+        {
+            if (batch_count > 0)
+            {
+                flush_batch();
+            }
+            save_journal();
+            if (state.committed < header.sector)
+            {
+                header.sector = state.committed;
+            }
+            whole = state.committed >= sectors();
+        }
+        send_frame(&header, payload);
+        if (whole)
+        {
+            end_file();
+        }
+        break;
+    }
+    case CHAIN_DONE:
+        send_frame(&header, payload);
+        if (changed)
+        {
+            // Let the frame leave, then start again to index the new files
+            Thread::wait(100);
+            NVIC_SystemReset();
+        }
+        break;
+    default:
+        send_frame(&header, payload);
+        break;
+    }
+}
+
+void ContentChain::poll()
+{
+    while (available() > 0 && read_frame(CHAIN_FRAME_MS))
+    {
+        handle_frame();
+    }
+}
+
+/**
+ * @brief Lists files of the library from one onwards: the playlist in the root, if there is one, then
+ * the files of the library directory in directory order
+ * @param first Number of the first file to list
+ * @param entries Filled with up to max entries, marked not needed
+ * @return Number of entries filled
+**/
+int ContentChain::scan(int first, ChainEntry *entries, int max)
+{
+    int count = 0;
+    int index = 0;
+    memset(entries, 0, max * sizeof(ChainEntry));
+    sdMutex.lock();
+    snprintf(chainPath, sizeof(chainPath), "%d:/%s", card->_fsid, CHAIN_PLAYLIST_NAME);
+    if (f_stat(chainPath, &chainInfo) == FR_OK && chainInfo.fsize > 0)
+    {
+        if (index >= first && count < max)
+        {
+            strncpy(entries[count].name, CHAIN_PLAYLIST_NAME, CHAIN_NAME_LEN);
+            entries[count++].size = chainInfo.fsize;
+        }
+        index++;
+    }
+    snprintf(chainPath, sizeof(chainPath), "%d:/%s", card->_fsid, dir);
+    if (f_opendir(&chainDir, chainPath) == FR_OK)
+    {
+        while (count < max && index < CHAIN_MAX_FILES)
+        {
+            chainName[0] = 0;
+            chainInfo.lfname = chainName;
+            chainInfo.lfsize = sizeof(chainName);
+            if (f_readdir(&chainDir, &chainInfo) != FR_OK || chainInfo.fname[0] == 0)
+            {
+                break;
+            }
+            const char *name = chainName[0] ? chainName : chainInfo.fname;
+            // Only plain, non-empty files whose path fits an entry
+            if ((chainInfo.fattrib & (AM_DIR | AM_VOL)) || chainInfo.fsize == 0 ||
+                strlen(dir) + 1 + strlen(name) >= CHAIN_NAME_LEN)
+            {
+                continue;
+            }
+            if (index >= first)
+            {
+                snprintf(entries[count].name, CHAIN_NAME_LEN, "%s/%s", dir, name);
+                entries[count++].size = chainInfo.fsize;
+            }
+            index++;
+        }
+    }
+    chainInfo.lfname = NULL;
+    sdMutex.unlock();
+    // Signatures read the files, which takes the card lock itself
+    for (int i = 0; i < count; i++)
+    {
+        signature(entries[i].name, entries[i].size, &entries[i].signature);
+    }
+    return count;
+}
+
+/**
+ * @brief Sends one file round the ring in rounds until every unit holds all of it
+ * @details Each round starts with BEGIN, which comes back lowered to the first sector some unit still
+ * lacks, sends the data from there with up to CHAIN_WINDOW frames on the ring, & ends with END, which
+ * comes back lowered to the least any unit has written. A lost frame ends the round early.
+ * @param file Number the file was announced as
+ * @return false if the ring stopped answering or stopped making progress
+**/
+bool ContentChain::send_file(int file, const ChainEntry &entry)
+{
+    TrackStream source;
+    if (!source.open(card, entry.name))
+    {
+        return false;
+    }
+    uint32_t total = (entry.size + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    uint32_t best = 0;
+    int stalls = 0;
+    ChainHeader h;
+    memset(&h, 0, sizeof(h));
+    h.file = file;
+    while (true)
+    {
+        h.type = CHAIN_BEGIN;
+        h.sector = total;
+        h.length = sizeof(entry);
+        if (!exchange(&h, (const uint8_t *)&entry))
+        {
+            return false;
+        }
+        uint32_t next = header.sector;
+        uint32_t acked = next;
+        while (acked < total)
+        {
+            while (next < total && next - acked < CHAIN_WINDOW)
+            {
+                if (!source.read_sector(next, batch))
+                {
+                    return false;
+                }
+                h.type = CHAIN_DATA;
+                h.sector = next++;
+                h.length = SECTOR_SIZE;
+                h.hops = 0;
+                send_frame(&h, batch);
+            }
+            if (!read_frame(CHAIN_TIMEOUT_MS))
+            {
+                break;
+            }
+            if (header.type == CHAIN_DATA && header.file == file)
+            {
+                if (header.sector != acked)
+                {
+                    // A unit dropped a frame, so every unit after it has stopped taking data
+                    break;
+                }
+                acked++;
+            }
+        }
+
+        h.type = CHAIN_END;
+        h.sector = total;
+        h.length = 0;
+        if (!exchange(&h, NULL))
+        {
+            return false;
+        }
+        if (header.sector >= total)
+        {
+            chain_stats.files_sent++;
+            return true;
+        }
+        if (header.sector > best)
+        {
+            best = header.sector;
+            stalls = 0;
+        }
+        else if (++stalls >= CHAIN_RETRIES)
+        {
+            return false;
+        }
+        chain_stats.resumes++;
+    }
+}
+
+/**
+ * @details The library is announced CHAIN_ENTRIES_PER_FRAME files at a time; the needed flags that come
+ * back are kept in a bitmap, then the needed files are sent one by one.
+**/
+bool ContentChain::push()
+{
+    uint8_t needed[CHAIN_MAX_FILES / 8];
+    memset(needed, 0, sizeof(needed));
+    ChainEntry entries[CHAIN_ENTRIES_PER_FRAME];
+    ChainHeader h;
+    memset(&h, 0, sizeof(h));
+    Timer timer;
+    timer.start();
+
+    int files = 0;
+    int n;
+    while ((n = scan(files, entries, CHAIN_ENTRIES_PER_FRAME)) > 0)
+    {
+        h.type = CHAIN_ANNOUNCE;
+        h.file = files;
+        h.length = n * sizeof(ChainEntry);
+        if (!exchange(&h, (const uint8_t *)entries))
+        {
+            return false;
+        }
+        ChainEntry *returned = (ChainEntry *)payload;
+        for (int i = 0; i < n; i++)
+        {
+            if (returned[i].needed)
+            {
+                needed[(files + i) / 8] |= 1 << ((files + i) % 8);
+            }
+        }
+        files += n;
+    }
+
+    bool ok = true;
+    uint32_t bytes = 0;
+    for (int i = 0; i < files; i++)
+    {
+        if ((needed[i / 8] & (1 << (i % 8))) && scan(i, entries, 1) == 1)
+        {
+            if (send_file(i, entries[0]))
+            {
+                bytes += entries[0].size;
+            }
+            else
+            {
+                ok = false;
+            }
+        }
+    }
+
+    h.type = CHAIN_DONE;
+    h.file = 0;
+    h.length = 0;
+    exchange(&h, NULL);
+    int ms = timer.read_ms();
+    chain_stats.last_bytes = bytes;
+    chain_stats.last_Bps = ms > 0 ? (uint32_t)((uint64_t)bytes * 1000 / ms) : 0;
+    return ok;
+}
@@ -0,0 +1,206 @@
+/**
+ * @file ContentChain.h
+ * @brief Copies the library from one player to others linked in a ring over UART3
+ * @details Each unit's TX goes to the next unit's RX & the last unit's TX back to the first, so every
+ * frame the sending unit puts on the ring comes back to it once all the others have passed it on.
+ * A unit checks each frame, forwards it at once & only then writes its payload, so the units copy
+ * the same file at the same time rather than one after another. Data sectors are gathered into
+ * multi-block writes of a preallocated temporary file, which is renamed into place once whole.
+ * Control frames are filled in as they go round: each unit marks the files it lacks, and lowers the
+ * count of sectors written to its own, so the sender learns what to send & where to resume without
+ * any unit having to answer it directly. A journal on each card keeps that count over
+ * a reset, so an interrupted copy resumes where the slowest unit stopped.
+ *
+ * UART3 is on p9 & p10, which the accelerometer otherwise uses, so the chain is a build option.
+ * tools/chain_sim.py runs the same protocol between host processes linked by ptys.
+**/
+#ifndef CONTENTCHAIN_H
+#define CONTENTCHAIN_H
+
+#include "mbed.h"
+#include "rtos.h"
+#include "SDCard.h"
+#include "TrackStream.h"
+
+// Build option: set to 1 to give p9 & p10 to the chain instead of the accelerometer
+#ifndef CONTENT_CHAIN
+#define CONTENT_CHAIN 0
+#endif
+
+#define CHAIN_TX p9
+#define CHAIN_RX p10
+#define CHAIN_BAUD 460800
+// First bytes of every frame
+#define CHAIN_SYNC0 0xA5
+#define CHAIN_SYNC1 0x5A
+// Received bytes buffered by the RX interrupt; a power of two holding CHAIN_WINDOW whole frames
+#define CHAIN_RX_BUFFER 2048
+// DATA frames the sender lets go round the ring before it waits for the first back
+#define CHAIN_WINDOW 3
+// Sectors gathered into one multi-block write
+#define CHAIN_BATCH_SECTORS 4
+// Multi-block writes between journal updates; a reset loses at most this much of a copy
+#define CHAIN_JOURNAL_BATCHES 8
+// Time a frame has to come back round the ring, & times a lost frame is sent again
+#define CHAIN_TIMEOUT_MS 2000
+#define CHAIN_RETRIES 5
+// Time the rest of a frame has to arrive once its first byte has
+#define CHAIN_FRAME_MS 50
+// Files of the library that can be announced
+#define CHAIN_MAX_FILES 256
+// Frames that have been round more units than this were sent by a unit no longer there & are dropped
+#define CHAIN_MAX_HOPS 32
+// Path of a file from the root of the card, e.g. "myMusic/song.wav"
+#define CHAIN_NAME_LEN 48
+#define CHAIN_ENTRIES_PER_FRAME (SECTOR_SIZE / sizeof(ChainEntry))
+// Files in the root directory of each card
+#define CHAIN_TEMP_NAME "chain.tmp"
+#define CHAIN_JOURNAL_NAME "chain.jnl"
+#define CHAIN_PLAYLIST_NAME "playlist.m3u"
+// Marks a journal of a copy in progress ("CCHN")
+#define CHAIN_JOURNAL_MAGIC 0x4E484343
+
+/**
+ * @brief Frame types
+**/
+enum ChainFrameType
+{
+    CHAIN_ANNOUNCE = 1,     // Up to CHAIN_ENTRIES_PER_FRAME entries from file number `file`; units set needed
+    CHAIN_BEGIN,            // One entry: units that need it get ready; sector is lowered to where they resume
+    CHAIN_DATA,             // One sector of the file
+    CHAIN_END,              // Units write what they hold; sector is lowered to the least any unit holds
+    CHAIN_DONE              // Units that took new files restart to index them
+};
+
+/**
+ * @brief Frame header; the payload follows
+**/
+struct ChainHeader
+{
+    uint8_t sync0;
+    uint8_t sync1;
+    uint8_t type;           // ChainFrameType
+    uint8_t hops;           // Units that have forwarded the frame
+    uint16_t file;          // File number, in the order the sender announced them
+    uint16_t length;        // Bytes of payload
+    uint32_t sector;        // DATA: sector of the file; BEGIN & END: sectors written by every unit
+    uint32_t check;         // Adler-32 of the header, with check 0, & the payload
+};
+
+/**
+ * @brief One file of the sender's library
+**/
+struct ChainEntry
+{
+    uint32_t size;
+    uint32_t signature;     // Adler-32 of the first & last sectors' bytes, to tell changed files apart
+    uint8_t needed;         // Set by any unit lacking the file
+    uint8_t reserved[3];
+    char name[CHAIN_NAME_LEN];
+};
+
+/**
+ * @brief Journal sector: the file being received & how much of it is on the card
+**/
+struct ChainJournal
+{
+    uint32_t magic;
+    ChainEntry entry;
+    uint32_t committed;     // Sectors of the temporary file written
+    uint32_t check;         // Sum of the fields above
+};
+
+/**
+ * @brief Traffic of the chain since power up
+**/
+struct ChainStats
+{
+    unsigned frames_in;
+    unsigned frames_out;
+    unsigned bad_frames;        // Failed the check, or were cut short
+    unsigned overruns;          // Bytes lost because the RX buffer was full
+    unsigned files_sent;
+    unsigned files_received;
+    unsigned resumes;           // Times a file was sent again from where the slowest unit stopped
+    uint8_t units;              // Units on the ring, counting this one, as last seen by the sender
+    uint32_t last_bytes;        // Bytes of file data in the last push, & its rate end to end
+    uint32_t last_Bps;
+};
+
+/**
+ * @brief One unit's end of the content ring
+**/
+class ContentChain
+{
+public:
+    /**
+     * @param card Card the library is on
+     * @param dir Library directory, e.g. "myMusic"
+    **/
+    ContentChain(SDCard *card, const char *dir);
+
+    /**
+     * @brief Starts receiving & loads the journal of a copy cut short; call from the chain thread
+    **/
+    void start();
+
+    /**
+     * @brief Handles, forwards & acts on every frame received so far
+    **/
+    void poll();
+
+    /**
+     * @brief Copies the library to the other units: the playlist & every file of the library
+     * directory that any unit lacks or holds a different version of
+     * @details Blocks until the copy is finished or the ring stops answering.
+     * @return false if a file could not be copied to every unit
+    **/
+    bool push();
+
+    const ChainStats &stats() const { return chain_stats; }
+
+private:
+    void rx_isr();
+    uint32_t available() const { return rx_head - rx_tail; }
+    uint8_t take();
+    bool read_frame(uint32_t timeout_ms);
+    void send_frame(ChainHeader *h, const uint8_t *data);
+    bool exchange(ChainHeader *h, const uint8_t *data);
+
+    bool signature(const char *name, uint32_t size, uint32_t *sig);
+    bool needs(const ChainEntry &entry);
+    void begin_file(const ChainEntry &entry);
+    void store(uint32_t sector, const uint8_t *data);
+    bool flush_batch();
+    void save_journal();
+    void end_file();
+    void handle_frame();
+    uint32_t sectors() const { return (state.entry.size + SECTOR_SIZE - 1) / SECTOR_SIZE; }
+
+    int scan(int first, ChainEntry *entries, int max);
+    bool send_file(int file, const ChainEntry &entry);
+
+    RawSerial serial;
+    SDCard *card;
+    const char *dir;
+    uint8_t rx[CHAIN_RX_BUFFER];
+    volatile uint32_t rx_head;
+    volatile uint32_t rx_tail;
+    ChainHeader header;                 // Frame last read
+    uint8_t payload[SECTOR_SIZE];
+
+    // Receiving
+    bool receiving;                     // A file is being received into the temporary file
+    uint16_t current_file;
+    ChainJournal state;                 // File being received & sectors written, as journalled
+    TrackStream temp;
+    TrackStream journal;
+    uint8_t batch[CHAIN_BATCH_SECTORS * SECTOR_SIZE];
+    uint32_t batch_count;
+    int batches_unjournalled;
+    bool changed;                       // A new file was put in place since power up
+
+    ChainStats chain_stats;
+};
+
+#endif
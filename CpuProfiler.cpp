@@ -0,0 +1,85 @@
+/**
+ * @file CpuProfiler.cpp
+ * @brief Sampling profiler of the CPU time each RTOS thread uses
+**/
+#include "CpuProfiler.h"
+#include <string.h>
+
+// RTX's record of the running task (rt_TypeDef.h); run is the osThreadId of the thread the sample
+// interrupt preempted. osThreadGetId() cannot be used from an interrupt.
+struct OS_TSK
+{
+    void *run;
+    void *new_tsk;
+};
+extern "C" struct OS_TSK os_tsk;
+
+CpuProfiler::CpuProfiler()
+{
+    num_threads = 0;
+    memset((void *)counts, 0, sizeof(counts));
+}
+
+bool CpuProfiler::add_thread(const char *name, osThreadId id)
+{
+    if (num_threads == PROFILER_MAX_THREADS)
+    {
+        return false;
+    }
+    names[num_threads] = name;
+    ids[num_threads] = id;
+    num_threads++;
+    return true;
+}
+
+/**
+ * @brief Ticker interrupt: counts a sample against the thread it interrupted
+**/
+void CpuProfiler::sample()
+{
+    void *running = os_tsk.run;
+    int i = 0;
+    while (i < num_threads && (void *)ids[i] != running)
+    {
+        i++;
+    }
+    counts[i]++;
+}
+
+void CpuProfiler::start()
+{
+    __disable_irq();
+    memset((void *)counts, 0, sizeof(counts));
+    __enable_irq();
+    ticker.attach_us(this, &CpuProfiler::sample, 1000000 / PROFILER_HZ);
+}
+
+void CpuProfiler::stop()
+{
+    ticker.detach();
+}
+
+unsigned CpuProfiler::take(uint8_t *percent)
+{
+    uint32_t window[PROFILER_MAX_THREADS + 1];
+    __disable_irq();
+    memcpy(window, (const void *)counts, sizeof(window));
+    memset((void *)counts, 0, sizeof(counts));
+    __enable_irq();
+
+    uint32_t total = 0;
+    for (int i = 0; i <= num_threads; i++)
+    {
+        total += window[i];
+    }
+    if (total == 0)
+    {
+        memset(percent, 0, num_threads);
+        return 0;
+    }
+    for (int i = 0; i < num_threads; i++)
+    {
+        percent[i] = window[i] * 100 / total;
+    }
+    return window[num_threads] * 100 / total;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file CpuProfiler.h
+ * @brief Sampling profiler of the CPU time each RTOS thread uses
+ * @details RTX keeps no run times, so a timer interrupt notes which thread it interrupted, a few
+ * hundred times a second; a thread's share of the samples is its share of the CPU. The sampler only
+ * runs between start() and stop(), so it costs nothing while no one is looking.
+**/
+#ifndef CPUPROFILER_H
+#define CPUPROFILER_H
+
+#include "mbed.h"
+#include "rtos.h"
+
+// Samples taken per second
+#define PROFILER_HZ 500
+// Largest number of threads told apart; the rest are counted together
+#define PROFILER_MAX_THREADS 10
+
+/**
+ * @brief Per-thread CPU share by sampling the running thread
+**/
+class CpuProfiler
+{
+public:
+    CpuProfiler();
+
+    /**
+     * @brief Names a thread to be told apart
+     * @param name Short name for display, e.g. "lcd"
+     * @param id Thread, from Thread::gettid() or osThreadGetId()
+     * @return false if PROFILER_MAX_THREADS are already named
+    **/
+    bool add_thread(const char *name, osThreadId id);
+
+    void start();
+    void stop();
+
+    /**
+     * @brief Takes each thread's share of the samples since the last call & starts a new window
+     * @param percent Filled with one share per named thread, in the order they were added
+     * @return Share of the samples that fell in no named thread, e.g. the RTX idle task
+    **/
+    unsigned take(uint8_t *percent);
+
+    int threads() const { return num_threads; }
+    const char *name(int index) const { return names[index]; }
+
+private:
+    void sample();
+
+    Ticker ticker;
+    const char *names[PROFILER_MAX_THREADS];
+    osThreadId ids[PROFILER_MAX_THREADS];
+    volatile uint32_t counts[PROFILER_MAX_THREADS + 1];     // Last entry counts unnamed threads
+    int num_threads;
+};
+
+#endif
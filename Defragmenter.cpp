@@ -0,0 +1,473 @@
+/**
+ * @file Defragmenter.cpp
+ * @brief Makes fragmented songs contiguous on the card while the player is idle
+**/
+#include "Defragmenter.h"
+#include <string.h>
+
+// FatFs work areas, kept off the thread stacks; guarded by sdMutex
+static FIL defragFile;
+static char defragPath[_MAX_LFN + 64];
+
+/**
+ * @brief Checksum of a journal record
+**/
+static uint32_t journal_check(const DefragJournal &journal)
+{
+    return journal.magic + journal.old_cluster + journal.new_cluster + journal.size + journal.old_dir_sector +
+           journal.new_dir_sector + journal.old_dir_offset + ((uint32_t)journal.new_dir_offset << 16);
+}
+
+/**
+ * @brief Reads the start cluster of a raw directory entry
+**/
+static uint32_t entry_cluster(const FATFS *vol, const uint8_t *entry)
+{
+    uint32_t cluster = entry[26] | (entry[27] << 8);
+    if (vol->fs_type == FS_FAT32)
+    {
+        cluster |= (entry[20] << 16) | ((uint32_t)entry[21] << 24);
+    }
+    return cluster;
+}
+
+static uint32_t entry_size(const uint8_t *entry)
+{
+    return entry[28] | (entry[29] << 8) | (entry[30] << 16) | ((uint32_t)entry[31] << 24);
+}
+
+static void set_entry_cluster(const FATFS *vol, uint8_t *entry, uint32_t cluster)
+{
+    entry[26] = cluster;
+    entry[27] = cluster >> 8;
+    if (vol->fs_type == FS_FAT32)
+    {
+        entry[20] = cluster >> 16;
+        entry[21] = cluster >> 24;
+    }
+}
+
+Defragmenter::Defragmenter(SDCard *card, LibraryIndex *library, TrackCache *cache, MediaScrubber *scrubber)
+{
+    this->card = card;
+    this->library = library;
+    this->cache = cache;
+    this->scrubber = scrubber;
+    path = NULL;
+    phase = PHASE_IDLE;
+    song = -1;
+    cursor = 0;
+    finished_song = -1;
+    memset(&last_report, 0, sizeof(last_report));
+    last_report.song = -1;
+    memset(&journal, 0, sizeof(journal));
+}
+
+/**
+ * @brief Reads the start clusters held by the directory entries of the journal
+ * @return false if either entry no longer has the size of the song
+**/
+bool Defragmenter::read_entries(uint32_t *song_cluster, uint32_t *copy_cluster)
+{
+    FATFS *vol = &card->_fs;
+    bool ok = card->disk_read(batch, journal.old_dir_sector) == 0 &&
+              card->disk_read(batch + SECTOR_SIZE, journal.new_dir_sector) == 0;
+    const uint8_t *song_entry = batch + journal.old_dir_offset;
+    const uint8_t *copy_entry = batch + SECTOR_SIZE + journal.new_dir_offset;
+    if (!ok || entry_size(song_entry) != journal.size || entry_size(copy_entry) != journal.size)
+    {
+        return false;
+    }
+    *song_cluster = entry_cluster(vol, song_entry);
+    *copy_cluster = entry_cluster(vol, copy_entry);
+    return true;
+}
+
+/**
+ * @brief Points the directory entries of the song & the copy at the given chains
+ * @details When both entries share a sector they change in a single sector write. Otherwise the song's
+ * entry is written first; recover() can complete the swap from either intermediate state. FatFs'
+ * window is dropped if it holds a rewritten sector.
+**/
+bool Defragmenter::write_entries(uint32_t song_cluster, uint32_t copy_cluster)
+{
+    FATFS *vol = &card->_fs;
+    if (vol->wflag)
+    {
+        return false;
+    }
+    bool ok = card->disk_read(batch, journal.old_dir_sector) == 0;
+    if (ok)
+    {
+        set_entry_cluster(vol, batch + journal.old_dir_offset, song_cluster);
+        if (journal.new_dir_sector == journal.old_dir_sector)
+        {
+            set_entry_cluster(vol, batch + journal.new_dir_offset, copy_cluster);
+        }
+        ok = card->disk_write(batch, journal.old_dir_sector) == 0;
+    }
+    if (ok && journal.new_dir_sector != journal.old_dir_sector)
+    {
+        ok = card->disk_read(batch, journal.new_dir_sector) == 0;
+        if (ok)
+        {
+            set_entry_cluster(vol, batch + journal.new_dir_offset, copy_cluster);
+            ok = card->disk_write(batch, journal.new_dir_sector) == 0;
+        }
+    }
+    if (vol->winsect == journal.old_dir_sector || vol->winsect == journal.new_dir_sector)
+    {
+        vol->winsect = 0xFFFFFFFF;
+    }
+    return ok;
+}
+
+/**
+ * @brief Deletes the temporary file, freeing whichever chain its entry points at
+**/
+void Defragmenter::remove_copy()
+{
+    sdMutex.lock();
+    snprintf(defragPath, sizeof(defragPath), "%d:/%s", card->_fsid, DEFRAG_TEMP_NAME);
+    f_unlink(defragPath);
+    invalidate_fat_cache();
+    sdMutex.unlock();
+}
+
+bool Defragmenter::recover(const char *path)
+{
+    this->path = path;
+    bool found = false;
+    sdMutex.lock();
+    FILE *fp = fopen(path, "rb");
+    if (fp != NULL)
+    {
+        found = fread(&journal, sizeof(journal), 1, fp) == 1 && journal.magic == DEFRAG_MAGIC &&
+                journal.check == journal_check(journal);
+        fclose(fp);
+    }
+    if (found)
+    {
+        uint32_t song_cluster;
+        uint32_t copy_cluster;
+        if (read_entries(&song_cluster, &copy_cluster))
+        {
+            // Complete a swap that reached the song's entry; otherwise just drop the copy
+            if (song_cluster == journal.new_cluster && copy_cluster != journal.old_cluster)
+            {
+                write_entries(journal.new_cluster, journal.old_cluster);
+                read_entries(&song_cluster, &copy_cluster);
+            }
+            if (song_cluster != copy_cluster)
+            {
+                remove_copy();
+            }
+        }
+    }
+    else
+    {
+        // Without a complete journal the song's entry was never touched
+        remove_copy();
+    }
+    remove(path);
+    sdMutex.unlock();
+    return found;
+}
+
+/**
+ * @brief Picks the next scanned song with more than one sector run & starts looking for free space
+**/
+bool Defragmenter::choose()
+{
+    int count = library->count();
+    FATFS *vol = &card->_fs;
+    if (vol->fs_type != FS_FAT16 && vol->fs_type != FS_FAT32)
+    {
+        return false;
+    }
+    for (int i = 0; i < count; i++)
+    {
+        int next = (cursor + i) % count;
+        const TrackProfile &profile = library->profile(next);
+        if ((profile.flags & PROFILE_SCANNED) && profile.fragments > 1 &&
+            !(profile.flags & (PROFILE_READ_ERROR | PROFILE_NO_DEFRAG)))
+        {
+            song = next;
+            cursor = next + 1;
+            handle = library->handle(song);
+            uint32_t cluster_bytes = vol->csize * SECTOR_SIZE;
+            need = (handle.size + cluster_bytes - 1) / cluster_bytes;
+            sectors = (handle.size + SECTOR_SIZE - 1) / SECTOR_SIZE;
+            scan_cluster = 2;
+            run_length = 0;
+            phase = PHASE_SEARCH;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Checks the FAT entries in one FAT sector for a free run long enough for the song
+**/
+void Defragmenter::search()
+{
+    FATFS *vol = &card->_fs;
+    bool fat32 = (vol->fs_type == FS_FAT32);
+    uint32_t per_sector = fat32 ? SECTOR_SIZE / 4 : SECTOR_SIZE / 2;
+    uint32_t fat_index = scan_cluster / per_sector;
+    sdMutex.lock();
+    bool ok = card->disk_read(verify, vol->fatbase + fat_index) == 0;
+    sdMutex.unlock();
+    if (!ok)
+    {
+        fail();
+        return;
+    }
+    for (; scan_cluster < vol->n_fatent && scan_cluster / per_sector == fat_index; scan_cluster++)
+    {
+        uint32_t index = scan_cluster % per_sector;
+        uint32_t value = fat32 ? (verify[index * 4] | (verify[index * 4 + 1] << 8) | (verify[index * 4 + 2] << 16) |
+                                  ((uint32_t)(verify[index * 4 + 3] & 0x0F) << 24))
+                               : (verify[index * 2] | (verify[index * 2 + 1] << 8));
+        if (value != 0)
+        {
+            run_length = 0;
+            continue;
+        }
+        if (run_length == 0)
+        {
+            run_start = scan_cluster;
+        }
+        if (++run_length == need)
+        {
+            allocate();
+            return;
+        }
+    }
+    if (scan_cluster >= vol->n_fatent)
+    {
+        fail();
+    }
+}
+
+/**
+ * @brief Allocates the free run found by search() as the temporary file & records both directory entries
+ * @details FatFs allocates upwards from the last cluster it allocated, so starting it just before the
+ * free run makes the new chain exactly that run, unless a cluster of the run was taken meanwhile.
+**/
+void Defragmenter::allocate()
+{
+    FATFS *vol = &card->_fs;
+    bool ok = false;
+    memset(&journal, 0, sizeof(journal));
+    sdMutex.lock();
+    snprintf(defragPath, sizeof(defragPath), "%d:/%s/%s", card->_fsid, library->directory(), library->name(song).c_str());
+    if (f_open(&defragFile, defragPath, FA_READ) == FR_OK)
+    {
+        ok = defragFile.sclust == handle.start_cluster && defragFile.fsize == handle.size;
+        journal.old_dir_sector = defragFile.dir_sect;
+        journal.old_dir_offset = defragFile.dir_ptr - vol->win;
+        f_close(&defragFile);
+    }
+    snprintf(defragPath, sizeof(defragPath), "%d:/%s", card->_fsid, DEFRAG_TEMP_NAME);
+    if (ok && f_open(&defragFile, defragPath, FA_CREATE_ALWAYS | FA_WRITE) == FR_OK)
+    {
+        journal.new_dir_sector = defragFile.dir_sect;
+        journal.new_dir_offset = defragFile.dir_ptr - vol->win;
+        vol->last_clust = run_start - 1;
+        ok = f_lseek(&defragFile, handle.size) == FR_OK && defragFile.fptr == handle.size &&
+             defragFile.sclust == run_start;
+        ok = f_close(&defragFile) == FR_OK && ok;
+    }
+    else
+    {
+        ok = false;
+    }
+    invalidate_fat_cache();
+    // The run was found over several steps with the card free in between, so another file may have
+    // taken a cluster of it since; FatFs then skips that cluster. The copy writes the run as raw
+    // sectors, so the whole chain is checked to be the run before anything is written.
+    TrackHandle copy_handle = {run_start, handle.size};
+    target.open(card, copy_handle);
+    uint32_t first = vol->database + (run_start - 2) * vol->csize;
+    uint32_t checked = 0;
+    while (ok && checked < sectors)
+    {
+        uint32_t disk;
+        uint32_t count = target.run(checked, &disk);
+        ok = count > 0 && disk == first + checked;
+        checked += count;
+    }
+    sdMutex.unlock();
+    if (!ok)
+    {
+        fail();
+        return;
+    }
+
+    source.open(card, handle);
+    copy_sector = 0;
+    phase = PHASE_COPY;
+}
+
+/**
+ * @brief Copies one batch of sectors into the free run & compares the copy with the song
+ * @details The copy is read back through the temporary file's own cluster chain, so this also proves
+ * the chain FatFs allocated is the run the sectors were written to.
+**/
+void Defragmenter::copy()
+{
+    uint32_t count = sectors - copy_sector;
+    if (count > DEFRAG_BATCH_SECTORS)
+    {
+        count = DEFRAG_BATCH_SECTORS;
+    }
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (!source.read_sector(copy_sector + i, batch + i * SECTOR_SIZE))
+        {
+            fail();
+            return;
+        }
+    }
+    FATFS *vol = &card->_fs;
+    uint32_t first = vol->database + (run_start - 2) * vol->csize + copy_sector;
+    sdMutex.lock();
+    bool ok = card->disk_write_blocks(batch, first, count) == 0;
+    sdMutex.unlock();
+    for (uint32_t i = 0; i < count && ok; i++)
+    {
+        ok = target.read_sector(copy_sector + i, verify) && memcmp(verify, batch + i * SECTOR_SIZE, SECTOR_SIZE) == 0;
+    }
+    if (!ok)
+    {
+        fail();
+        return;
+    }
+    copy_sector += count;
+    if (copy_sector >= sectors)
+    {
+        if (target.fragment_count() != 1)
+        {
+            fail();
+            return;
+        }
+        phase = PHASE_SWAP;
+    }
+}
+
+/**
+ * @brief Writes the journal record so a reset during the swap can be recovered
+**/
+bool Defragmenter::write_journal()
+{
+    journal.magic = DEFRAG_MAGIC;
+    journal.old_cluster = handle.start_cluster;
+    journal.new_cluster = run_start;
+    journal.size = handle.size;
+    journal.check = journal_check(journal);
+    bool ok = false;
+    sdMutex.lock();
+    FILE *fp = fopen(path, "r+b");
+    if (fp == NULL)
+    {
+        fp = fopen(path, "wb");
+    }
+    if (fp != NULL)
+    {
+        ok = fwrite(&journal, sizeof(journal), 1, fp) == 1;
+        ok = fclose(fp) == 0 && ok;
+    }
+    sdMutex.unlock();
+    return ok;
+}
+
+/**
+ * @brief Gives the song the contiguous chain & the temporary file the old one, then deletes the latter
+**/
+void Defragmenter::swap()
+{
+    uint32_t before = library->profile(song).fragments;
+    uint32_t after = target.fragment_count();
+    source.close();
+    target.close();
+    if (path == NULL || !write_journal())
+    {
+        fail();
+        return;
+    }
+
+    sdMutex.lock();
+    uint32_t song_cluster;
+    uint32_t copy_cluster;
+    bool ok = read_entries(&song_cluster, &copy_cluster) && song_cluster == journal.old_cluster &&
+              copy_cluster == journal.new_cluster && write_entries(journal.new_cluster, journal.old_cluster);
+    if (ok)
+    {
+        remove_copy();
+    }
+    sdMutex.unlock();
+    if (!ok)
+    {
+        // Leave the journal for recover() to settle at the next boot
+        TrackProfile profile = library->profile(song);
+        profile.flags |= PROFILE_NO_DEFRAG;
+        library->set_profile(song, profile);
+        phase = PHASE_IDLE;
+        song = -1;
+        return;
+    }
+    remove(path);
+
+    TrackHandle moved = {journal.new_cluster, handle.size};
+    library->set_handle(song, moved);
+    cache->forget(song);
+    TrackProfile profile = library->profile(song);
+    profile.fragments = after;
+    library->set_profile(song, profile);
+    // The checkpoint matches songs by handle, so the profile is recorded again under the new one
+    scrubber->checkpoint(song);
+
+    last_report.song = song;
+    last_report.before = before;
+    last_report.after = after;
+    finished_song = song;
+    phase = PHASE_IDLE;
+    song = -1;
+}
+
+/**
+ * @brief Abandons the current song, deleting any copy, & skips it from now on
+**/
+void Defragmenter::fail()
+{
+    source.close();
+    target.close();
+    remove_copy();
+    TrackProfile profile = library->profile(song);
+    profile.flags |= PROFILE_NO_DEFRAG;
+    library->set_profile(song, profile);
+    phase = PHASE_IDLE;
+    song = -1;
+}
+
+bool Defragmenter::step()
+{
+    finished_song = -1;
+    switch (phase)
+    {
+        case PHASE_IDLE:
+            return choose();
+        case PHASE_SEARCH:
+            search();
+            break;
+        case PHASE_COPY:
+            copy();
+            break;
+        default:
+            swap();
+            break;
+    }
+    return true;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file Defragmenter.h
+ * @brief Makes fragmented songs contiguous on the card while the player is idle
+ * @details A fragmented file is copied into a free run of clusters allocated as a temporary file, using
+ * multi-block writes, and every sector of the copy is read back & compared. The directory entries of
+ * the song and the temporary file then swap start clusters, so the song keeps its name & place in its
+ * directory, and deleting the temporary file frees the old chain. A journal written before the swap
+ * lets recover() finish or undo it after a power loss; until then the song itself is never written.
+**/
+#ifndef DEFRAGMENTER_H
+#define DEFRAGMENTER_H
+
+#include "mbed.h"
+#include "rtos.h"
+#include "SDCard.h"
+#include "TrackStream.h"
+#include "LibraryIndex.h"
+#include "TrackCache.h"
+#include "MediaScrubber.h"
+
+// Sectors copied per multi-block write
+#define DEFRAG_BATCH_SECTORS 4
+// Marks a complete journal record ("DFRG")
+#define DEFRAG_MAGIC 0x47524644
+// Temporary file holding the copy, in the root directory
+#define DEFRAG_TEMP_NAME "defrag.tmp"
+
+/**
+ * @brief Journal of a directory entry swap in progress
+**/
+struct DefragJournal
+{
+    uint32_t magic;
+    uint32_t old_cluster;       // Start of the song's fragmented chain
+    uint32_t new_cluster;       // Start of the contiguous copy
+    uint32_t size;              // Size of the song in bytes
+    uint32_t old_dir_sector;    // Directory entry of the song
+    uint32_t new_dir_sector;    // Directory entry of the temporary file
+    uint16_t old_dir_offset;
+    uint16_t new_dir_offset;
+    uint32_t check;             // Sum of the fields above; catches a torn write
+};
+
+/**
+ * @brief Fragmentation of the last song made contiguous
+**/
+struct DefragReport
+{
+    int song;
+    uint32_t before;            // Sector runs before the copy
+    uint32_t after;             // Sector runs after the copy
+};
+
+/**
+ * @brief Background defragmenter, run a batch of sectors at a time
+**/
+class Defragmenter
+{
+public:
+    Defragmenter(SDCard *card, LibraryIndex *library, TrackCache *cache, MediaScrubber *scrubber);
+
+    /**
+     * @brief Finishes or undoes a swap interrupted by a reset & removes a left-over copy
+     * @details Call at boot, before the library is built.
+     * @param path stdio path of the journal, e.g. "/sd/defrag.jnl"
+     * @return true if an interrupted swap was found
+    **/
+    bool recover(const char *path);
+
+    /**
+     * @brief Does the next bounded piece of work: one FAT sector of the free space search, one batch of
+     * the copy, or the swap
+     * @return false when no song profiled by the scrubber is left to defragment
+    **/
+    bool step();
+
+    /**
+     * @brief Song the last step made contiguous, -1 if none
+    **/
+    int finished() const { return finished_song; }
+    const DefragReport &report() const { return last_report; }
+
+private:
+    enum Phase
+    {
+        PHASE_IDLE,
+        PHASE_SEARCH,
+        PHASE_COPY,
+        PHASE_SWAP
+    };
+
+    bool choose();
+    void search();
+    void allocate();
+    void copy();
+    void swap();
+    void fail();
+    void remove_copy();
+    bool write_journal();
+    bool read_entries(uint32_t *song_cluster, uint32_t *copy_cluster);
+    bool write_entries(uint32_t song_cluster, uint32_t copy_cluster);
+
+    SDCard *card;
+    LibraryIndex *library;
+    TrackCache *cache;
+    MediaScrubber *scrubber;
+    const char *path;
+    Phase phase;
+    int song;
+    int cursor;
+    int finished_song;
+    DefragReport last_report;
+    TrackHandle handle;         // Song being defragmented
+    uint32_t need;              // Clusters the song occupies
+    uint32_t scan_cluster;      // Next FAT entry to check for a free run
+    uint32_t run_start;
+    uint32_t run_length;
+    uint32_t copy_sector;       // Next file sector to copy
+    uint32_t sectors;
+    TrackStream source;
+    TrackStream target;
+    DefragJournal journal;
+    uint8_t batch[DEFRAG_BATCH_SECTORS * SECTOR_SIZE];
+    uint8_t verify[SECTOR_SIZE];
+};
+
+#endif
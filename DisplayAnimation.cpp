@@ -0,0 +1,123 @@
+/**
+ * @file DisplayAnimation.cpp
+ * @brief Pre-rendered animations played from the uLCD's own microSD card, in step with the audio
+**/
+#include "DisplayAnimation.h"
+#include "TrackStream.h"
+#include <string.h>
+
+DisplayAnimation::DisplayAnimation(uLCD_4DGL *lcd)
+{
+    this->lcd = lcd;
+    path[0] = 0;
+    manifest_ok = false;
+    media_ready = false;
+    has_entry = false;
+    looping = false;
+    last_frame = -1;
+    memset(&entry, 0, sizeof(entry));
+    memset(&anim_stats, 0, sizeof(anim_stats));
+}
+
+bool DisplayAnimation::open(const char *path)
+{
+    strncpy(this->path, path, sizeof(this->path) - 1);
+    this->path[sizeof(this->path) - 1] = 0;
+    sdMutex.lock();
+    FILE *fp = fopen(this->path, "rb");
+    if (fp != NULL)
+    {
+        AnimationHeader header;
+        manifest_ok = fread(&header, sizeof(header), 1, fp) == 1 && header.magic == ANIM_MAGIC;
+        fclose(fp);
+    }
+    sdMutex.unlock();
+    return manifest_ok;
+}
+
+/**
+ * @details The manifest is read a record at a time, so it costs no RAM however many songs it holds.
+**/
+bool DisplayAnimation::select(const char *name)
+{
+    has_entry = false;
+    last_frame = -1;
+    if (!manifest_ok)
+    {
+        memset(&entry, 0, sizeof(entry));
+        return false;
+    }
+    if (!media_ready)
+    {
+        // The display's card is only started once a video is wanted
+        lcd->media_init();
+        media_ready = true;
+    }
+    sdMutex.lock();
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL)
+    {
+        sdMutex.unlock();
+        memset(&entry, 0, sizeof(entry));
+        return false;
+    }
+    AnimationHeader header;
+    AnimationEntry record;
+    if (fread(&header, sizeof(header), 1, fp) == 1)
+    {
+        for (uint32_t i = 0; i < header.count && fread(&record, sizeof(record), 1, fp) == 1; i++)
+        {
+            if (strncmp(record.name, name, ANIM_NAME_LEN) == 0)
+            {
+                entry = record;
+                has_entry = true;
+                looping = false;
+                break;
+            }
+            if (!has_entry && strncmp(record.name, ANIM_LOOP_NAME, ANIM_NAME_LEN) == 0)
+            {
+                entry = record;
+                has_entry = true;
+                looping = true;
+            }
+        }
+    }
+    fclose(fp);
+    sdMutex.unlock();
+    if (!has_entry)
+    {
+        memset(&entry, 0, sizeof(entry));
+    }
+    return has_entry && entry.frames > 0 && entry.fps > 0;
+}
+
+bool DisplayAnimation::show(uint32_t position, uint32_t rate)
+{
+    if (!has_entry || entry.frames == 0 || entry.fps == 0)
+    {
+        return false;
+    }
+    uint32_t frame = rate ? (uint32_t)((uint64_t)position * entry.fps / rate) : 0;
+    if (looping)
+    {
+        frame %= entry.frames;
+    }
+    else if (frame >= entry.frames)
+    {
+        frame = entry.frames - 1;
+    }
+    if ((int)frame == last_frame)
+    {
+        return false;
+    }
+    if (last_frame >= 0 && (int)frame > last_frame + 1)
+    {
+        anim_stats.frames_skipped += frame - last_frame - 1;
+    }
+    // The frame number counts from the video at the current sector address
+    lcd->set_sector_address(entry.sector >> 16, entry.sector & 0xFFFF);
+    lcd->display_frame(entry.x, entry.y, frame);
+    last_frame = frame;
+    anim_stats.frames_shown++;
+    return true;
+}
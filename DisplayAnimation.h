@@ -0,0 +1,99 @@
+/**
+ * @file DisplayAnimation.h
+ * @brief Pre-rendered animations played from the uLCD's own microSD card, in step with the audio
+ * @details tools/pack_animation.py renders a video for each song, timed to its audio, & packs them into
+ * a raw image for the display's card in the Goldelox video format, plus a manifest for the player's
+ * card. The player only sends the display a sector address & a frame number, 14 bytes a frame; the
+ * display reads the pixels from its own card. The frame shown is worked out from the samples the DAC
+ * has played, so the video keeps time with the audio however fast the display draws.
+**/
+#ifndef DISPLAYANIMATION_H
+#define DISPLAYANIMATION_H
+
+#include "mbed.h"
+#include "uLCD_4DGL.h"
+
+// Marks a manifest written by this version ("ANIM")
+#define ANIM_MAGIC 0x4D494E41
+// Characters of a song file name kept in the manifest
+#define ANIM_NAME_LEN 40
+// Manifest name of the video looped for songs without one of their own
+#define ANIM_LOOP_NAME "*"
+
+/**
+ * @brief Start of the manifest
+**/
+struct AnimationHeader
+{
+    uint32_t magic;
+    uint32_t count;             // AnimationEntry records that follow
+};
+
+/**
+ * @brief One video on the display's card
+**/
+struct AnimationEntry
+{
+    char name[ANIM_NAME_LEN];   // Song file name as listed, zero padded, or ANIM_LOOP_NAME
+    uint32_t sector;            // First sector of the video on the display's card
+    uint16_t frames;
+    uint16_t fps;
+    uint8_t x, y;               // Top left corner on the screen
+    uint8_t width, height;
+};
+
+/**
+ * @brief Frames sent to the display
+**/
+struct AnimationStats
+{
+    unsigned frames_shown;
+    unsigned frames_skipped;    // Frames passed over because the display was still drawing an earlier one
+};
+
+/**
+ * @brief Player of the videos on the display's card
+**/
+class DisplayAnimation
+{
+public:
+    DisplayAnimation(uLCD_4DGL *lcd);
+
+    /**
+     * @brief Checks the manifest on the player's card
+     * @param path Path of the manifest, e.g. "/sd/anims.dat"
+     * @return false if it is missing or not a manifest
+    **/
+    bool open(const char *path);
+
+    /**
+     * @brief Picks the video of a song, or the loop if it has none; call from the LCD thread
+     * @param name Song file name, as listed
+     * @return false if there is neither
+    **/
+    bool select(const char *name);
+
+    /**
+     * @brief Shows the frame for a point in the audio, if it is not already on the screen
+     * @param position Samples of the song played by the DAC
+     * @param rate Sample rate of the song, 0 when stopped
+     * @return true if a frame was sent
+    **/
+    bool show(uint32_t position, uint32_t rate);
+
+    const AnimationEntry &selected() const { return entry; }
+    const AnimationStats &stats() const { return anim_stats; }
+
+private:
+    uLCD_4DGL *lcd;
+    char path[32];
+    bool manifest_ok;
+    bool media_ready;
+    bool has_entry;
+    bool looping;               // entry is the loop, not the song's own video
+    AnimationEntry entry;
+    int last_frame;
+    AnimationStats anim_stats;
+};
+
+#endif
@@ -0,0 +1,137 @@
+/**
+ * @file FilePool.cpp
+ * @brief Fixed pool of stdio file handles for the card, opened in place
+**/
+#include "FilePool.h"
+#include <string.h>
+
+PooledFile::PooledFile()
+{
+    pool = NULL;
+    memset(&fh, 0, sizeof(fh));
+}
+
+/**
+ * @details Translates the flags the same way as FATFileSystem::open.
+**/
+bool PooledFile::open(int fsid, const char *name, int flags)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "%d:/%s", fsid, name);
+    BYTE mode;
+    if (flags & O_RDWR)
+    {
+        mode = FA_READ | FA_WRITE;
+    }
+    else if (flags & O_WRONLY)
+    {
+        mode = FA_WRITE;
+    }
+    else
+    {
+        mode = FA_READ;
+    }
+    if (flags & O_CREAT)
+    {
+        mode |= (flags & O_TRUNC) ? FA_CREATE_ALWAYS : FA_OPEN_ALWAYS;
+    }
+    if (f_open(&fh, path, mode) != FR_OK)
+    {
+        return false;
+    }
+    if (flags & O_APPEND)
+    {
+        f_lseek(&fh, fh.fsize);
+    }
+    return true;
+}
+
+int PooledFile::close()
+{
+    int result = f_close(&fh);
+    pool->release(this);
+    return result;
+}
+
+ssize_t PooledFile::write(const void *buffer, size_t length)
+{
+    UINT n;
+    return f_write(&fh, buffer, length, &n) == FR_OK ? (ssize_t)n : -1;
+}
+
+ssize_t PooledFile::read(void *buffer, size_t length)
+{
+    UINT n;
+    return f_read(&fh, buffer, length, &n) == FR_OK ? (ssize_t)n : -1;
+}
+
+int PooledFile::isatty()
+{
+    return 0;
+}
+
+off_t PooledFile::lseek(off_t position, int whence)
+{
+    if (whence == SEEK_END)
+    {
+        position += fh.fsize;
+    }
+    else if (whence == SEEK_CUR)
+    {
+        position += fh.fptr;
+    }
+    return f_lseek(&fh, position) == FR_OK ? (off_t)fh.fptr : -1;
+}
+
+int PooledFile::fsync()
+{
+    return f_sync(&fh) == FR_OK ? 0 : -1;
+}
+
+off_t PooledFile::flen()
+{
+    return fh.fsize;
+}
+
+FilePool::FilePool()
+{
+    for (int i = 0; i < FILE_POOL_SIZE; i++)
+    {
+        files[i].pool = this;
+        used[i] = false;
+    }
+    memset(&pool_stats, 0, sizeof(pool_stats));
+}
+
+PooledFile *FilePool::claim()
+{
+    PooledFile *file = NULL;
+    __disable_irq();
+    for (int i = 0; i < FILE_POOL_SIZE && file == NULL; i++)
+    {
+        if (!used[i])
+        {
+            used[i] = true;
+            file = &files[i];
+            pool_stats.opens++;
+            if (++pool_stats.in_use > pool_stats.peak)
+            {
+                pool_stats.peak = pool_stats.in_use;
+            }
+        }
+    }
+    if (file == NULL)
+    {
+        pool_stats.heap_opens++;
+    }
+    __enable_irq();
+    return file;
+}
+
+void FilePool::release(PooledFile *file)
+{
+    __disable_irq();
+    used[file - files] = false;
+    pool_stats.in_use--;
+    __enable_irq();
+}
@@ -0,0 +1,94 @@
+/**
+ * @file FilePool.h
+ * @brief Fixed pool of stdio file handles for the card, opened in place
+ * @details FATFileSystem::open allocates a FATFileHandle on the heap for every fopen and copies a FIL
+ * into it by value, 550 bytes with its sector buffer, then close() deletes it. A PooledFile keeps its
+ * FIL in a slot of a static pool, f_open fills it where it lies, and fclose hands the slot back, so
+ * opening & closing files costs no heap and no copy. Once every slot is taken, further opens fall
+ * back to FATFileSystem::open.
+**/
+#ifndef FILEPOOL_H
+#define FILEPOOL_H
+
+#include "mbed.h"
+#include "FileHandle.h"
+#include "ff.h"
+
+// Files open at once before opens fall back to the heap; may be set on the compiler command line
+#ifndef FILE_POOL_SIZE
+#define FILE_POOL_SIZE 4
+#endif
+
+class FilePool;
+
+/**
+ * @brief File handle living in a pool slot
+**/
+class PooledFile : public FileHandle
+{
+public:
+    PooledFile();
+
+    /**
+     * @brief Opens a file into this slot, with POSIX open flags as stdio passes them
+     * @return false if FatFs could not open the file
+    **/
+    bool open(int fsid, const char *name, int flags);
+
+    /**
+     * @brief Closes the file & returns the slot to its pool
+    **/
+    virtual int close();
+    virtual ssize_t write(const void *buffer, size_t length);
+    virtual ssize_t read(void *buffer, size_t length);
+    virtual int isatty();
+    virtual off_t lseek(off_t position, int whence);
+    virtual int fsync();
+    virtual off_t flen();
+
+private:
+    friend class FilePool;
+
+    FilePool *pool;
+    FIL fh;
+};
+
+/**
+ * @brief Use of the pool since power up
+**/
+struct FilePoolStats
+{
+    unsigned in_use;        // Slots holding an open file
+    unsigned peak;          // Most slots in use at once
+    unsigned opens;         // Slots handed out, including to opens that then failed
+    unsigned heap_opens;    // Opens that found every slot taken
+};
+
+/**
+ * @brief Slots of PooledFile, handed out & taken back without the heap
+**/
+class FilePool
+{
+public:
+    FilePool();
+
+    /**
+     * @brief Takes a free slot
+     * @return The slot, or NULL if all FILE_POOL_SIZE are in use, which is counted as a heap open
+    **/
+    PooledFile *claim();
+
+    /**
+     * @brief Returns a slot taken by claim()
+    **/
+    void release(PooledFile *file);
+
+    const FilePoolStats &stats() const { return pool_stats; }
+
+private:
+    PooledFile files[FILE_POOL_SIZE];
+    bool used[FILE_POOL_SIZE];
+    FilePoolStats pool_stats;
+};
+
+#endif
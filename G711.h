@@ -0,0 +1,22 @@
+/**
+ * @file G711.h
+ * @brief G.711 mu-law & A-law expansion tables
+ * @details The tables are const data, so the linker keeps them in flash rather than copying them
+ * into RAM. Decoding a G.711 sample is a single table load.
+**/
+#ifndef G711_H
+#define G711_H
+
+#include <stdint.h>
+
+/**
+ * @brief Unsigned 16 bit DAC value of each mu-law code
+**/
+extern const uint16_t g711MuLawTable[256];
+
+/**
+ * @brief Unsigned 16 bit DAC value of each A-law code
+**/
+extern const uint16_t g711ALawTable[256];
+
+#endif
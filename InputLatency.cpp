@@ -0,0 +1,162 @@
+/**
+ * @file InputLatency.cpp
+ * @brief Histograms of the time from each user command to its effect in the audio & on the screen
+**/
+#include "InputLatency.h"
+#include <string.h>
+
+static const char *const actionNames[INPUT_ACTIONS] =
+{
+    "play", "next", "prev", "shuffle", "seek", "anim", "diag"
+};
+static const char *const sourceNames[INPUT_SOURCES] = {"button", "pad"};
+static const char *const pathNames[INPUT_PATHS] = {"audio", "lcd"};
+
+/**
+ * @brief Paths each command changes: audio, only while a song plays, & the screen
+**/
+static const bool changesAudio[INPUT_ACTIONS] = {true, true, true, true, true, false, false};
+static const bool needsPlaying[INPUT_ACTIONS] = {false, true, true, true, true, false, false};
+static const bool changesDisplay[INPUT_ACTIONS] = {true, true, true, true, false, true, true};
+
+InputLatency::InputLatency()
+{
+    memset(histograms, 0, sizeof(histograms));
+    for (int i = 0; i < INPUT_PATHS; i++)
+    {
+        pending[i] = false;
+        started_count[i] = 0;
+        pending_action[i] = 0;
+        pending_source[i] = 0;
+        pending_us[i] = 0;
+        window_max_us[i] = 0;
+    }
+    window_commands = 0;
+    superseded_count = 0;
+}
+
+void InputLatency::command(InputAction action, InputSource source, uint32_t origin_us, bool playing)
+{
+    bool paths[INPUT_PATHS];
+    paths[INPUT_AUDIO] = changesAudio[action] && (playing || !needsPlaying[action]);
+    paths[INPUT_DISPLAY] = changesDisplay[action];
+    __disable_irq();
+    for (int i = 0; i < INPUT_PATHS; i++)
+    {
+        if (!paths[i])
+        {
+            continue;
+        }
+        if (pending[i])
+        {
+            superseded_count++;
+        }
+        pending[i] = true;
+        started_count[i]++;
+        pending_action[i] = action;
+        pending_source[i] = source;
+        pending_us[i] = origin_us;
+    }
+    __enable_irq();
+}
+
+/**
+ * @brief Records the latency of the command waiting on a path; interrupts must be off
+**/
+void InputLatency::record(InputPath path, uint32_t us)
+{
+    if (!pending[path])
+    {
+        return;
+    }
+    pending[path] = false;
+    uint32_t elapsed = us - pending_us[path];
+    InputHistogram &histogram = histograms[pending_action[path]][pending_source[path]][path];
+    uint32_t ms = elapsed / 1000;
+    int bucket = 0;
+    while (ms > 0 && bucket < INPUT_BUCKETS - 1)
+    {
+        ms >>= 1;
+        bucket++;
+    }
+    if (histogram.buckets[bucket] < 0xFFFF)
+    {
+        histogram.buckets[bucket]++;
+        histogram.count++;
+    }
+    if (elapsed > histogram.max_us)
+    {
+        histogram.max_us = elapsed;
+    }
+    if (elapsed > window_max_us[path])
+    {
+        window_max_us[path] = elapsed;
+    }
+    window_commands++;
+}
+
+void InputLatency::done(InputPath path, uint32_t us)
+{
+    __disable_irq();
+    record(path, us);
+    __enable_irq();
+}
+
+void InputLatency::done_since(InputPath path, uint32_t us, unsigned since)
+{
+    __disable_irq();
+    if (started_count[path] == since)
+    {
+        record(path, us);
+    }
+    __enable_irq();
+}
+
+uint32_t InputLatency::percentile(const InputHistogram &histogram, unsigned percent)
+{
+    if (histogram.count == 0)
+    {
+        return 0;
+    }
+    uint32_t target = ((uint32_t)histogram.count * percent + 99) / 100;
+    uint32_t seen = 0;
+    for (int i = 0; i < INPUT_BUCKETS - 1; i++)
+    {
+        seen += histogram.buckets[i];
+        if (seen >= target)
+        {
+            return 1u << i;
+        }
+    }
+    return histogram.max_us / 1000;
+}
+
+void InputLatency::take_window(uint16_t *audio_ms, uint16_t *display_ms, uint8_t *commands)
+{
+    __disable_irq();
+    uint32_t audio = window_max_us[INPUT_AUDIO] / 1000;
+    uint32_t display = window_max_us[INPUT_DISPLAY] / 1000;
+    unsigned count = window_commands;
+    window_max_us[INPUT_AUDIO] = 0;
+    window_max_us[INPUT_DISPLAY] = 0;
+    window_commands = 0;
+    __enable_irq();
+    *audio_ms = audio > 0xFFFF ? 0xFFFF : audio;
+    *display_ms = display > 0xFFFF ? 0xFFFF : display;
+    *commands = count > 0xFF ? 0xFF : count;
+}
+
+const char *InputLatency::action_name(int action)
+{
+    return actionNames[action];
+}
+
+const char *InputLatency::source_name(int source)
+{
+    return sourceNames[source];
+}
+
+const char *InputLatency::path_name(int path)
+{
+    return pathNames[path];
+}
@@ -0,0 +1,138 @@
+/**
+ * @file InputLatency.h
+ * @brief Histograms of the time from each user command to its effect in the audio & on the screen
+ * @details A command is timestamped where it is first seen: the button sample that found the pin
+ * changed, or the BlueTooth poll that read it. It then waits on each path it changes until that path
+ * reports the change done: the audio when the first sample of the new state reaches the DAC, or
+ * playback stops; the screen when the last command of the update has been acknowledged by the uLCD.
+ * A newer command on the same path replaces one still waiting, which is counted as superseded.
+**/
+#ifndef INPUTLATENCY_H
+#define INPUTLATENCY_H
+
+#include "mbed.h"
+
+// Histogram buckets: bucket 0 counts latencies under 1 ms, bucket n those of 2^(n-1) to 2^n - 1 ms,
+// and the last everything slower
+#define INPUT_BUCKETS 12
+
+/**
+ * @brief User commands, whichever control they come from
+**/
+enum InputAction
+{
+    INPUT_PLAY,             // Play or pause
+    INPUT_NEXT,
+    INPUT_PREV,
+    INPUT_SHUFFLE,
+    INPUT_SEEK,
+    INPUT_ANIMATION,        // Animation mode on or off
+    INPUT_DIAGNOSTICS,      // Diagnostics page on or off
+    INPUT_ACTIONS
+};
+
+/**
+ * @brief Controls a command can come from
+**/
+enum InputSource
+{
+    INPUT_BUTTON,           // Pushbuttons
+    INPUT_PAD,              // BlueTooth Control Pad
+    INPUT_SOURCES
+};
+
+/**
+ * @brief Where a command takes effect
+**/
+enum InputPath
+{
+    INPUT_AUDIO,
+    INPUT_DISPLAY,
+    INPUT_PATHS
+};
+
+/**
+ * @brief Latencies of one command from one control on one path
+**/
+struct InputHistogram
+{
+    uint16_t buckets[INPUT_BUCKETS];
+    uint32_t count;
+    uint32_t max_us;
+};
+
+/**
+ * @brief Per-command latency histograms
+**/
+class InputLatency
+{
+public:
+    InputLatency();
+
+    /**
+     * @brief Starts timing a command on the paths it changes
+     * @details Safe to call from interrupt context. Skips & seeks only change the audio while a song
+     * is playing.
+     * @param origin_us us_ticker time the command was first seen
+     * @param playing true if a song was playing when the command came
+    **/
+    void command(InputAction action, InputSource source, uint32_t origin_us, bool playing);
+
+    /**
+     * @brief Ends the timing of the command waiting on a path, if there is one
+     * @details Safe to call from interrupt context.
+     * @param us us_ticker time the path finished the change
+    **/
+    void done(InputPath path, uint32_t us);
+
+    /**
+     * @brief Commands started on a path so far, so a caller can tell whether one came in while it worked
+    **/
+    unsigned started(InputPath path) const { return started_count[path]; }
+
+    /**
+     * @brief As done(), but only if no command has started on the path since started() returned since
+     * @details For a path that checks for changes & then draws them: a command arriving after the
+     * check is left waiting for the next pass.
+    **/
+    void done_since(InputPath path, uint32_t us, unsigned since);
+
+    const InputHistogram &histogram(InputAction action, InputSource source, InputPath path) const
+    {
+        return histograms[action][source][path];
+    }
+
+    /**
+     * @brief Upper bound, in ms, of the bucket holding a percentile of a histogram; 0 if it is empty
+    **/
+    static uint32_t percentile(const InputHistogram &histogram, unsigned percent);
+
+    /**
+     * @brief Takes the slowest latency of each path, in ms, & the commands timed since the last call
+    **/
+    void take_window(uint16_t *audio_ms, uint16_t *display_ms, uint8_t *commands);
+
+    /**
+     * @brief Commands replaced by a newer one before they took effect
+    **/
+    unsigned superseded() const { return superseded_count; }
+
+    static const char *action_name(int action);
+    static const char *source_name(int source);
+    static const char *path_name(int path);
+
+private:
+    void record(InputPath path, uint32_t us);
+
+    InputHistogram histograms[INPUT_ACTIONS][INPUT_SOURCES][INPUT_PATHS];
+    volatile bool pending[INPUT_PATHS];
+    volatile unsigned started_count[INPUT_PATHS];
+    uint8_t pending_action[INPUT_PATHS];
+    uint8_t pending_source[INPUT_PATHS];
+    uint32_t pending_us[INPUT_PATHS];
+    uint32_t window_max_us[INPUT_PATHS];
+    unsigned window_commands;
+    unsigned superseded_count;
+};
+
+#endif
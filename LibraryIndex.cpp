@@ -0,0 +1,680 @@
+/**
+ * @file LibraryIndex.cpp
+ * @brief Index of the songs on the card, built once at boot
+**/
+#include "LibraryIndex.h"
+#include "Codec.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Largest directory FatFs can walk: 65536 entries of 32 bytes
+#define DIR_MAX_BYTES (65536UL * 32)
+// Directory entries per sector
+#define DIR_PER_SECTOR (SECTOR_SIZE / 32)
+
+// Scan work areas, kept off the thread stacks; guarded by sdMutex
+static FATFS_DIR scanDir;
+static FILINFO scanInfo;
+static FIL scanFile;
+static char scanName[_MAX_LFN + 1];
+static char scanPath[_MAX_LFN + 64];
+
+/**
+ * @brief FNV-1a hash of a file name, ignoring case
+**/
+static uint32_t hash_name(const char *name)
+{
+    uint32_t hash = 2166136261u;
+    while (*name)
+    {
+        hash ^= (uint8_t)tolower((uint8_t)*name++);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Compares two file names, ignoring case
+**/
+static bool same_name(const char *a, const char *b)
+{
+    while (*a && tolower((uint8_t)*a) == tolower((uint8_t)*b))
+    {
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+/**
+ * @brief Checks whether a file name ends in the given extension, ignoring case
+**/
+static bool has_extension(const char *name, const char *ext)
+{
+    int len = strlen(name);
+    int ext_len = strlen(ext);
+    return len > ext_len && same_name(name + len - ext_len, ext);
+}
+
+static bool same_handle(const TrackHandle &a, const TrackHandle &b)
+{
+    return a.start_cluster == b.start_cluster && a.size == b.size;
+}
+
+/**
+ * @brief One TRACK entry of a CUE sheet, resolved to the song of its album file
+**/
+struct CueTrack
+{
+    uint16_t song;          // Album file the track is cut from
+    uint8_t number;         // TRACK number
+    uint32_t start;         // INDEX 01 in CD frames, RANGE_END if the entry had none
+    std::string title;
+};
+
+/**
+ * @brief Matches a CUE sheet keyword at the start of a line, returning the text after it
+**/
+static const char *cue_keyword(const char *line, const char *keyword)
+{
+    int len = strlen(keyword);
+    if (strncmp(line, keyword, len) != 0 || (line[len] != ' ' && line[len] != '\t'))
+    {
+        return NULL;
+    }
+    line += len;
+    while (*line == ' ' || *line == '\t')
+    {
+        line++;
+    }
+    return line;
+}
+
+/**
+ * @brief Copies a quoted or space-delimited CUE sheet field
+**/
+static void cue_field(const char *text, char *field, int size)
+{
+    char end = ' ';
+    if (*text == '"')
+    {
+        end = '"';
+        text++;
+    }
+    int n = 0;
+    while (*text && *text != end && n < size - 1)
+    {
+        field[n++] = *text++;
+    }
+    field[n] = 0;
+}
+
+/**
+ * @brief Converts a CUE sheet position to bytes of sample data, whole frames only
+**/
+static uint32_t cue_bytes(uint32_t cd_frames, const FMT_STRUCT &format)
+{
+    uint32_t samples = (uint64_t)cd_frames * format.sample_rate / CUE_FRAMES_PER_SECOND;
+    return samples * format.block_align;
+}
+
+LibraryIndex::LibraryIndex(SDFileSystem *fs)
+{
+    this->fs = fs;
+    names = NULL;
+    dir_sector = 0xFFFFFFFF;
+    memset(seek_tables, 0, sizeof(seek_tables));
+}
+
+/**
+ * @brief Reads the start cluster of the directory entry f_readdir just returned
+ * @details The raw entry is found from the directory's own cluster chain, one sector read per 16
+ * entries, and checked against the short name & size FatFs reported.
+ * @return false if the entry could not be read or does not match
+**/
+bool LibraryIndex::locate_entry(uint32_t dir_cluster, int entry, const FILINFO &info, TrackHandle *handle)
+{
+    FATFS *vol = &fs->_fs;
+    uint32_t sector = entry / DIR_PER_SECTOR;
+    if (dir_cluster == 0 && vol->fs_type == FS_FAT32)
+    {
+        dir_cluster = vol->dirbase;
+    }
+    if (sector != dir_sector)
+    {
+        bool ok;
+        if (dir_cluster == 0)
+        {
+            // The FAT12/16 root directory is a fixed run of sectors
+            sdMutex.lock();
+            ok = fs->disk_read(sector_buf, vol->dirbase + sector) == 0;
+            sdMutex.unlock();
+        }
+        else
+        {
+            if (!dir_stream.is_open())
+            {
+                TrackHandle table = {dir_cluster, DIR_MAX_BYTES};
+                dir_stream.open(fs, table);
+            }
+            ok = dir_stream.read_sector(sector, sector_buf);
+        }
+        dir_sector = ok ? sector : 0xFFFFFFFF;
+        if (!ok)
+        {
+            return false;
+        }
+    }
+
+    // Rebuild the 8.3 name of the raw entry
+    const uint8_t *raw = sector_buf + (entry % DIR_PER_SECTOR) * 32;
+    char sfn[13];
+    int n = 0;
+    for (int i = 0; i < 8 && raw[i] != ' '; i++)
+    {
+        sfn[n++] = (i == 0 && raw[i] == 0x05) ? (char)0xE5 : (char)raw[i];
+    }
+    if (raw[8] != ' ')
+    {
+        sfn[n++] = '.';
+        for (int i = 8; i < 11 && raw[i] != ' '; i++)
+        {
+            sfn[n++] = raw[i];
+        }
+    }
+    sfn[n] = 0;
+    uint32_t size = raw[28] | (raw[29] << 8) | (raw[30] << 16) | ((uint32_t)raw[31] << 24);
+    if (size != info.fsize || !same_name(sfn, info.fname))
+    {
+        return false;
+    }
+
+    handle->start_cluster = raw[26] | (raw[27] << 8);
+    if (vol->fs_type == FS_FAT32)
+    {
+        handle->start_cluster |= (raw[20] << 16) | ((uint32_t)raw[21] << 24);
+    }
+    handle->size = size;
+    return true;
+}
+
+int LibraryIndex::build(const char *dir, std::vector<std::string> *names)
+{
+    this->names = names;
+    dir_name = dir;
+    names->clear();
+    handles.clear();
+    memset(seek_tables, 0, sizeof(seek_tables));
+    dir_stream.close();
+    dir_sector = 0xFFFFFFFF;
+
+    std::vector<std::string> cues;
+
+    sdMutex.lock();
+    snprintf(scanPath, sizeof(scanPath), "%d:/%s", fs->_fsid, dir);
+    if (f_opendir(&scanDir, scanPath) == FR_OK)
+    {
+        uint32_t dir_cluster = scanDir.sclust;
+        while (handles.size() < INDEX_EMPTY_SLOT)
+        {
+            scanName[0] = 0;
+            scanInfo.lfname = scanName;
+            scanInfo.lfsize = sizeof(scanName);
+            if (f_readdir(&scanDir, &scanInfo) != FR_OK || scanInfo.fname[0] == 0)
+            {
+                break;
+            }
+            if (scanInfo.fattrib & (AM_DIR | AM_VOL))
+            {
+                continue;
+            }
+            const char *name = scanName[0] ? scanName : scanInfo.fname;
+            // Only index files some codec in the build can be found in; CUE sheets are read after the scan
+            if (codec_for_name(name) == NULL)
+            {
+                if (has_extension(name, ".cue"))
+                {
+                    cues.push_back(std::string(name));
+                }
+                continue;
+            }
+
+            // f_readdir has already stepped past the entry, unless it hit the end of the table
+            int entry = scanDir.sect ? scanDir.index - 1 : scanDir.index;
+            TrackHandle handle = {0, 0};
+            if (!locate_entry(dir_cluster, entry, scanInfo, &handle))
+            {
+                // Fall back to resolving the path
+                snprintf(scanPath, sizeof(scanPath), "%d:/%s/%s", fs->_fsid, dir, name);
+                if (f_open(&scanFile, scanPath, FA_READ) == FR_OK)
+                {
+                    handle.start_cluster = scanFile.sclust;
+                    handle.size = scanFile.fsize;
+                    f_close(&scanFile);
+                }
+            }
+            names->push_back(std::string(name));
+            handles.push_back(handle);
+        }
+    }
+    sdMutex.unlock();
+    dir_stream.close();
+    TrackRange whole = {0, RANGE_END};
+    ranges.assign(handles.size(), whole);
+    rebuild_table();
+
+    // Split album files into the tracks of their CUE sheets
+    if (!cues.empty())
+    {
+        std::vector<CueTrack> tracks;
+        for (unsigned i = 0; i < cues.size(); i++)
+        {
+            std::string path = std::string("/") + fs->getName() + "/" + dir + "/" + cues[i];
+            load_cue(path.c_str(), &tracks);
+        }
+        expand_cues(tracks);
+    }
+    TrackProfile unscanned = TrackProfile();
+    profiles.assign(handles.size(), unscanned);
+    return handles.size();
+}
+
+/**
+ * @brief Reads the TRACK entries of a CUE sheet a line at a time
+ * @details FILE names are resolved through the hash table; entries for a file that is not indexed, or
+ * that an earlier sheet already split, are ignored.
+**/
+void LibraryIndex::load_cue(const char *path, std::vector<CueTrack> *tracks)
+{
+    sdMutex.lock();
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        sdMutex.unlock();
+        return;
+    }
+    int song = -1;              // Album file of the current FILE entry
+    bool in_track = false;
+    while (fgets(scanPath, sizeof(scanPath), fp) != NULL)
+    {
+        int len = strlen(scanPath);
+        while (len > 0 && (scanPath[len - 1] == '\n' || scanPath[len - 1] == '\r' || scanPath[len - 1] == ' '))
+        {
+            scanPath[--len] = 0;
+        }
+        const char *line = scanPath;
+        while (*line == ' ' || *line == '\t')
+        {
+            line++;
+        }
+
+        const char *text;
+        if ((text = cue_keyword(line, "FILE")) != NULL)
+        {
+            cue_field(text, scanName, sizeof(scanName));
+            const char *name = scanName;
+            for (const char *p = scanName; *p; p++)
+            {
+                if (*p == '/' || *p == '\\')
+                {
+                    name = p + 1;
+                }
+            }
+            song = find(name);
+            for (unsigned i = 0; i < tracks->size() && song >= 0; i++)
+            {
+                if ((*tracks)[i].song == song)
+                {
+                    song = -1;
+                }
+            }
+            in_track = false;
+        }
+        else if ((text = cue_keyword(line, "TRACK")) != NULL)
+        {
+            in_track = song >= 0;
+            if (in_track)
+            {
+                CueTrack track;
+                track.song = song;
+                track.number = atoi(text);
+                track.start = RANGE_END;
+                tracks->push_back(track);
+            }
+        }
+        else if (!in_track)
+        {
+            // Album TITLE, PERFORMER, REM & the like
+            continue;
+        }
+        else if ((text = cue_keyword(line, "TITLE")) != NULL)
+        {
+            cue_field(text, scanName, sizeof(scanName));
+            tracks->back().title = scanName;
+        }
+        else if ((text = cue_keyword(line, "INDEX")) != NULL)
+        {
+            // INDEX 01 mm:ss:ff marks where the track starts; INDEX 00 is the pregap of the one before
+            int index = 0;
+            int mm = 0;
+            int ss = 0;
+            int ff = 0;
+            if (sscanf(text, "%d %d:%d:%d", &index, &mm, &ss, &ff) == 4 && index == 1)
+            {
+                tracks->back().start = (mm * 60 + ss) * CUE_FRAMES_PER_SECOND + ff;
+            }
+        }
+    }
+    fclose(fp);
+    sdMutex.unlock();
+}
+
+/**
+ * @brief Replaces each split album file with its tracks, in place
+ * @details Each track runs to the start of the next one; the last runs to the end of the file. Tracks
+ * with no INDEX 01, or that do not start after the track before, are dropped.
+**/
+void LibraryIndex::expand_cues(const std::vector<CueTrack> &tracks)
+{
+    if (tracks.empty())
+    {
+        return;
+    }
+    std::vector<std::string> split_names;
+    std::vector<TrackHandle> split_handles;
+    std::vector<TrackRange> split_ranges;
+    for (unsigned song = 0; song < handles.size() && split_handles.size() < INDEX_EMPTY_SLOT; song++)
+    {
+        bool split = false;
+        for (unsigned i = 0; i < tracks.size() && split_handles.size() < INDEX_EMPTY_SLOT; i++)
+        {
+            const CueTrack &track = tracks[i];
+            if (track.song != song || track.start == RANGE_END || (split && track.start <= split_ranges.back().start))
+            {
+                continue;
+            }
+            if (split)
+            {
+                split_ranges.back().end = track.start;
+            }
+            if (track.title.empty())
+            {
+                char title[16];
+                snprintf(title, sizeof(title), "Track %02d", track.number);
+                split_names.push_back(std::string(title));
+            }
+            else
+            {
+                split_names.push_back(track.title);
+            }
+            TrackRange range = {track.start, RANGE_END};
+            split_handles.push_back(handles[song]);
+            split_ranges.push_back(range);
+            split = true;
+        }
+        if (!split)
+        {
+            split_names.push_back((*names)[song]);
+            split_handles.push_back(handles[song]);
+            split_ranges.push_back(ranges[song]);
+        }
+    }
+    names->swap(split_names);
+    handles.swap(split_handles);
+    ranges.swap(split_ranges);
+    rebuild_table();
+}
+
+/**
+ * @brief Rebuilds the name hash table, sized to stay at most half full
+**/
+void LibraryIndex::rebuild_table()
+{
+    uint32_t size = 16;
+    while (size < handles.size() * 2)
+    {
+        size <<= 1;
+    }
+    table.assign(size, INDEX_EMPTY_SLOT);
+    for (uint32_t song = 0; song < handles.size(); song++)
+    {
+        uint32_t slot = hash_name((*names)[song].c_str()) & (size - 1);
+        while (table[slot] != INDEX_EMPTY_SLOT)
+        {
+            slot = (slot + 1) & (size - 1);
+        }
+        table[slot] = song;
+    }
+}
+
+int LibraryIndex::find(const char *name) const
+{
+    if (names == NULL || table.empty())
+    {
+        return -1;
+    }
+    uint32_t mask = table.size() - 1;
+    uint32_t slot = hash_name(name) & mask;
+    while (table[slot] != INDEX_EMPTY_SLOT)
+    {
+        if (same_name((*names)[table[slot]].c_str(), name))
+        {
+            return table[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+int LibraryIndex::find(const TrackHandle &handle, int hint) const
+{
+    int count = handles.size();
+    for (int i = 0; i < count; i++)
+    {
+        int song = (hint + i) % count;
+        if (handles[song].start_cluster == handle.start_cluster && handles[song].size == handle.size)
+        {
+            return song;
+        }
+    }
+    return -1;
+}
+
+void LibraryIndex::set_handle(int song, const TrackHandle &handle)
+{
+    TrackHandle old = handles[song];
+    set_seek_points(song, NULL);
+    for (unsigned i = 0; i < handles.size(); i++)
+    {
+        if (same_handle(handles[i], old))
+        {
+            handles[i] = handle;
+        }
+    }
+}
+
+void LibraryIndex::set_profile(int song, const TrackProfile &profile)
+{
+    for (unsigned i = 0; i < handles.size(); i++)
+    {
+        if (same_handle(handles[i], handles[song]))
+        {
+            profiles[i] = profile;
+        }
+    }
+}
+
+void LibraryIndex::data_range(int song, const FMT_STRUCT &format, uint32_t data_size, uint32_t *start, uint32_t *end) const
+{
+    const TrackRange &range = ranges[song];
+    *start = cue_bytes(range.start, format);
+    *end = range.end == RANGE_END ? data_size : cue_bytes(range.end, format);
+    const TrackProfile &trim = profiles[song];
+    if (trim.flags & PROFILE_TRIMMED)
+    {
+        uint32_t audible_start = trim.trim_start * format.block_align;
+        uint32_t audible_end = trim.trim_end * format.block_align;
+        if (range.start == 0 && audible_start > *start)
+        {
+            *start = audible_start;
+        }
+        if (range.end == RANGE_END && audible_end < *end)
+        {
+            *end = audible_end;
+        }
+    }
+    if (*end > data_size)
+    {
+        *end = data_size;
+    }
+    if (*start > *end)
+    {
+        *start = *end;
+    }
+}
+
+void LibraryIndex::set_seek_points(int song, const uint32_t *clusters)
+{
+    const TrackHandle &handle = handles[song];
+    SeekTable *slot = NULL;
+    for (int i = 0; i < SEEK_TABLES; i++)
+    {
+        if (seek_tables[i].handle.start_cluster != 0 && same_handle(seek_tables[i].handle, handle))
+        {
+            slot = &seek_tables[i];
+            break;
+        }
+        if (slot == NULL && seek_tables[i].handle.start_cluster == 0)
+        {
+            slot = &seek_tables[i];
+        }
+    }
+    if (slot == NULL)
+    {
+        return;
+    }
+    // A reader on another thread matches the handle before the clusters, so it is written last
+    slot->handle.start_cluster = 0;
+    if (clusters != NULL && handle.start_cluster != 0)
+    {
+        memcpy(slot->clusters, clusters, sizeof(slot->clusters));
+        slot->handle.size = handle.size;
+        slot->handle.start_cluster = handle.start_cluster;
+    }
+}
+
+const uint32_t *LibraryIndex::seek_points(int song) const
+{
+    for (int i = 0; i < SEEK_TABLES; i++)
+    {
+        if (seek_tables[i].handle.start_cluster != 0 && same_handle(seek_tables[i].handle, handles[song]))
+        {
+            return seek_tables[i].clusters;
+        }
+    }
+    return NULL;
+}
+
+uint32_t LibraryIndex::seek_sector(uint32_t file_size, int point) const
+{
+    uint32_t cluster_sectors = fs->_fs.csize;
+    uint32_t sectors = (file_size + SECTOR_SIZE - 1) / SECTOR_SIZE;
+    uint32_t sector = (uint32_t)((uint64_t)sectors * point / SEEK_POINTS);
+    return sector - sector % cluster_sectors;
+}
+
+bool LibraryIndex::seek_point(int song, uint32_t file_sector, uint32_t *point_sector, uint32_t *cluster) const
+{
+    const TrackHandle &handle = handles[song];
+    const TrackProfile &profile = profiles[song];
+    uint32_t cluster_sectors = fs->_fs.csize;
+    if (cluster_sectors == 0 || file_sector >= (handle.size + SECTOR_SIZE - 1) / SECTOR_SIZE)
+    {
+        return false;
+    }
+    if ((profile.flags & PROFILE_SCANNED) && profile.fragments == 1)
+    {
+        *point_sector = file_sector - file_sector % cluster_sectors;
+        *cluster = handle.start_cluster + file_sector / cluster_sectors;
+        return *point_sector > 0;
+    }
+    const uint32_t *clusters = seek_points(song);
+    for (int i = SEEK_POINTS - 1; i > 0 && clusters != NULL; i--)
+    {
+        uint32_t sector = seek_sector(handle.size, i);
+        if (sector <= file_sector && sector > 0 && clusters[i] != 0)
+        {
+            *point_sector = sector;
+            *cluster = clusters[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LibraryIndex::continues(int song, int next) const
+{
+    return next != song && ranges[song].end != RANGE_END && ranges[next].start == ranges[song].end
+        && same_handle(handles[song], handles[next]);
+}
+
+int LibraryIndex::load_playlist(const char *path)
+{
+    std::vector<int> order;
+    sdMutex.lock();
+    FILE *fp = fopen(path, "r");
+    if (fp != NULL)
+    {
+        while (fgets(scanPath, sizeof(scanPath), fp) != NULL)
+        {
+            // Strip the line ending & skip comments such as #EXTM3U
+            int len = strlen(scanPath);
+            while (len > 0 && (scanPath[len - 1] == '\n' || scanPath[len - 1] == '\r' || scanPath[len - 1] == ' '))
+            {
+                scanPath[--len] = 0;
+            }
+            if (len == 0 || scanPath[0] == '#')
+            {
+                continue;
+            }
+            const char *name = scanPath;
+            for (const char *p = scanPath; *p; p++)
+            {
+                if (*p == '/' || *p == '\\')
+                {
+                    name = p + 1;
+                }
+            }
+            int song = find(name);
+            if (song >= 0 && order.size() < INDEX_EMPTY_SLOT)
+            {
+                order.push_back(song);
+            }
+        }
+        fclose(fp);
+    }
+    sdMutex.unlock();
+    if (order.empty())
+    {
+        return 0;
+    }
+
+    std::vector<std::string> ordered_names;
+    std::vector<TrackHandle> ordered_handles;
+    std::vector<TrackProfile> ordered_profiles;
+    std::vector<TrackRange> ordered_ranges;
+    for (unsigned i = 0; i < order.size(); i++)
+    {
+        ordered_names.push_back((*names)[order[i]]);
+        ordered_handles.push_back(handles[order[i]]);
+        ordered_profiles.push_back(profiles[order[i]]);
+        ordered_ranges.push_back(ranges[order[i]]);
+    }
+    names->swap(ordered_names);
+    handles.swap(ordered_handles);
+    profiles.swap(ordered_profiles);
+    ranges.swap(ordered_ranges);
+    rebuild_table();
+    return handles.size();
+}
@@ -0,0 +1,196 @@
+/**
+ * @file LibraryIndex.h
+ * @brief Index of the songs on the card, built once at boot
+ * @details Each song is stored with a TrackHandle (start cluster & size) so it can be opened without a
+ * path lookup, and names resolve to song numbers through a hash table, which is how playlists are
+ * matched against the library. A CUE sheet splits a single-file album into virtual tracks, each a
+ * range of the same file, so consecutive tracks play from one open stream without a gap.
+**/
+#ifndef LIBRARYINDEX_H
+#define LIBRARYINDEX_H
+
+#include "mbed.h"
+#include "TrackStream.h"
+#include <string>
+#include <vector>
+
+// Marks an empty slot of the name hash table
+#define INDEX_EMPTY_SLOT 0xFFFF
+
+// TrackProfile flags
+#define PROFILE_SCANNED     0x01    // The whole file has been read
+#define PROFILE_HEADER_OK   0x02    // The WAV header parsed & its format can be played
+#define PROFILE_UNDERRUN    0x04    // The card cannot keep up with the data rate of the file
+#define PROFILE_READ_ERROR  0x08    // A sector of the file could not be read
+#define PROFILE_NO_DEFRAG   0x10    // The file could not be made contiguous; not retried until reboot
+#define PROFILE_TRIMMED     0x20    // trim_start & trim_end bound the audible part of the file
+
+// End of a TrackRange that runs to the end of the file's data
+#define RANGE_END 0xFFFFFFFF
+// CD frames per second, the unit of CUE sheet INDEX times
+#define CUE_FRAMES_PER_SECOND 75
+// Evenly spaced points of a file whose cluster is kept, so a seek maps the file from the nearest one
+#define SEEK_POINTS 8
+// Fragmented files whose seek points are kept; contiguous files are mapped without them
+#define SEEK_TABLES 32
+
+/**
+ * @brief Read behaviour of one file, measured by the media scrubber
+**/
+struct TrackProfile
+{
+    uint32_t worst_us;      // Slowest sector read
+    uint32_t total_ms;      // Time to read the whole file
+    uint16_t fragments;     // Runs of contiguous sectors in the file
+    uint8_t flags;          // PROFILE_ flags
+    uint8_t reserved;
+    uint32_t trim_start;    // First frame after the leading silence
+    uint32_t trim_end;      // Frame after the last one before the trailing silence
+};
+
+/**
+ * @brief Seek points of one fragmented file
+**/
+struct SeekTable
+{
+    TrackHandle handle;                 // Start cluster 0 while the slot is free
+    uint32_t clusters[SEEK_POINTS];     // Cluster at each seek point, 0 if not known
+};
+
+/**
+ * @brief Part of a file's sample data a song plays, in CD frames from the start of the data
+ * @details Whole files are {0, RANGE_END}; virtual tracks from a CUE sheet share their album's handle.
+**/
+struct TrackRange
+{
+    uint32_t start;
+    uint32_t end;
+};
+
+struct CueTrack;
+
+/**
+ * @brief Song names & handles in play order, with a name lookup table
+**/
+class LibraryIndex
+{
+public:
+    LibraryIndex(SDFileSystem *fs);
+
+    /**
+     * @brief Scans a directory & indexes every file in it
+     * @details A CUE sheet in the directory replaces the album file it names with one virtual track
+     * per TRACK entry, named after its TITLE, at the position the album held.
+     * @param dir Directory relative to the root of the file system, e.g. "myMusic"
+     * @param names Filled with the file names in directory order; kept for name lookups
+     * @return Number of songs indexed
+    **/
+    int build(const char *dir, std::vector<std::string> *names);
+
+    /**
+     * @brief Reorders the library to follow an M3U playlist
+     * @details Each non-comment line is reduced to its file name and resolved through the hash table.
+     * Lines that name no indexed song are skipped. The library is left alone if nothing resolves.
+     * @param path stdio path of the playlist, e.g. "/sd/playlist.m3u"
+     * @return Number of songs in the new order, or 0 if the playlist was missing or empty
+    **/
+    int load_playlist(const char *path);
+
+    /**
+     * @brief Looks up a song by file name, ignoring case
+     * @return Song number, or -1 if no song has that name
+    **/
+    int find(const char *name) const;
+
+    int count() const { return handles.size(); }
+    const TrackHandle &handle(int song) const { return handles[song]; }
+    const std::string &name(int song) const { return (*names)[song]; }
+    const char *directory() const { return dir_name.c_str(); }
+    const TrackProfile &profile(int song) const { return profiles[song]; }
+    const TrackRange &range(int song) const { return ranges[song]; }
+
+    /**
+     * @brief Sets the handle of a song & of every virtual track of the same file
+     * @details Seek points of the old handle name its old clusters, so they are dropped.
+    **/
+    void set_handle(int song, const TrackHandle &handle);
+
+    /**
+     * @brief Sets the profile of a song & of every virtual track of the same file
+    **/
+    void set_profile(int song, const TrackProfile &profile);
+
+    /**
+     * @brief Converts the range of a song to bytes of sample data
+     * @details The leading & trailing silence found by the scrubber is cut from the start & end of
+     * the file, but not from the joins between the tracks of a CUE sheet.
+     * @param format Parsed format of the song's file
+     * @param data_size Bytes of sample data in the file
+     * @param start Set to the first byte played, from the start of the data
+     * @param end Set to the byte after the last one played
+    **/
+    void data_range(int song, const FMT_STRUCT &format, uint32_t data_size, uint32_t *start, uint32_t *end) const;
+
+    /**
+     * @brief Keeps the seek points of a song's file, or drops them
+     * @details Only fragmented files need them, so they are kept aside from the profiles in
+     * SEEK_TABLES slots; once every slot is taken, further files seek by walking their chain.
+     * @param clusters Cluster at each seek point, or NULL to drop the file's seek points
+    **/
+    void set_seek_points(int song, const uint32_t *clusters);
+
+    /**
+     * @brief Seek points of a song's file, NULL if none are kept
+    **/
+    const uint32_t *seek_points(int song) const;
+
+    /**
+     * @brief First file sector of a seek point, on a cluster boundary
+     * @param file_size Size of the file in bytes
+     * @param point Seek point, 0 to SEEK_POINTS - 1
+    **/
+    uint32_t seek_sector(uint32_t file_size, int point) const;
+
+    /**
+     * @brief Finds the nearest place at or before a file sector where the song's cluster chain is known
+     * @details A contiguous file is mapped by arithmetic; a fragmented one uses the seek points found
+     * by the scrubber. Passing the result to TrackStream::seek_hint lets a read far into the file
+     * skip walking the chain from its start.
+     * @param point_sector Set to the first file sector of the cluster found
+     * @param cluster Set to that cluster
+     * @return false if only the start of the file is known
+    **/
+    bool seek_point(int song, uint32_t file_sector, uint32_t *point_sector, uint32_t *cluster) const;
+
+    /**
+     * @brief Checks whether one song picks up in the same file exactly where another ends
+    **/
+    bool continues(int song, int next) const;
+
+    /**
+     * @brief Looks up a song by its handle
+     * @param hint Song to check first
+     * @return Song number, or -1 if no song has that handle
+    **/
+    int find(const TrackHandle &handle, int hint) const;
+
+private:
+    bool locate_entry(uint32_t dir_cluster, int entry, const FILINFO &info, TrackHandle *handle);
+    void rebuild_table();
+    void load_cue(const char *path, std::vector<CueTrack> *tracks);
+    void expand_cues(const std::vector<CueTrack> &tracks);
+
+    SDFileSystem *fs;
+    std::vector<std::string> *names;
+    std::string dir_name;               // Directory the songs were indexed from
+    std::vector<TrackHandle> handles;
+    std::vector<TrackProfile> profiles;
+    std::vector<TrackRange> ranges;
+    std::vector<uint16_t> table;        // Song numbers by name hash, open addressing
+    SeekTable seek_tables[SEEK_TABLES];
+    TrackStream dir_stream;             // Cluster-mapped reader of the directory being scanned
+    uint32_t dir_sector;                // Directory sector held in sector_buf
+    uint8_t sector_buf[SECTOR_SIZE];
+};
+
+#endif
@@ -0,0 +1,315 @@
+/**
+ * @file MediaScrubber.cpp
+ * @brief Reads every song on the card while the player is idle & profiles how it reads
+**/
+#include "MediaScrubber.h"
+#include "StreamPlayer.h"
+#include "us_ticker_api.h"
+
+MediaScrubber::MediaScrubber(SDFileSystem *fs, LibraryIndex *library)
+{
+    this->fs = fs;
+    this->library = library;
+    path = NULL;
+    song = -1;
+    cursor = 0;
+    finished_song = -1;
+    sector = 0;
+    sectors = 0;
+    total_us = 0;
+    memset(&result, 0, sizeof(result));
+    scanned_count = 0;
+    decoding = false;
+    loud_seen = false;
+    next_point = 0;
+    memset(seek_clusters, 0, sizeof(seek_clusters));
+}
+
+bool MediaScrubber::flagged(const TrackProfile &profile)
+{
+    return (profile.flags & PROFILE_SCANNED) &&
+           (!(profile.flags & PROFILE_HEADER_OK) || (profile.flags & (PROFILE_UNDERRUN | PROFILE_READ_ERROR)));
+}
+
+int MediaScrubber::load(const char *path)
+{
+    this->path = path;
+    int restored = 0;
+    int records = 0;
+    bool valid = false;
+    sdMutex.lock();
+    FILE *fp = fopen(path, "rb");
+    if (fp != NULL)
+    {
+        uint32_t magic = 0;
+        valid = fread(&magic, sizeof(magic), 1, fp) == 1 && magic == SCRUB_MAGIC;
+        ScrubRecord record;
+        uint32_t clusters[SEEK_POINTS];
+        int hint = 0;
+        while (valid && fread(&record, sizeof(record), 1, fp) == 1)
+        {
+            records++;
+            bool seekable = record.profile.fragments > 1;
+            if (seekable && fread(clusters, sizeof(clusters), 1, fp) != 1)
+            {
+                break;
+            }
+            int found = library->find(record.handle, hint);
+            if (found >= 0)
+            {
+                if (!(library->profile(found).flags & PROFILE_SCANNED))
+                {
+                    restored++;
+                }
+                library->set_profile(found, record.profile);
+                if (seekable)
+                {
+                    library->set_seek_points(found, clusters);
+                }
+                hint = found + 1;
+            }
+        }
+        fclose(fp);
+    }
+    // Start afresh if the file is missing or foreign; drop stale & repeated records once they pile up
+    if (!valid || records > library->count())
+    {
+        rewrite();
+    }
+    sdMutex.unlock();
+    scanned_count = restored;
+    return restored;
+}
+
+/**
+ * @brief Appends the checkpoint record of a song, with its seek points if its file is fragmented
+**/
+void MediaScrubber::write_record(FILE *fp, int song)
+{
+    ScrubRecord record = {library->handle(song), library->profile(song)};
+    fwrite(&record, sizeof(record), 1, fp);
+    if (record.profile.fragments > 1)
+    {
+        uint32_t clusters[SEEK_POINTS];
+        const uint32_t *kept = library->seek_points(song);
+        if (kept != NULL)
+        {
+            memcpy(clusters, kept, sizeof(clusters));
+        }
+        else
+        {
+            memset(clusters, 0, sizeof(clusters));
+        }
+        fwrite(clusters, sizeof(clusters), 1, fp);
+    }
+}
+
+void MediaScrubber::checkpoint(int song)
+{
+    if (path == NULL)
+    {
+        return;
+    }
+    sdMutex.lock();
+    FILE *fp = fopen(path, "ab");
+    if (fp != NULL)
+    {
+        write_record(fp, song);
+        fclose(fp);
+    }
+    sdMutex.unlock();
+}
+
+/**
+ * @brief Writes the checkpoint file from scratch with the profiles of every scanned song
+**/
+void MediaScrubber::rewrite()
+{
+    sdMutex.lock();
+    FILE *fp = fopen(path, "wb");
+    if (fp != NULL)
+    {
+        uint32_t magic = SCRUB_MAGIC;
+        fwrite(&magic, sizeof(magic), 1, fp);
+        for (int i = 0; i < library->count(); i++)
+        {
+            if (library->profile(i).flags & PROFILE_SCANNED)
+            {
+                write_record(fp, i);
+            }
+        }
+        fclose(fp);
+    }
+    sdMutex.unlock();
+}
+
+/**
+ * @brief Opens a song & checks its header before its sectors are read
+**/
+void MediaScrubber::begin(int song)
+{
+    this->song = song;
+    memset(&result, 0, sizeof(result));
+    total_us = 0;
+    sector = 0;
+    sectors = 0;
+    decoding = false;
+    loud_seen = false;
+    next_point = 0;
+    memset(seek_clusters, 0, sizeof(seek_clusters));
+    if (!stream.open(fs, library->handle(song)))
+    {
+        result.flags |= PROFILE_READ_ERROR;
+        return;
+    }
+    if (stream.parse_header(buffer) && open_decoder(stream.format, &decoder))
+    {
+        result.flags |= PROFILE_HEADER_OK;
+        decoding = true;
+    }
+    sectors = (stream.file_size + SECTOR_SIZE - 1) / SECTOR_SIZE;
+}
+
+/**
+ * @brief Decodes the whole frames of a data sector & moves the silence bounds to its loud blocks
+ * @details Frames split across two sectors are not examined, so a loud one at either end of the
+ * sound is missed & that bound moves in by a frame, too little to hear.
+**/
+void MediaScrubber::measure_silence(uint32_t file_sector)
+{
+    uint32_t align = stream.format.block_align;
+    uint32_t data_end = stream.data_start + stream.data_size;
+    uint32_t lo = file_sector * SECTOR_SIZE;
+    uint32_t hi = lo + SECTOR_SIZE;
+    if (hi > data_end)
+    {
+        hi = data_end;
+    }
+    if (lo < stream.data_start)
+    {
+        lo = stream.data_start;
+    }
+    if (lo >= hi)
+    {
+        return;
+    }
+    // First whole frame starting in this sector
+    uint32_t frame = (lo - stream.data_start + align - 1) / align;
+    uint32_t pos = stream.data_start + frame * align;
+    while (pos + align <= hi)
+    {
+        int frames = (hi - pos) / align;
+        if (frames > SILENCE_BLOCK_FRAMES)
+        {
+            frames = SILENCE_BLOCK_FRAMES;
+        }
+        decode_block(decoder, buffer + pos - file_sector * SECTOR_SIZE, frames, block);
+        bool loud = false;
+        for (int i = 0; i < frames && !loud; i++)
+        {
+            int level = (int)block[i] - 32768;
+            loud = level > SILENCE_THRESHOLD || level < -SILENCE_THRESHOLD;
+        }
+        if (loud)
+        {
+            if (!loud_seen)
+            {
+                result.trim_start = frame;
+                loud_seen = true;
+            }
+            result.trim_end = frame + frames;
+        }
+        frame += frames;
+        pos += frames * align;
+    }
+}
+
+/**
+ * @brief Stores the profile of the song just read in the index & the checkpoint file
+ * @details A file is flagged for underrun if one sector took longer than the player's sample ring
+ * lasts, or if reading the whole file took longer than playing it.
+**/
+void MediaScrubber::finish()
+{
+    result.flags |= PROFILE_SCANNED;
+    result.fragments = stream.fragment_count() > 0xFFFF ? 0xFFFF : stream.fragment_count();
+    result.total_ms = (uint32_t)(total_us / 1000);
+    if ((result.flags & PROFILE_HEADER_OK) && !(result.flags & PROFILE_READ_ERROR))
+    {
+        const FMT_STRUCT &format = stream.format;
+        uint64_t slack_us = (uint64_t)PLAYER_RING_SIZE * 1000000 / format.sample_rate;
+        uint64_t play_us = (uint64_t)stream.data_size * 1000000 / ((uint64_t)format.sample_rate * format.block_align);
+        if (result.worst_us > slack_us || total_us > play_us)
+        {
+            result.flags |= PROFILE_UNDERRUN;
+        }
+        // A file with no loud block at all is left to play as it is
+        if (loud_seen)
+        {
+            result.flags |= PROFILE_TRIMMED;
+        }
+    }
+    stream.close();
+    library->set_profile(song, result);
+    library->set_seek_points(song, result.fragments > 1 ? seek_clusters : NULL);
+    scanned_count++;
+
+    checkpoint(song);
+    finished_song = song;
+    cursor = song + 1;
+    song = -1;
+}
+
+bool MediaScrubber::step()
+{
+    finished_song = -1;
+    int count = library->count();
+    if (song < 0)
+    {
+        // Pick the next song without a profile
+        for (int i = 0; i < count && song < 0; i++)
+        {
+            int next = (cursor + i) % count;
+            if (!(library->profile(next).flags & PROFILE_SCANNED))
+            {
+                begin(next);
+            }
+        }
+        if (song < 0)
+        {
+            return false;
+        }
+    }
+
+    for (int i = 0; i < SCRUB_STEP_SECTORS && sector < sectors; i++)
+    {
+        uint32_t start = us_ticker_read();
+        bool ok = stream.read_sector(sector, buffer);
+        uint32_t elapsed = us_ticker_read() - start;
+        if (!ok)
+        {
+            result.flags |= PROFILE_READ_ERROR;
+            break;
+        }
+        total_us += elapsed;
+        if (elapsed > result.worst_us)
+        {
+            result.worst_us = elapsed;
+        }
+        if (decoding)
+        {
+            measure_silence(sector);
+        }
+        // Note the cluster at each seek point passed, for seeks into the file later
+        while (next_point < SEEK_POINTS && library->seek_sector(stream.file_size, next_point) <= sector)
+        {
+            seek_clusters[next_point++] = stream.cluster(sector - sector % fs->_fs.csize);
+        }
+        sector++;
+    }
+    if (sector >= sectors || (result.flags & PROFILE_READ_ERROR))
+    {
+        finish();
+    }
+    return true;
+}
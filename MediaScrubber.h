@@ -0,0 +1,106 @@
+/**
+ * @file MediaScrubber.h
+ * @brief Reads every song on the card while the player is idle & profiles how it reads
+ * @details Each file is read end to end through its cluster link map. The fragment count, the slowest
+ * sector read and whether the header can be played are stored in the library index, and files the card
+ * cannot stream fast enough are flagged. Playable files are also decoded as they are read to find the
+ * digital silence at either end, so the player can skip it, and the cluster at evenly spaced seek points
+ * is noted, so a seek can map the file from there. Finished files are checkpointed to the card so a scan resumes
+ * where it left off after a reboot.
+**/
+#ifndef MEDIASCRUBBER_H
+#define MEDIASCRUBBER_H
+
+#include "mbed.h"
+#include "rtos.h"
+#include "TrackStream.h"
+#include "LibraryIndex.h"
+#include "Codec.h"
+
+// Sectors read per step, bounding how long the card is held at a time
+#define SCRUB_STEP_SECTORS 16
+// Marks a checkpoint file written by this version ("SCR4")
+#define SCRUB_MAGIC 0x34524353
+// Frames decoded at a time when looking for silence; a block is silent if every sample is
+#define SILENCE_BLOCK_FRAMES 64
+// Largest distance from the DAC midpoint still counted as silence, about -54 dBFS
+#define SILENCE_THRESHOLD 64
+
+/**
+ * @brief Checkpoint record of one file; that of a fragmented file is followed by its SEEK_POINTS clusters
+**/
+struct ScrubRecord
+{
+    TrackHandle handle;
+    TrackProfile profile;
+};
+
+/**
+ * @brief Background profiler of the library, run a few sectors at a time
+**/
+class MediaScrubber
+{
+public:
+    MediaScrubber(SDFileSystem *fs, LibraryIndex *library);
+
+    /**
+     * @brief Restores the profiles of a previous scan from a checkpoint file
+     * @details Records are matched to songs by handle, so renamed or reordered songs keep their
+     * profile and edited files are scanned again. The file is created, or compacted, as needed.
+     * @param path stdio path of the checkpoint, e.g. "/sd/scrub.dat"
+     * @return Number of songs whose profile was restored
+    **/
+    int load(const char *path);
+
+    /**
+     * @brief Reads the next few sectors of the scan
+     * @return false once every song has been profiled
+    **/
+    bool step();
+
+    /**
+     * @brief Song whose profile the last step completed, -1 if it completed none
+    **/
+    int finished() const { return finished_song; }
+
+    /**
+     * @brief Appends a song's profile to the checkpoint file, e.g. after its file was given a new handle
+    **/
+    void checkpoint(int song);
+
+    /**
+     * @brief Checks whether a profile shows a file that will not play cleanly
+    **/
+    static bool flagged(const TrackProfile &profile);
+
+    unsigned scanned() const { return scanned_count; }
+
+private:
+    void begin(int song);
+    void finish();
+    void rewrite();
+    void write_record(FILE *fp, int song);
+    void measure_silence(uint32_t file_sector);
+
+    SDFileSystem *fs;
+    LibraryIndex *library;
+    const char *path;
+    int song;               // Song being read, -1 between songs
+    int cursor;             // Song to try next
+    int finished_song;
+    TrackStream stream;
+    uint32_t sector;        // Next file sector to read
+    uint32_t sectors;       // Sectors in the file
+    uint64_t total_us;
+    TrackProfile result;
+    Decoder decoder;        // Set when the header parsed, to measure the silence
+    bool decoding;
+    bool loud_seen;         // A block above the silence threshold has been found
+    int next_point;         // Seek point whose cluster is noted next
+    uint32_t seek_clusters[SEEK_POINTS];
+    uint16_t block[SILENCE_BLOCK_FRAMES];
+    unsigned scanned_count;
+    uint8_t buffer[SECTOR_SIZE];
+};
+
+#endif
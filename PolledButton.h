@@ -0,0 +1,61 @@
+/**
+ * @file PolledButton.h
+ * @brief PinDetect debounced from a timer service job instead of a Ticker of its own
+ * @details PinDetect samples its pin from a per-button Ticker, so every button adds an event to the
+ * us_ticker queue the sample clock runs from. A PolledButton is sampled by calling sample() at the
+ * same period instead, so all the buttons share one job. setSampleFrequency() must not be called.
+ * Each change is timestamped at the sample that first saw it, before it has been debounced.
+**/
+#ifndef POLLEDBUTTON_H
+#define POLLEDBUTTON_H
+
+#include "mbed.h"
+#include "PinDetect.h"
+#include "us_ticker_api.h"
+
+// Time between samples of the buttons; PinDetect's own default
+#define BUTTON_SAMPLE_MS 20
+
+/**
+ * @brief Debounced pushbutton sampled by its owner
+**/
+class PolledButton : public PinDetect
+{
+public:
+    /**
+     * @param mode Pin mode, set before the idle state is read
+    **/
+    PolledButton(PinName pin, PinMode mode) : PinDetect(pin, mode), edge_us(0), changing(false) {}
+
+    /**
+     * @brief Samples the pin once, calling the attached callbacks on a debounced change
+    **/
+    void sample()
+    {
+        // The first sample that differs from the settled state is when the press or release began
+        if (_in->read() != _prevState)
+        {
+            if (!changing)
+            {
+                edge_us = us_ticker_read();
+                changing = true;
+            }
+        }
+        else
+        {
+            changing = false;
+        }
+        isr();
+    }
+
+    /**
+     * @brief us_ticker time the change the callbacks are reporting was first sampled
+    **/
+    uint32_t edge() const { return edge_us; }
+
+private:
+    uint32_t edge_us;
+    bool changing;
+};
+
+#endif
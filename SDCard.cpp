@@ -0,0 +1,403 @@
+/**
+ * @file SDCard.cpp
+ * @brief SDFileSystem with the extra card commands the player needs
+**/
+#include "SDCard.h"
+#include "us_ticker_api.h"
+#include <string.h>
+
+// Data tokens of a multi-block write
+#define TOKEN_MULTI_WRITE 0xFC
+#define TOKEN_STOP_TRAN   0xFD
+// Data token starting a block the card sends
+#define TOKEN_START_BLOCK 0xFE
+
+// Commands reading the card's registers
+#define CMD_SEND_CSD 9
+#define CMD_SEND_CID 10
+
+// SPI clocks asked for by calibration, fastest first; 25 MHz is the most an SD card allows. The SSP
+// runs at the nearest division of its clock below, so neighbours may give the same rate
+static const uint32_t calibrationClocks[] = {25000000, 20000000, 16000000, 12000000, 8000000, 4000000};
+#define NUM_CALIBRATION_CLOCKS (sizeof(calibrationClocks) / sizeof(calibrationClocks[0]))
+// Blocks spread over the card that must read cleanly at a clock, & times each is read
+#define CAL_BLOCKS 4
+#define CAL_PASSES 8
+// Reads timed at the chosen clock, once consecutive & once scattered over the card
+#define CAL_READS 64
+// Play time of one block of 44.1 kHz 16 bit stereo audio
+#define BLOCK_PLAY_US 2902
+
+// CRC16-CCITT of each nibble value, for the CRC the card sends after a data block
+static const uint16_t crcNibbles[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+static uint16_t crc16(const uint8_t *data, uint32_t length)
+{
+    uint16_t crc = 0;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        crc = (crc << 4) ^ crcNibbles[(crc >> 12) ^ (data[i] >> 4)];
+        crc = (crc << 4) ^ crcNibbles[(crc >> 12) ^ (data[i] & 0x0F)];
+    }
+    return crc;
+}
+
+static void sort(uint32_t *values, int count)
+{
+    for (int i = 1; i < count; i++)
+    {
+        uint32_t value = values[i];
+        int j = i;
+        for (; j > 0 && values[j - 1] > value; j--)
+        {
+            values[j] = values[j - 1];
+        }
+        values[j] = value;
+    }
+}
+
+static uint16_t clamp16(uint32_t value)
+{
+    return value > 0xFFFF ? 0xFFFF : value;
+}
+
+SDCard::SDCard(PinName mosi, PinName miso, PinName sclk, PinName cs, const char *name) :
+    SDFileSystem(mosi, miso, sclk, cs, name)
+{
+    memset((void *)latency_hist, 0, sizeof(latency_hist));
+    memset((void *)latency_max, 0, sizeof(latency_max));
+    read_count = 0;
+    memset(&card, 0, sizeof(card));
+    card.spi_hz = SD_SAFE_HZ;
+    card_calibrated = false;
+    profile_dirty = false;
+    error_count = 0;
+}
+
+/**
+ * @brief Receives a data block after a command, checking its CRC
+ * @return false if the card sent no block in time or the CRC did not match
+**/
+bool SDCard::read_data(uint8_t *buffer, uint32_t length)
+{
+    _cs = 0;
+    uint32_t start = us_ticker_read();
+    int token = 0xFF;
+    while (token == 0xFF && us_ticker_read() - start < SD_READ_TIMEOUT_US)
+    {
+        token = _spi.write(0xFF);
+    }
+    if (token != TOKEN_START_BLOCK)
+    {
+        _cs = 1;
+        _spi.write(0xFF);
+        return false;
+    }
+    for (uint32_t i = 0; i < length; i++)
+    {
+        buffer[i] = _spi.write(0xFF);
+    }
+    uint16_t crc = _spi.write(0xFF) << 8;
+    crc |= _spi.write(0xFF);
+    _cs = 1;
+    _spi.write(0xFF);
+    return crc == crc16(buffer, length);
+}
+
+/**
+ * @brief Reads one block once, without timing or retries
+**/
+bool SDCard::read_block(uint8_t *buffer, uint32_t block_number)
+{
+    // set read address for single block (CMD17)
+    if (_cmd(17, block_number * cdv) != 0)
+    {
+        return false;
+    }
+    return read_data(buffer, 512);
+}
+
+/**
+ * @brief Reads the 16 byte CID or CSD register
+**/
+bool SDCard::read_register(int command, uint8_t *reg)
+{
+    if (_cmdx(command, 0) != 0)
+    {
+        _cs = 1;
+        _spi.write(0xFF);
+        return false;
+    }
+    return read_data(reg, 16);
+}
+
+/**
+ * @brief Counts a failed read; every SD_ERROR_STEP failures the clock drops a quarter, & the card is
+ * marked to be calibrated again at the next mount
+**/
+void SDCard::read_failed()
+{
+    error_count++;
+    if (card.magic == 0)
+    {
+        return;
+    }
+    if (card.errors < 0xFFFF)
+    {
+        card.errors++;
+    }
+    card.flags |= CARD_RECALIBRATE;
+    profile_dirty = true;
+    if (card.errors % SD_ERROR_STEP == 0 && card.spi_hz > SD_SAFE_HZ)
+    {
+        card.spi_hz = card.spi_hz * 3 / 4 > SD_SAFE_HZ ? card.spi_hz * 3 / 4 : SD_SAFE_HZ;
+        _spi.frequency(card.spi_hz);
+    }
+}
+
+/**
+ * @brief Times CAL_READS reads of blocks a stride apart
+**/
+void SDCard::time_reads(uint8_t *buffer, uint32_t first, uint32_t stride, uint32_t *times)
+{
+    for (int i = 0; i < CAL_READS; i++)
+    {
+        uint32_t start = us_ticker_read();
+        read_block(buffer, first + i * stride);
+        times[i] = us_ticker_read() - start;
+    }
+}
+
+/**
+ * @brief Finds the fastest clock the card reads cleanly at, then measures its read latency there
+ * @details Takes a second or two on a slow card, once per card.
+**/
+void SDCard::calibrate()
+{
+    uint8_t buffer[512];
+    uint32_t sectors = (uint32_t)_sectors;
+    uint32_t tried_hz = 0;
+    card.spi_hz = SD_SAFE_HZ;
+    for (unsigned c = 0; c < NUM_CALIBRATION_CLOCKS; c++)
+    {
+        _spi.frequency(calibrationClocks[c]);
+        // Profile the clock the bus runs at, & try each divider once
+        uint32_t actual_hz = spi_hz();
+        if (actual_hz == tried_hz)
+        {
+            continue;
+        }
+        tried_hz = actual_hz;
+        bool clean = true;
+        for (int pass = 0; pass < CAL_PASSES && clean; pass++)
+        {
+            for (int b = 0; b < CAL_BLOCKS && clean; b++)
+            {
+                clean = read_block(buffer, sectors / CAL_BLOCKS * b);
+            }
+        }
+        if (clean)
+        {
+            card.spi_hz = actual_hz;
+            break;
+        }
+    }
+    _spi.frequency(card.spi_hz);
+
+    // Songs are mostly read a block after another; scattered reads stand for seeks & the FAT
+    uint32_t times[2 * CAL_READS];
+    time_reads(buffer, 0, 1, times);
+    time_reads(buffer, 0, sectors / CAL_READS, times + CAL_READS);
+    sort(times, CAL_READS);
+    sort(times + CAL_READS, CAL_READS);
+    if (times[CAL_READS / 2] * 4 < times[CAL_READS + CAL_READS / 2] * 3)
+    {
+        card.flags |= CARD_SEQUENTIAL;
+    }
+    sort(times, 2 * CAL_READS);
+    uint32_t p99_us = times[(2 * CAL_READS * 99 + 99) / 100 - 1];
+    card.p50_us = clamp16(times[CAL_READS]);
+    card.p99_us = clamp16(p99_us);
+    card.max_us = clamp16(times[2 * CAL_READS - 1]);
+    card.read_ahead = p99_us / BLOCK_PLAY_US + 1;
+}
+
+int SDCard::disk_initialize()
+{
+    int err = SDFileSystem::disk_initialize();
+    if (err)
+    {
+        return err;
+    }
+    // Without its registers the card keeps the library's clock & is not profiled
+    uint8_t cid[16];
+    uint8_t csd[16];
+    _spi.frequency(SD_SAFE_HZ);
+    if (!read_register(CMD_SEND_CID, cid) || !read_register(CMD_SEND_CSD, csd))
+    {
+        _spi.frequency(15000000);
+        return 0;
+    }
+    CardProfile stored;
+    if (profiles.find(cid, csd, &stored) && !(stored.flags & CARD_RECALIBRATE))
+    {
+        card = stored;
+    }
+    else
+    {
+        memset(&card, 0, sizeof(card));
+        card.magic = CARD_PROFILE_MAGIC;
+        memcpy(card.cid, cid, sizeof(card.cid));
+        memcpy(card.csd, csd, sizeof(card.csd));
+        card.flags = cdv == 1 ? CARD_HIGH_CAPACITY : 0;
+        calibrate();
+        card_calibrated = true;
+        profile_dirty = true;
+    }
+    _spi.frequency(card.spi_hz);
+    return 0;
+}
+
+FileHandle *SDCard::open(const char *name, int flags)
+{
+    PooledFile *file = file_pool.claim();
+    if (file == NULL)
+    {
+        return SDFileSystem::open(name, flags);
+    }
+    if (!file->open(_fsid, name, flags))
+    {
+        file_pool.release(file);
+        return NULL;
+    }
+    return file;
+}
+
+bool SDCard::save_profile()
+{
+    if (!profile_dirty)
+    {
+        return false;
+    }
+    profile_dirty = false;
+    return profiles.save(card);
+}
+
+/**
+ * @details Each try checks the block's CRC; failed tries count towards lowering the clock.
+**/
+int SDCard::disk_read(uint8_t *buffer, uint64_t block_number)
+{
+    uint32_t start = us_ticker_read();
+    bool ok = false;
+    for (int i = 0; i < SD_READ_TRIES && !ok; i++)
+    {
+        ok = read_block(buffer, block_number);
+        if (!ok)
+        {
+            read_failed();
+        }
+    }
+    int err = ok ? 0 : 1;
+    uint32_t elapsed = us_ticker_read() - start;
+    int bucket = 0;
+    while (bucket < SD_LATENCY_BUCKETS - 1 && (elapsed >> (bucket + 1)) != 0)
+    {
+        bucket++;
+    }
+    read_count++;
+    for (int w = 0; w < SD_LATENCY_WINDOWS; w++)
+    {
+        latency_hist[w][bucket]++;
+        if (elapsed > latency_max[w])
+        {
+            latency_max[w] = elapsed;
+        }
+    }
+    return err;
+}
+
+uint32_t SDCard::spi_hz() const
+{
+    // PCLKSEL0 bits 21:20 divide CCLK by 4, 1, 2 or 8
+    static const uint8_t pclkDividers[4] = {4, 1, 2, 8};
+    uint32_t pclk = SystemCoreClock / pclkDividers[(LPC_SC->PCLKSEL0 >> 20) & 3];
+    uint32_t scr = (LPC_SSP1->CR0 >> 8) & 0xFF;
+    uint32_t cpsr = LPC_SSP1->CPSR & 0xFF;
+    return cpsr ? pclk / (cpsr * (scr + 1)) : 0;
+}
+
+uint32_t SDCard::read_latency(int window, unsigned percent, uint32_t *max_us)
+{
+    uint32_t hist[SD_LATENCY_BUCKETS];
+    __disable_irq();
+    memcpy(hist, (const void *)latency_hist[window], sizeof(hist));
+    memset((void *)latency_hist[window], 0, sizeof(hist));
+    *max_us = latency_max[window];
+    latency_max[window] = 0;
+    __enable_irq();
+
+    uint32_t total = 0;
+    for (int i = 0; i < SD_LATENCY_BUCKETS; i++)
+    {
+        total += hist[i];
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+    // Reads at or below the percentile, rounded up
+    uint32_t wanted = (total * percent + 99) / 100;
+    uint32_t seen = 0;
+    for (int i = 0; i < SD_LATENCY_BUCKETS; i++)
+    {
+        seen += hist[i];
+        if (seen >= wanted)
+        {
+            return (2u << i) - 1;
+        }
+    }
+    return *max_us;
+}
+
+int SDCard::disk_write_blocks(const uint8_t *buffer, uint64_t block_number, int count)
+{
+    if (count == 1)
+    {
+        return disk_write(buffer, block_number);
+    }
+    // set write address for multiple blocks (CMD25)
+    if (_cmd(25, block_number * cdv) != 0)
+    {
+        return 1;
+    }
+
+    _cs = 0;
+    int err = 0;
+    for (int block = 0; block < count && !err; block++)
+    {
+        _spi.write(TOKEN_MULTI_WRITE);
+        for (int i = 0; i < 512; i++)
+        {
+            _spi.write(*buffer++);
+        }
+        // checksum
+        _spi.write(0xFF);
+        _spi.write(0xFF);
+        // check the response token, then wait for the block to be programmed
+        err = (_spi.write(0xFF) & 0x1F) != 0x05;
+        while (_spi.write(0xFF) == 0);
+    }
+
+    // end the transfer & wait for the card to finish
+    _spi.write(TOKEN_STOP_TRAN);
+    _spi.write(0xFF);
+    while (_spi.write(0xFF) == 0);
+    _cs = 1;
+    _spi.write(0xFF);
+    return err;
+}
@@ -0,0 +1,139 @@
+/**
+ * @file SDCard.h
+ * @brief SDFileSystem with the extra card commands the player needs
+ * @details The SDFileSystem library only writes one block per command. SDCard adds multi-block writes
+ * (CMD25), which let the card program a whole run of sectors at once, and times every block read into
+ * a latency histogram. Block reads check the CRC the card sends, give up on a card that never answers,
+ * and are retried. At mount the card's CID & CSD are read to look up its calibration in CardProfiles;
+ * only a new card, or one that failed reads since, is calibrated again. stdio opens take their file
+ * handle from a FilePool instead of the heap.
+**/
+#ifndef SDCARD_H
+#define SDCARD_H
+
+#include "mbed.h"
+#include "SDFileSystem.h"
+#include "CardProfiles.h"
+#include "FilePool.h"
+
+// Read latency histogram buckets; bucket n counts reads of 2^n to 2^(n+1)-1 us, the last everything slower
+#define SD_LATENCY_BUCKETS 16
+// Independent latency windows, so one reader taking its figures does not reset another's
+#define SD_LATENCY_WINDOWS 2
+// Tries at a block read before it is reported as failed
+#define SD_READ_TRIES 3
+// Time the card has to start sending a block
+#define SD_READ_TIMEOUT_US 100000
+// Failed reads after which the SPI clock is lowered a step
+#define SD_ERROR_STEP 4
+// SPI clock every card is brought up at & falls back to
+#define SD_SAFE_HZ 1000000
+
+/**
+ * @brief SD card file system with multi-block writes & read timing
+**/
+class SDCard : public SDFileSystem
+{
+public:
+    /**
+     * @brief Create the File System for accessing an SD Card using SPI
+     * @param mosi SPI mosi pin connected to SD Card
+     * @param miso SPI miso pin conencted to SD Card
+     * @param sclk SPI sclk pin connected to SD Card
+     * @param cs DigitalOut pin used as SD Card chip select
+     * @param name The name used to access the virtual filesystem
+    **/
+    SDCard(PinName mosi, PinName miso, PinName sclk, PinName cs, const char *name);
+
+    /**
+     * @brief Writes consecutive blocks with one WRITE_MULTIPLE_BLOCK command
+     * @param buffer count * 512 bytes of data
+     * @param block_number First block to write
+     * @param count Number of blocks
+     * @return 0 on success, like disk_write
+    **/
+    int disk_write_blocks(const uint8_t *buffer, uint64_t block_number, int count);
+
+    /**
+     * @brief Reads one block, adding its latency to the histogram
+    **/
+    virtual int disk_read(uint8_t *buffer, uint64_t block_number);
+
+    /**
+     * @brief Takes the read latency percentile & maximum of a window since its last call, then starts it afresh
+     * @param window Window of the caller, 0 to SD_LATENCY_WINDOWS - 1
+     * @param percent Percentile to report, e.g. 99
+     * @param max_us Set to the slowest read, 0 if there were none
+     * @return Upper bound of the bucket holding the percentile, 0 if there were no reads
+    **/
+    uint32_t read_latency(int window, unsigned percent, uint32_t *max_us);
+
+    /**
+     * @brief Blocks read since power up
+    **/
+    uint32_t blocks_read() const { return read_count; }
+
+    /**
+     * @brief SPI clock the card is run at, from the SSP1 dividers
+    **/
+    uint32_t spi_hz() const;
+
+    /**
+     * @brief Reads the card's CID & CSD, then sets the SPI clock from its profile, calibrating it first
+     * if it is new or failed reads since it was last calibrated
+     * @return 0 on success, like disk_initialize
+    **/
+    virtual int disk_initialize();
+
+    /**
+     * @brief Calibration of the card in use
+    **/
+    const CardProfile &profile() const { return card; }
+
+    /**
+     * @brief true if the card was calibrated at this mount, false if its profile was found in flash
+    **/
+    bool calibrated() const { return card_calibrated; }
+
+    /**
+     * @brief Block reads that failed since power up, including those that succeeded when tried again
+    **/
+    uint32_t read_errors() const { return error_count; }
+
+    /**
+     * @brief Writes the profile to flash if it changed since the card was mounted
+     * @details Interrupts are briefly off while the flash is written, so call only while no audio is playing.
+     * @return true if a profile was written
+    **/
+    bool save_profile();
+
+    /**
+     * @brief Opens a file for stdio in a FilePool slot, or on the heap once the pool is full
+    **/
+    virtual FileHandle *open(const char *name, int flags);
+
+    /**
+     * @brief Use of the file handle pool
+    **/
+    const FilePoolStats &files() const { return file_pool.stats(); }
+
+private:
+    bool read_data(uint8_t *buffer, uint32_t length);
+    bool read_block(uint8_t *buffer, uint32_t block_number);
+    bool read_register(int command, uint8_t *reg);
+    void read_failed();
+    void calibrate();
+    void time_reads(uint8_t *buffer, uint32_t first, uint32_t stride, uint32_t *times);
+
+    FilePool file_pool;
+    CardProfiles profiles;
+    CardProfile card;
+    bool card_calibrated;
+    volatile bool profile_dirty;
+    volatile uint32_t error_count;
+    volatile uint32_t latency_hist[SD_LATENCY_WINDOWS][SD_LATENCY_BUCKETS];
+    volatile uint32_t latency_max[SD_LATENCY_WINDOWS];
+    volatile uint32_t read_count;
+};
+
+#endif
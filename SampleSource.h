@@ -0,0 +1,37 @@
+/**
+ * @file SampleSource.h
+ * @brief Sector-addressed source of PCM data for StreamPlayer
+ * @details A source looks like the data of a WAV file: a format, the byte range holding the samples
+ * and sector reads. TrackStream reads it from the card; SignalSource synthesizes it.
+**/
+#ifndef SAMPLESOURCE_H
+#define SAMPLESOURCE_H
+
+#include "mbed.h"
+#include "wave_player.h"
+
+// Size of one SD card sector in bytes
+#define SECTOR_SIZE 512
+
+/**
+ * @brief Interface of everything StreamPlayer can play
+**/
+class SampleSource
+{
+public:
+    virtual ~SampleSource() {}
+
+    /**
+     * @brief Reads one sector of the source
+     * @param file_sector Sector index counted from the start of the source
+     * @param buffer Destination of SECTOR_SIZE bytes
+     * @return true on success, false past the end or on error
+    **/
+    virtual bool read_sector(uint32_t file_sector, uint8_t *buffer) = 0;
+
+    FMT_STRUCT format;      // Format of the samples
+    uint32_t data_start;    // Byte offset of the first sample
+    uint32_t data_size;     // Bytes of sample data
+};
+
+#endif
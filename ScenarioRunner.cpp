@@ -0,0 +1,269 @@
+/**
+ * @file ScenarioRunner.cpp
+ * @brief Runs scripted end-to-end scenarios on the player & reports each as one line of JSON
+**/
+#include "ScenarioRunner.h"
+#include "TrackStream.h"
+#include "us_ticker_api.h"
+#include <algorithm>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Built into every result, so results from different firmware can be told apart
+static const char buildStamp[] = __DATE__ " " __TIME__;
+
+ScenarioRunner::ScenarioRunner(ClockGovernor *governor, BlackBox *blackBox, StreamPlayer *player,
+                               CpuProfiler *profiler, Stream *console)
+    : governor(governor), blackBox(blackBox), player(player), profiler(profiler), console(console)
+{
+    // Global objects are built just after reset, so boot phases are timed from here
+    boot_us = us_ticker_read();
+    num_phases = 0;
+    num_scenarios = 0;
+    json_length = 0;
+    sample_count = 0;
+    num_results = 0;
+}
+
+void ScenarioRunner::boot_phase(const char *name)
+{
+    if (num_phases < SCENARIO_BOOT_PHASES)
+    {
+        boot_names[num_phases] = name;
+        boot_ms[num_phases] = (us_ticker_read() - boot_us) / 1000;
+        num_phases++;
+    }
+}
+
+bool ScenarioRunner::add(const char *name, ScenarioFunction function)
+{
+    if (num_scenarios == SCENARIO_MAX)
+    {
+        return false;
+    }
+    names[num_scenarios] = name;
+    functions[num_scenarios] = function;
+    num_scenarios++;
+    return true;
+}
+
+int ScenarioRunner::run_script(const char *script, const char *results)
+{
+    // The whole script is read first, so the card is not held while the scenarios run
+    static char lines[SCENARIO_MAX_STEPS][SCENARIO_LINE];
+    int steps = 0;
+    sdMutex.lock();
+    FILE *fp = fopen(script, "r");
+    if (fp != NULL)
+    {
+        while (steps < SCENARIO_MAX_STEPS && fgets(lines[steps], SCENARIO_LINE, fp) != NULL)
+        {
+            // Blank lines & comments are skipped
+            if (lines[steps][0] != '#' && lines[steps][0] != '\n' && lines[steps][0] != '\r')
+            {
+                steps++;
+            }
+        }
+        fclose(fp);
+    }
+    sdMutex.unlock();
+
+    int count = 0;
+    for (int i = 0; i < steps; i++)
+    {
+        char name[SCENARIO_LINE];
+        int arg = 0;
+        int arg2 = 0;
+        if (sscanf(lines[i], "%31s %d %d", name, &arg, &arg2) >= 1)
+        {
+            run(name, arg, arg2, results);
+            count++;
+        }
+    }
+    return count;
+}
+
+void ScenarioRunner::wait(uint32_t ms)
+{
+    uint32_t start = us_ticker_read();
+    while (true)
+    {
+        uint32_t now = us_ticker_read();
+        if (now - last_sample_us >= SCENARIO_SAMPLE_MS * 1000)
+        {
+            sample();
+        }
+        uint32_t elapsed = (now - start) / 1000;
+        if (elapsed >= ms)
+        {
+            return;
+        }
+        uint32_t step = ms - elapsed;
+        Thread::wait(step < SCENARIO_SAMPLE_MS ? step : SCENARIO_SAMPLE_MS);
+    }
+}
+
+void ScenarioRunner::latency(uint32_t us)
+{
+    if (sample_count < SCENARIO_MAX_SAMPLES)
+    {
+        samples[sample_count] = us;
+    }
+    sample_count++;
+    if (us > max_us)
+    {
+        max_us = us;
+    }
+}
+
+void ScenarioRunner::result(const char *key, uint32_t value)
+{
+    for (int i = 0; i < num_results; i++)
+    {
+        if (strcmp(result_keys[i], key) == 0)
+        {
+            result_values[i] = value;
+            return;
+        }
+    }
+    if (num_results < SCENARIO_MAX_RESULTS)
+    {
+        result_keys[num_results] = key;
+        result_values[num_results] = value;
+        num_results++;
+    }
+}
+
+/**
+ * @brief Clears the metrics for a new scenario
+**/
+void ScenarioRunner::begin()
+{
+    start_us = us_ticker_read();
+    last_sample_us = start_us;
+    start_underruns = player->underruns();
+    sample_count = 0;
+    max_us = 0;
+    load_total = 0;
+    load_samples = 0;
+    load_max = 0;
+    heap_min = 0xFFFF;
+    num_results = 0;
+}
+
+/**
+ * @brief Takes one sample of the CPU load & the free heap
+ * @details The stacks are painted, so their high water marks are read once at the end.
+**/
+void ScenarioRunner::sample()
+{
+    last_sample_us = us_ticker_read();
+    unsigned load = governor->load();
+    load_total += load;
+    load_samples++;
+    if (load > load_max)
+    {
+        load_max = load;
+    }
+    uint16_t heap = blackBox->heap_free();
+    if (heap < heap_min)
+    {
+        heap_min = heap;
+    }
+}
+
+/**
+ * @brief Upper end of a percentile of the latencies kept, in us
+**/
+uint32_t ScenarioRunner::percentile(unsigned percent) const
+{
+    unsigned kept = sample_count < SCENARIO_MAX_SAMPLES ? sample_count : SCENARIO_MAX_SAMPLES;
+    if (kept == 0)
+    {
+        return 0;
+    }
+    unsigned rank = (kept * percent + 99) / 100;
+    return samples[rank > 0 ? rank - 1 : 0];
+}
+
+/**
+ * @brief Adds formatted text to the JSON line, cutting it at SCENARIO_JSON
+**/
+void ScenarioRunner::append(const char *format, ...)
+{
+    if (json_length >= SCENARIO_JSON - 1)
+    {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(json + json_length, SCENARIO_JSON - json_length, format, args);
+    va_end(args);
+    json_length += length > 0 ? length : 0;
+    if (json_length > SCENARIO_JSON - 1)
+    {
+        json_length = SCENARIO_JSON - 1;
+    }
+}
+
+/**
+ * @brief Runs one scenario & writes its result line
+ * @details An unknown name is reported with an error instead of metrics, so a typo in the script
+ * shows in the results rather than as a missing line.
+**/
+void ScenarioRunner::run(const char *name, int arg, int arg2, const char *results)
+{
+    int index = 0;
+    while (index < num_scenarios && strcmp(names[index], name) != 0)
+    {
+        index++;
+    }
+    json_length = 0;
+    append("{\"scenario\":\"%s\",\"args\":[%d,%d],\"build\":\"%s\"", name, arg, arg2, buildStamp);
+    if (index == num_scenarios)
+    {
+        append(",\"error\":\"unknown scenario\"}");
+    }
+    else
+    {
+        begin();
+        sample();
+        functions[index](*this, arg, arg2);
+        sample();
+        unsigned kept = sample_count < SCENARIO_MAX_SAMPLES ? sample_count : SCENARIO_MAX_SAMPLES;
+        std::sort(samples, samples + kept);
+
+        append(",\"ms\":%u,\"boot_ms\":{", (unsigned)((us_ticker_read() - start_us) / 1000));
+        for (int i = 0; i < num_phases; i++)
+        {
+            append("%s\"%s\":%u", i ? "," : "", boot_names[i], (unsigned)boot_ms[i]);
+        }
+        append("},\"latency_us\":{\"n\":%u,\"p50\":%u,\"p90\":%u,\"p99\":%u,\"max\":%u}", sample_count,
+               (unsigned)percentile(50), (unsigned)percentile(90), (unsigned)percentile(99), (unsigned)max_us);
+        append(",\"underruns\":%u,\"cpu\":{\"avg\":%u,\"max\":%u},\"heap_min\":%u,\"stack_min\":{",
+               player->underruns() - start_underruns, load_samples ? load_total / load_samples : 0, load_max,
+               heap_min);
+        for (int i = 0; i < blackBox->watched(); i++)
+        {
+            append("%s\"%s\":%u", i ? "," : "", profiler->name(i), blackBox->stack_free(i));
+        }
+        append("}");
+        for (int i = 0; i < num_results; i++)
+        {
+            append(",\"%s\":%u", result_keys[i], (unsigned)result_values[i]);
+        }
+        append("}");
+    }
+
+    console->printf("%s\r\n", json);
+    sdMutex.lock();
+    FILE *fp = fopen(results, "a");
+    if (fp != NULL)
+    {
+        fputs(json, fp);
+        fputs("\n", fp);
+        fclose(fp);
+    }
+    sdMutex.unlock();
+}
@@ -0,0 +1,138 @@
+/**
+ * @file ScenarioRunner.h
+ * @brief Runs scripted end-to-end scenarios on the player & reports each as one line of JSON
+ * @details A script on the card names one scenario per line with up to two numbers, e.g. "skips 500
+ * 300". Each scenario drives the player through main's own functions while the runner samples the
+ * CPU load, the free heap & the stack high water marks, and collects the latencies
+ * the scenario hands it. The result of each goes to the console & is appended to a JSON Lines file,
+ * which tools/scenario_compare.py compares between firmware builds. Scenarios run against the real
+ * card & library, so tools/make_scenario_card.py writes the libraries they are meant for.
+**/
+#ifndef SCENARIORUNNER_H
+#define SCENARIORUNNER_H
+
+#include "mbed.h"
+#include "rtos.h"
+#include "ClockGovernor.h"
+#include "BlackBox.h"
+#include "StreamPlayer.h"
+#include "CpuProfiler.h"
+
+// Build option: set to 1 for a bench build that runs the scenario script on the card after boot
+#ifndef SCENARIO_RUNNER
+#define SCENARIO_RUNNER 0
+#endif
+
+// Largest number of scenarios registered, of lines run from one script & of boot phases timed
+#define SCENARIO_MAX 8
+#define SCENARIO_MAX_STEPS 16
+#define SCENARIO_BOOT_PHASES 6
+// Latencies kept per scenario for the percentiles; later ones only count towards the slowest
+#define SCENARIO_MAX_SAMPLES 512
+// Scenario-specific results per scenario
+#define SCENARIO_MAX_RESULTS 6
+// Time between samples of the load, heap & stacks while a scenario waits
+#define SCENARIO_SAMPLE_MS 250
+// Longest script line & JSON line
+#define SCENARIO_LINE 32
+#define SCENARIO_JSON 768
+
+class ScenarioRunner;
+
+/**
+ * @brief Body of a scenario
+ * @param runner Runner to wait through & hand latencies & results to
+ * @param arg First number of the script line, 0 if missing
+ * @param arg2 Second number, 0 if missing
+**/
+typedef void (*ScenarioFunction)(ScenarioRunner &runner, int arg, int arg2);
+
+/**
+ * @brief Registry of scenarios & the metrics of the one running
+**/
+class ScenarioRunner
+{
+public:
+    /**
+     * @param console Stream each result line is also written to
+    **/
+    ScenarioRunner(ClockGovernor *governor, BlackBox *blackBox, StreamPlayer *player, CpuProfiler *profiler,
+                   Stream *console);
+
+    /**
+     * @brief Notes the time a step of the boot finished, from the runner's construction
+     * @param name Short name for the report, e.g. "index"
+    **/
+    void boot_phase(const char *name);
+
+    /**
+     * @brief Registers a scenario under the name scripts call it by
+     * @return false if SCENARIO_MAX are registered
+    **/
+    bool add(const char *name, ScenarioFunction function);
+
+    /**
+     * @brief Runs every line of a script in order
+     * @param script stdio path of the script, e.g. "/sd/scenario.txt"
+     * @param results stdio path of the JSON Lines file the results are appended to
+     * @return Scenarios run; 0 if the script is missing
+    **/
+    int run_script(const char *script, const char *results);
+
+    /**
+     * @brief Waits for a time, sampling the load, heap & stacks every SCENARIO_SAMPLE_MS
+    **/
+    void wait(uint32_t ms);
+
+    /**
+     * @brief Adds one latency to the percentiles of the running scenario
+    **/
+    void latency(uint32_t us);
+
+    /**
+     * @brief Sets a result of the running scenario reported along with the common metrics
+     * @param key JSON key; must stay valid until the scenario ends
+    **/
+    void result(const char *key, uint32_t value);
+
+private:
+    void begin();
+    void sample();
+    void run(const char *name, int arg, int arg2, const char *results);
+    void append(const char *format, ...);
+    uint32_t percentile(unsigned percent) const;
+
+    ClockGovernor *governor;
+    BlackBox *blackBox;
+    StreamPlayer *player;
+    CpuProfiler *profiler;
+    Stream *console;
+    uint32_t boot_us;
+
+    const char *boot_names[SCENARIO_BOOT_PHASES];
+    uint32_t boot_ms[SCENARIO_BOOT_PHASES];
+    int num_phases;
+    const char *names[SCENARIO_MAX];
+    ScenarioFunction functions[SCENARIO_MAX];
+    int num_scenarios;
+
+    // Metrics of the running scenario
+    uint32_t start_us;
+    uint32_t last_sample_us;
+    unsigned start_underruns;
+    uint32_t samples[SCENARIO_MAX_SAMPLES];
+    unsigned sample_count;          // Latencies handed in, including those past SCENARIO_MAX_SAMPLES
+    uint32_t max_us;
+    uint32_t load_total;
+    unsigned load_samples;
+    unsigned load_max;
+    uint16_t heap_min;
+    const char *result_keys[SCENARIO_MAX_RESULTS];
+    uint32_t result_values[SCENARIO_MAX_RESULTS];
+    int num_results;
+
+    char json[SCENARIO_JSON];
+    int json_length;
+};
+
+#endif
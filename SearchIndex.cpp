@@ -0,0 +1,447 @@
+/**
+ * @file SearchIndex.cpp
+ * @brief Word search over the library through an inverted index kept on the card
+**/
+#include "SearchIndex.h"
+#include "Codec.h"
+#include "us_ticker_api.h"
+#include <algorithm>
+#include <ctype.h>
+#include <string.h>
+
+// Dictionary records per sector
+#define ENTRIES_PER_SECTOR (SECTOR_SIZE / sizeof(SearchEntry))
+
+/**
+ * @brief Place of one word in a song name
+**/
+struct TokenRef
+{
+    uint16_t song;
+    uint8_t start;
+    uint8_t length;     // Up to SEARCH_TOKEN_LEN
+};
+
+/**
+ * @brief Length of a name without the extension of a playable file
+**/
+static int name_length(const std::string &name)
+{
+    int len = name.size();
+    if (codec_for_name(name.c_str()) != NULL)
+    {
+        len = name.rfind('.');
+    }
+    return len < 255 ? len : 255;
+}
+
+/**
+ * @brief Finds the next word of a name: a run of letters & digits
+ * @param pos Where to start looking; left after the word
+ * @param start Set to the start of the word
+ * @return Length of the word, capped at SEARCH_TOKEN_LEN, or 0 if there are no more words
+**/
+static int next_word(const char *text, int len, int *pos, int *start)
+{
+    int i = *pos;
+    while (i < len && !isalnum((uint8_t)text[i]))
+    {
+        i++;
+    }
+    *start = i;
+    while (i < len && isalnum((uint8_t)text[i]))
+    {
+        i++;
+    }
+    *pos = i;
+    int n = i - *start;
+    return n < SEARCH_TOKEN_LEN ? n : SEARCH_TOKEN_LEN;
+}
+
+/**
+ * @brief Copies a word to a zero-padded lower case token
+**/
+static void make_token(const char *word, int length, char *token)
+{
+    memset(token, 0, SEARCH_TOKEN_LEN);
+    for (int i = 0; i < length; i++)
+    {
+        token[i] = tolower((uint8_t)word[i]);
+    }
+}
+
+/**
+ * @brief Compares the tokens of two word references
+**/
+static int compare_tokens(const LibraryIndex *library, const TokenRef &a, const TokenRef &b)
+{
+    const char *x = library->name(a.song).c_str() + a.start;
+    const char *y = library->name(b.song).c_str() + b.start;
+    int n = a.length < b.length ? a.length : b.length;
+    for (int i = 0; i < n; i++)
+    {
+        int cx = tolower((uint8_t)x[i]);
+        int cy = tolower((uint8_t)y[i]);
+        if (cx != cy)
+        {
+            return cx - cy;
+        }
+    }
+    return a.length - b.length;
+}
+
+/**
+ * @brief Orders word references by token, then by song
+**/
+struct TokenOrder
+{
+    const LibraryIndex *library;
+
+    bool operator()(const TokenRef &a, const TokenRef &b) const
+    {
+        int result = compare_tokens(library, a, b);
+        return result != 0 ? result < 0 : a.song < b.song;
+    }
+};
+
+/**
+ * @brief Bytes of a song number delta as a variable-length integer
+**/
+static int varint_size(uint32_t value)
+{
+    int n = 1;
+    while (value >= 0x80)
+    {
+        value >>= 7;
+        n++;
+    }
+    return n;
+}
+
+SearchIndex::SearchIndex(SDFileSystem *fs, const LibraryIndex *library)
+{
+    this->fs = fs;
+    this->library = library;
+    memset(&header, 0, sizeof(header));
+    query_us = 0;
+    read_error = false;
+}
+
+/**
+ * @brief FNV-1a hash of the song names in library order
+**/
+uint32_t SearchIndex::signature() const
+{
+    uint32_t hash = 2166136261u;
+    for (int song = 0; song < library->count(); song++)
+    {
+        const std::string &name = library->name(song);
+        for (unsigned i = 0; i <= name.size(); i++)
+        {
+            hash = (hash ^ (uint8_t)name.c_str()[i]) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+/**
+ * @brief Writes the index: header sector, sorted dictionary, then the posting lists
+ * @details The word references are sorted in RAM; they take about as much as the names they point
+ * into. Both sections are then written front to back in two passes over the sorted references.
+**/
+bool SearchIndex::build(const char *path)
+{
+    std::vector<TokenRef> refs;
+    for (int song = 0; song < library->count(); song++)
+    {
+        const std::string &name = library->name(song);
+        int len = name_length(name);
+        int pos = 0;
+        int start;
+        int length;
+        while ((length = next_word(name.c_str(), len, &pos, &start)) > 0)
+        {
+            TokenRef ref = {(uint16_t)song, (uint8_t)start, (uint8_t)length};
+            refs.push_back(ref);
+        }
+    }
+    TokenOrder order = {library};
+    std::sort(refs.begin(), refs.end(), order);
+
+    SearchHeader built = {SEARCH_MAGIC, signature(), (uint32_t)library->count(), 0, 0};
+    sdMutex.lock();
+    FILE *fp = fopen(path, "wb");
+    if (fp == NULL)
+    {
+        sdMutex.unlock();
+        return false;
+    }
+    uint8_t *sector = cursors[0].buffer;
+    memset(sector, 0, SECTOR_SIZE);
+    bool ok = fwrite(sector, 1, SECTOR_SIZE, fp) == SECTOR_SIZE;
+
+    // Dictionary: one record per token, with the size of its list summed ahead of the lists
+    uint32_t offset = 0;
+    for (unsigned i = 0; i < refs.size() && ok; )
+    {
+        SearchEntry entry;
+        make_token(library->name(refs[i].song).c_str() + refs[i].start, refs[i].length, entry.token);
+        entry.count = 0;
+        entry.offset = offset;
+        int previous = -1;
+        unsigned j = i;
+        for (; j < refs.size() && compare_tokens(library, refs[i], refs[j]) == 0; j++)
+        {
+            if (refs[j].song != previous)
+            {
+                offset += varint_size(previous < 0 ? refs[j].song : refs[j].song - previous);
+                previous = refs[j].song;
+                entry.count++;
+            }
+        }
+        ok = fwrite(&entry, sizeof(entry), 1, fp) == 1;
+        built.tokens++;
+        i = j;
+    }
+    built.postings = SECTOR_SIZE + built.tokens * sizeof(SearchEntry);
+
+    // Posting lists in the same order
+    for (unsigned i = 0; i < refs.size() && ok; )
+    {
+        int previous = -1;
+        unsigned j = i;
+        for (; j < refs.size() && compare_tokens(library, refs[i], refs[j]) == 0 && ok; j++)
+        {
+            if (refs[j].song == previous)
+            {
+                continue;
+            }
+            uint32_t delta = previous < 0 ? refs[j].song : refs[j].song - previous;
+            previous = refs[j].song;
+            do
+            {
+                uint8_t byte = (delta & 0x7F) | (delta >= 0x80 ? 0x80 : 0);
+                ok = fputc(byte, fp) != EOF;
+                delta >>= 7;
+            }
+            while (delta > 0 && ok);
+        }
+        i = j;
+    }
+
+    ok = ok && fseek(fp, 0, SEEK_SET) == 0 && fwrite(&built, sizeof(built), 1, fp) == 1;
+    ok = fclose(fp) == 0 && ok;
+    // The file has a new chain; the FAT sector cached when it was last mapped may be out of date
+    invalidate_fat_cache();
+    sdMutex.unlock();
+    return ok;
+}
+
+bool SearchIndex::load(const char *name)
+{
+    uint8_t *sector = cursors[0].buffer;
+    cursors[0].sector = 0xFFFFFFFF;
+    if (file.open(fs, name) && file.read_sector(0, sector))
+    {
+        memcpy(&header, sector, sizeof(header));
+        if (header.magic == SEARCH_MAGIC && header.songs == (uint32_t)library->count() && header.signature == signature())
+        {
+            return true;
+        }
+    }
+    file.close();
+
+    char path[64];
+    snprintf(path, sizeof(path), "/%s/%s", fs->getName(), name);
+    if (!build(path) || !file.open(fs, name) || !file.read_sector(0, sector))
+    {
+        file.close();
+        memset(&header, 0, sizeof(header));
+        return false;
+    }
+    memcpy(&header, sector, sizeof(header));
+    return header.magic == SEARCH_MAGIC;
+}
+
+/**
+ * @brief Binary searches the dictionary, one sector per probe
+**/
+bool SearchIndex::lookup(const char *token, SearchEntry *entry)
+{
+    uint8_t *sector = cursors[0].buffer;
+    cursors[0].sector = 0xFFFFFFFF;
+    uint32_t lo = 0;
+    uint32_t hi = (header.tokens + ENTRIES_PER_SECTOR - 1) / ENTRIES_PER_SECTOR;
+    while (lo < hi)
+    {
+        uint32_t mid = (lo + hi) / 2;
+        if (!file.read_sector(1 + mid, sector))
+        {
+            read_error = true;
+            return false;
+        }
+        const SearchEntry *entries = (const SearchEntry *)sector;
+        uint32_t n = header.tokens - mid * ENTRIES_PER_SECTOR;
+        if (n > ENTRIES_PER_SECTOR)
+        {
+            n = ENTRIES_PER_SECTOR;
+        }
+        if (strncmp(token, entries[0].token, SEARCH_TOKEN_LEN) < 0)
+        {
+            hi = mid;
+            continue;
+        }
+        if (strncmp(token, entries[n - 1].token, SEARCH_TOKEN_LEN) > 0)
+        {
+            lo = mid + 1;
+            continue;
+        }
+        for (uint32_t i = 0; i < n; i++)
+        {
+            if (strncmp(token, entries[i].token, SEARCH_TOKEN_LEN) == 0)
+            {
+                *entry = entries[i];
+                return true;
+            }
+        }
+        return false;
+    }
+    return false;
+}
+
+bool SearchIndex::read_byte(PostingCursor *cursor, uint8_t *value)
+{
+    uint32_t sector = cursor->pos / SECTOR_SIZE;
+    if (sector != cursor->sector)
+    {
+        if (!file.read_sector(sector, cursor->buffer))
+        {
+            read_error = true;
+            return false;
+        }
+        cursor->sector = sector;
+    }
+    *value = cursor->buffer[cursor->pos % SECTOR_SIZE];
+    cursor->pos++;
+    return true;
+}
+
+/**
+ * @brief Decodes the next song number of a posting list
+ * @return false at the end of the list or on a card error
+**/
+bool SearchIndex::next(PostingCursor *cursor)
+{
+    if (cursor->left == 0)
+    {
+        return false;
+    }
+    uint32_t delta = 0;
+    int shift = 0;
+    uint8_t byte;
+    do
+    {
+        if (!read_byte(cursor, &byte))
+        {
+            return false;
+        }
+        delta |= (uint32_t)(byte & 0x7F) << shift;
+        shift += 7;
+    }
+    while ((byte & 0x80) && shift < 32);
+    cursor->song = cursor->song < 0 ? delta : cursor->song + delta;
+    cursor->left--;
+    return true;
+}
+
+int SearchIndex::query(const char *text, int first, int max, uint16_t *results)
+{
+    uint32_t start_us = us_ticker_read();
+    read_error = false;
+    if (!file.is_open())
+    {
+        return -1;
+    }
+
+    // Look up each distinct word; a word missing from the dictionary matches nothing
+    SearchEntry entries[SEARCH_MAX_TERMS];
+    int terms = 0;
+    int len = strlen(text);
+    int pos = 0;
+    int start;
+    int length;
+    while (terms < SEARCH_MAX_TERMS && (length = next_word(text, len, &pos, &start)) > 0)
+    {
+        char token[SEARCH_TOKEN_LEN];
+        make_token(text + start, length, token);
+        bool repeated = false;
+        for (int i = 0; i < terms; i++)
+        {
+            repeated = repeated || strncmp(token, entries[i].token, SEARCH_TOKEN_LEN) == 0;
+        }
+        if (repeated)
+        {
+            continue;
+        }
+        if (!lookup(token, &entries[terms]))
+        {
+            query_us = us_ticker_read() - start_us;
+            return read_error ? -1 : 0;
+        }
+        terms++;
+    }
+    if (terms == 0)
+    {
+        query_us = us_ticker_read() - start_us;
+        return 0;
+    }
+
+    // Shortest list first: it drives the merge & bounds its length
+    for (int i = 1; i < terms; i++)
+    {
+        for (int j = i; j > 0 && entries[j].count < entries[j - 1].count; j--)
+        {
+            SearchEntry swap = entries[j];
+            entries[j] = entries[j - 1];
+            entries[j - 1] = swap;
+        }
+    }
+    for (int i = 0; i < terms; i++)
+    {
+        cursors[i].pos = header.postings + entries[i].offset;
+        cursors[i].left = entries[i].count;
+        cursors[i].song = -1;
+        cursors[i].sector = 0xFFFFFFFF;
+    }
+
+    // Intersect: every other list is advanced up to each song of the shortest
+    int total = 0;
+    bool done = false;
+    while (!done && next(&cursors[0]))
+    {
+        int song = cursors[0].song;
+        bool all = true;
+        for (int i = 1; i < terms && all; i++)
+        {
+            while (cursors[i].song < song)
+            {
+                if (!next(&cursors[i]))
+                {
+                    done = true;
+                    break;
+                }
+            }
+            all = !done && cursors[i].song == song;
+        }
+        if (all)
+        {
+            if (total >= first && total < first + max)
+            {
+                results[total - first] = song;
+            }
+            total++;
+        }
+    }
+    query_us = us_ticker_read() - start_us;
+    return read_error ? -1 : total;
+}
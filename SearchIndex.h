@@ -0,0 +1,102 @@
+/**
+ * @file SearchIndex.h
+ * @brief Word search over the library through an inverted index kept on the card
+ * @details Every word of every song name (artist, album & title, as the files are named) becomes a
+ * token. The index file holds a sorted dictionary of fixed-size token records, one sector per binary
+ * search probe, followed by a posting list per token: the song numbers holding it, delta-encoded as
+ * variable-length integers. A query looks up each word & intersects the lists while streaming them
+ * from the card a sector at a time, so its RAM does not grow with the library.
+**/
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include "mbed.h"
+#include "TrackStream.h"
+#include "LibraryIndex.h"
+
+// Marks an index file written by this version ("SIDX")
+#define SEARCH_MAGIC 0x58444953
+// Characters of a token kept in the dictionary; longer words match on this prefix
+#define SEARCH_TOKEN_LEN 10
+// Words of a query that are matched; further words are ignored
+#define SEARCH_MAX_TERMS 3
+
+/**
+ * @brief First sector of the index file
+**/
+struct SearchHeader
+{
+    uint32_t magic;
+    uint32_t signature;     // Hash of the song names the index was built from
+    uint32_t songs;
+    uint32_t tokens;        // Dictionary records, starting at the second sector
+    uint32_t postings;      // File offset of the posting lists
+};
+
+/**
+ * @brief Dictionary record of one token
+**/
+struct SearchEntry
+{
+    char token[SEARCH_TOKEN_LEN];   // Lower case, zero padded
+    uint16_t count;                 // Songs in the posting list
+    uint32_t offset;                // Posting list, from the start of the posting lists
+};
+
+/**
+ * @brief Reader of one posting list, a sector at a time
+**/
+struct PostingCursor
+{
+    uint32_t pos;           // File offset of the next encoded delta
+    uint16_t left;          // Song numbers still to decode
+    int song;               // Current song number, -1 before the first
+    uint32_t sector;        // File sector held in buffer
+    uint8_t buffer[SECTOR_SIZE];
+};
+
+/**
+ * @brief On-card inverted index of the words in the song names
+**/
+class SearchIndex
+{
+public:
+    SearchIndex(SDFileSystem *fs, const LibraryIndex *library);
+
+    /**
+     * @brief Opens the index, first rebuilding it if it is missing or the library has changed
+     * @param name File name in the root directory of the card, e.g. "search.idx"
+     * @return false if the index could neither be opened nor built
+    **/
+    bool load(const char *name);
+
+    /**
+     * @brief Finds the songs whose names contain every word of a query
+     * @param text Words separated by spaces or punctuation, in any case
+     * @param first Number of matches to skip, for paging
+     * @param max Largest number of song numbers to return
+     * @param results Filled with up to max song numbers, in library order
+     * @return Total number of matching songs, or -1 on a card error
+    **/
+    int query(const char *text, int first, int max, uint16_t *results);
+
+    uint32_t last_query_us() const { return query_us; }
+    uint32_t tokens() const { return header.tokens; }
+
+private:
+    uint32_t signature() const;
+    bool build(const char *path);
+    bool lookup(const char *token, SearchEntry *entry);
+    bool next(PostingCursor *cursor);
+    bool read_byte(PostingCursor *cursor, uint8_t *value);
+
+    SDFileSystem *fs;
+    const LibraryIndex *library;
+    TrackStream file;
+    SearchHeader header;
+    PostingCursor cursors[SEARCH_MAX_TERMS];
+    uint32_t query_us;
+    bool read_error;            // A sector could not be read during the current query
+};
+
+#endif
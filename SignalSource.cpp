@@ -0,0 +1,207 @@
+/**
+ * @file SignalSource.cpp
+ * @brief Synthesized test signals in any PCM format StreamPlayer can play
+**/
+#include "SignalSource.h"
+#include <string.h>
+
+// One cycle of a full-scale sine, indexed by the top 8 bits of the phase
+static const int16_t sineTable[SIGNAL_TABLE_SIZE] =
+{
+         0,    804,   1608,   2410,   3212,   4011,   4808,   5602,
+      6393,   7179,   7962,   8739,   9512,  10278,  11039,  11793,
+     12539,  13279,  14010,  14732,  15446,  16151,  16846,  17530,
+     18204,  18868,  19519,  20159,  20787,  21403,  22005,  22594,
+     23170,  23731,  24279,  24811,  25329,  25832,  26319,  26790,
+     27245,  27683,  28105,  28510,  28898,  29268,  29621,  29956,
+     30273,  30571,  30852,  31113,  31356,  31580,  31785,  31971,
+     32137,  32285,  32412,  32521,  32609,  32678,  32728,  32757,
+     32767,  32757,  32728,  32678,  32609,  32521,  32412,  32285,
+     32137,  31971,  31785,  31580,  31356,  31113,  30852,  30571,
+     30273,  29956,  29621,  29268,  28898,  28510,  28105,  27683,
+     27245,  26790,  26319,  25832,  25329,  24811,  24279,  23731,
+     23170,  22594,  22005,  21403,  20787,  20159,  19519,  18868,
+     18204,  17530,  16846,  16151,  15446,  14732,  14010,  13279,
+     12539,  11793,  11039,  10278,   9512,   8739,   7962,   7179,
+      6393,   5602,   4808,   4011,   3212,   2410,   1608,    804,
+         0,   -804,  -1608,  -2410,  -3212,  -4011,  -4808,  -5602,
+     -6393,  -7179,  -7962,  -8739,  -9512, -10278, -11039, -11793,
+    -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530,
+    -18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+    -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+    -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+    -30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971,
+    -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+    -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285,
+    -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+    -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+    -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+    -23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868,
+    -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+    -12539, -11793, -11039, -10278,  -9512,  -8739,  -7962,  -7179,
+     -6393,  -5602,  -4808,  -4011,  -3212,  -2410,  -1608,   -804
+};
+
+SignalSource::SignalSource()
+{
+    configure(SIGNAL_SILENCE, 8000, 16, 1, 0, 0, 0);
+}
+
+bool SignalSource::configure(int type, uint32_t sample_rate, int bits, int channels, uint32_t frequency,
+                             uint32_t frequency_end, uint32_t duration_ms)
+{
+    this->type = type;
+    memset(&format, 0, sizeof(format));
+    format.comp_code = 1;
+    format.num_channels = channels;
+    format.sample_rate = sample_rate;
+    format.sig_bps = bits;
+    format.block_align = channels * bits / 8;
+    format.avg_Bps = sample_rate * format.block_align;
+    data_start = 0;
+    if (sample_rate == 0 || channels <= 0 || (bits != 8 && bits != 16 && bits != 32) ||
+        format.block_align > SIGNAL_MAX_ALIGN)
+    {
+        data_size = 0;
+        return false;
+    }
+    frames = (uint32_t)((uint64_t)sample_rate * duration_ms / 1000);
+    data_size = frames * format.block_align;
+
+    // Phase steps in 1/2^32 of a cycle per sample, kept with 16 more fraction bits for the sweep
+    start_step = ((uint64_t)frequency << 48) / sample_rate;
+    uint64_t end_step = ((uint64_t)frequency_end << 48) / sample_rate;
+    sweep_delta = frames > 1 && type == SIGNAL_SWEEP ? ((int64_t)end_step - (int64_t)start_step) / (int64_t)(frames - 1) : 0;
+    rewind();
+    return true;
+}
+
+/**
+ * @brief Restarts the signal from its first sample
+**/
+void SignalSource::rewind()
+{
+    phase = 0;
+    step = start_step;
+    frame = 0;
+    next_byte = 0;
+    pending = 0;
+    pending_used = 0;
+}
+
+/**
+ * @brief Computes the next sample in 16 bit signed range & advances the phase
+**/
+int32_t SignalSource::next_sample()
+{
+    int32_t value;
+    switch (type)
+    {
+        case SIGNAL_SINE:
+        case SIGNAL_SWEEP:
+        {
+            // Linear interpolation between table entries using the next 8 bits of the phase
+            uint32_t index = phase >> 24;
+            int32_t frac = (phase >> 16) & 0xFF;
+            int32_t a = sineTable[index];
+            int32_t b = sineTable[(index + 1) & (SIGNAL_TABLE_SIZE - 1)];
+            value = a + (((b - a) * frac) >> 8);
+            break;
+        }
+        case SIGNAL_SQUARE:
+            value = phase < 0x80000000 ? 32767 : -32767;
+            break;
+        case SIGNAL_IMPULSE:
+            // One full-scale sample at the start of every period
+            value = (phase < (uint32_t)(step >> 16) || frame == 0) ? 32767 : 0;
+            break;
+        default:
+            value = 0;
+            break;
+    }
+    phase += (uint32_t)(step >> 16);
+    step += sweep_delta;
+    frame++;
+    return value;
+}
+
+/**
+ * @brief Encodes one frame of the next sample into pending, in the configured format
+**/
+void SignalSource::make_frame()
+{
+    int32_t value = next_sample();
+    uint8_t *out = pending_frame;
+    for (int c = 0; c < format.num_channels; c++)
+    {
+        switch (format.sig_bps)
+        {
+            case 8:
+                *out++ = (uint8_t)((value >> 8) + 128);
+                break;
+            case 16:
+                *out++ = (uint8_t)value;
+                *out++ = (uint8_t)(value >> 8);
+                break;
+            default:
+            {
+                uint32_t wide = (uint32_t)value << 16;
+                *out++ = (uint8_t)wide;
+                *out++ = (uint8_t)(wide >> 8);
+                *out++ = (uint8_t)(wide >> 16);
+                *out++ = (uint8_t)(wide >> 24);
+                break;
+            }
+        }
+    }
+    pending = format.block_align;
+    pending_used = 0;
+}
+
+bool SignalSource::read_sector(uint32_t file_sector, uint8_t *buffer)
+{
+    uint32_t start = file_sector * SECTOR_SIZE;
+    if (start >= data_size)
+    {
+        return false;
+    }
+    // Sectors are synthesized in order; going back restarts the signal, going forward skips ahead
+    if (start < next_byte)
+    {
+        rewind();
+    }
+    while (next_byte < start)
+    {
+        if (pending_used == pending)
+        {
+            make_frame();
+        }
+        uint32_t skip = pending - pending_used;
+        if (skip > start - next_byte)
+        {
+            skip = start - next_byte;
+        }
+        pending_used += skip;
+        next_byte += skip;
+    }
+
+    uint32_t n = data_size - start < SECTOR_SIZE ? data_size - start : SECTOR_SIZE;
+    for (uint32_t i = 0; i < n;)
+    {
+        if (pending_used == pending)
+        {
+            make_frame();
+        }
+        uint32_t count = pending - pending_used;
+        if (count > n - i)
+        {
+            count = n - i;
+        }
+        memcpy(buffer + i, pending_frame + pending_used, count);
+        pending_used += count;
+        i += count;
+    }
+    next_byte = start + n;
+    memset(buffer + n, 0, SECTOR_SIZE - n);
+    return true;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file SignalSource.h
+ * @brief Synthesized test signals in any PCM format StreamPlayer can play
+ * @details Stands in for a TrackStream so the decode & output stages can be benchmarked without any
+ * SD card I/O, and so the AnalogOut path can be checked for distortion & jitter with a known signal.
+ * Samples come from a 256 entry sine table stepped by a 32 bit fixed-point phase accumulator, with
+ * linear interpolation between entries.
+**/
+#ifndef SIGNALSOURCE_H
+#define SIGNALSOURCE_H
+
+#include "mbed.h"
+#include "SampleSource.h"
+
+// Entries in one cycle of the sine table; must be 256, the table is indexed by the top byte of the phase
+#define SIGNAL_TABLE_SIZE 256
+// Largest frame the source will produce: 4 channels of 32 bit samples
+#define SIGNAL_MAX_ALIGN 16
+
+/**
+ * @brief Kinds of test signal
+**/
+enum SignalType
+{
+    SIGNAL_SINE,        // Full-scale sine at frequency
+    SIGNAL_SWEEP,       // Sine swept linearly from frequency to frequency_end
+    SIGNAL_SQUARE,      // Full-scale square wave at frequency
+    SIGNAL_IMPULSE,     // One full-scale sample per period of frequency, silence between
+    SIGNAL_SILENCE      // Mid-scale, for measuring the noise floor
+};
+
+/**
+ * @brief Sample source generating a test signal a sector at a time
+**/
+class SignalSource : public SampleSource
+{
+public:
+    SignalSource();
+
+    /**
+     * @brief Sets up a signal & its format
+     * @param type One of SignalType
+     * @param sample_rate Samples per second
+     * @param bits Bits per sample: 8, 16 or 32
+     * @param channels Channels per frame; all carry the same signal
+     * @param frequency Frequency of the signal in Hz
+     * @param frequency_end Final frequency of a sweep in Hz; ignored by other signals
+     * @param duration_ms Length of the signal
+     * @return false if the format is not supported
+    **/
+    bool configure(int type, uint32_t sample_rate, int bits, int channels, uint32_t frequency,
+                   uint32_t frequency_end, uint32_t duration_ms);
+
+    virtual bool read_sector(uint32_t file_sector, uint8_t *buffer);
+
+private:
+    void rewind();
+    int32_t next_sample();
+    void make_frame();
+
+    int type;
+    uint32_t frames;            // Frames in the whole signal
+    uint64_t start_step;        // Phase step of the first sample, 16 extra fraction bits
+    int64_t sweep_delta;        // Change of the phase step per sample
+    uint32_t phase;
+    uint64_t step;
+    uint32_t frame;             // Frames generated so far
+    uint32_t next_byte;         // Source offset of the next byte read_sector will produce
+    uint8_t pending_frame[SIGNAL_MAX_ALIGN];
+    int pending;                // Bytes in pending_frame
+    int pending_used;           // Bytes of pending_frame already copied out
+};
+
+#endif
@@ -0,0 +1,421 @@
+/**
+ * @file StreamPlayer.cpp
+ * @brief Plays a SampleSource through the DAC from a sample ring filled a sector at a time
+**/
+#include "StreamPlayer.h"
+#include "us_ticker_api.h"
+#include <string.h>
+
+extern bool playing;
+extern int currentSong;
+
+StreamPlayer::StreamPlayer(AnalogOut *dac)
+{
+    this->dac = dac;
+    dac->write_u16(32768);      // DAC is 0-3.3V, so idles at ~1.6V
+    ring_read = 0;
+    ring_write = 0;
+    running = false;
+    ring_live = false;
+    ticking = false;
+    tick_rate = 0;
+    memset(&voice, 0, sizeof(voice));
+    played_bytes = 0;
+    range_bytes = 0;
+    active_Bps = 0;
+    active_rate = 0;
+    underrun_count = 0;
+    request_pending = false;
+    request_us = 0;
+    request_armed = false;
+    request_mark = 0;
+    effect_handler = NULL;
+    seek_seconds = 0;
+    seek_pending = false;
+    memset(&latency, 0, sizeof(latency));
+    memset(&jitter_stats, 0, sizeof(jitter_stats));
+    last_tick_us = 0;
+    tick_seen = false;
+    fill_min = PLAYER_RING_SIZE;
+    fill_max = 0;
+}
+
+void StreamPlayer::mark_request()
+{
+    request_us = us_ticker_read();
+    request_pending = true;
+}
+
+void StreamPlayer::seek(int seconds)
+{
+    __disable_irq();
+    seek_seconds += seconds;
+    seek_pending = true;
+    __enable_irq();
+}
+
+int StreamPlayer::take_seek()
+{
+    __disable_irq();
+    int seconds = seek_seconds;
+    seek_seconds = 0;
+    seek_pending = false;
+    __enable_irq();
+    return seconds;
+}
+
+/**
+ * @brief Ticker interrupt: writes the next sample to the DAC
+**/
+void StreamPlayer::dac_out()
+{
+    uint32_t now = us_ticker_read();
+    if (tick_seen)
+    {
+        uint32_t interval = now - last_tick_us;
+        jitter_stats.count++;
+        jitter_stats.total_us += interval;
+        if (interval < jitter_stats.min_us)
+        {
+            jitter_stats.min_us = interval;
+        }
+        if (interval > jitter_stats.max_us)
+        {
+            jitter_stats.max_us = interval;
+        }
+    }
+    last_tick_us = now;
+    tick_seen = true;
+    int32_t sample = -1;
+    if (ring_live && ring_read != ring_write)
+    {
+        sample = ring[ring_read & (PLAYER_RING_SIZE - 1)];
+        ring_read++;
+        if (request_armed && (int32_t)(ring_read - request_mark) > 0)
+        {
+            request_done(now, true);
+        }
+    }
+    else if (running)
+    {
+        underrun_count++;
+    }
+    // A clip is decoded straight from flash & added to the song's sample, or to the DAC midpoint
+    if (voice.active)
+    {
+        int32_t clip = voice.next();
+        sample = sample < 0 ? 32768 + clip : sample + (clip >> PLAYER_CLIP_SHIFT);
+        sample = sample < 0 ? 0 : (sample > 0xFFFF ? 0xFFFF : sample);
+    }
+    if (sample >= 0)
+    {
+        dac->write_u16(sample);
+    }
+    else if (!ring_live && !voice.active)
+    {
+        // The clip that kept the clock running has ended
+        tick.detach();
+        ticking = false;
+    }
+    if (!ring_live)
+    {
+        return;
+    }
+    uint16_t fill = ring_write - ring_read;
+    if (fill < fill_min)
+    {
+        fill_min = fill;
+    }
+    if (fill > fill_max)
+    {
+        fill_max = fill;
+    }
+}
+
+uint32_t StreamPlayer::position() const
+{
+    uint32_t align = active_rate ? active_Bps / active_rate : 0;
+    if (align == 0)
+    {
+        return 0;
+    }
+    uint32_t read = played_bytes / align;
+    uint32_t waiting = fill();
+    // Just after a chained range starts, the ring still holds the end of the last one
+    return read > waiting ? read - waiting : 0;
+}
+
+void StreamPlayer::fill_window(uint16_t *min, uint16_t *max)
+{
+    __disable_irq();
+    *min = fill_min;
+    *max = fill_max;
+    fill_min = PLAYER_RING_SIZE;
+    fill_max = 0;
+    __enable_irq();
+    if (*min > *max)
+    {
+        // No samples were clocked out
+        *min = *max;
+    }
+}
+
+/**
+ * @brief Ends the timing of the request waiting to take effect
+ * @param started true if its first sample was just played, false if it stopped the play
+**/
+void StreamPlayer::request_done(uint32_t now, bool started)
+{
+    request_armed = false;
+    if (started)
+    {
+        uint32_t elapsed = now - request_us;
+        latency.count++;
+        latency.last_us = elapsed;
+        latency.total_us += elapsed;
+        if (elapsed > latency.max_us)
+        {
+            latency.max_us = elapsed;
+        }
+    }
+    if (effect_handler != NULL)
+    {
+        effect_handler(now);
+    }
+}
+
+/**
+ * @brief Copies samples into the ring, yielding to other threads while it is full
+**/
+void StreamPlayer::push(const uint16_t *samples, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        while (ring_write - ring_read >= PLAYER_RING_SIZE)
+        {
+            Thread::wait(1);
+        }
+        ring[ring_write & (PLAYER_RING_SIZE - 1)] = samples[i];
+        ring_write++;
+    }
+}
+
+int StreamPlayer::play(SampleSource &source, const uint16_t *first_block, int first_samples, uint32_t first_bytes)
+{
+    return play_range(source, 0, source.data_size, first_block, first_samples, first_bytes, false);
+}
+
+void StreamPlayer::stop()
+{
+    if (!ticking)
+    {
+        return;
+    }
+    running = false;
+    while (ring_live && ring_read != ring_write)
+    {
+        Thread::wait(1);
+    }
+    release_clock();
+}
+
+void StreamPlayer::play_clip(const ClipStore &store, int clip)
+{
+    if (clip < 0 || clip >= store.count())
+    {
+        return;
+    }
+    const ClipEntry &entry = store.entry(clip);
+    // The sample interrupt leaves the voice alone until start() sets it active again
+    voice.active = false;
+    voice.start(store.data(clip), entry, tick_rate);
+    // With nothing else playing, the clip runs the sample clock at its own rate. The clock is
+    // attached after the voice is set up, as attaching re-enables interrupts.
+    if (!ticking)
+    {
+        tick_rate = entry.rate;
+        voice.retime(entry.rate);
+        ticking = true;
+        tick.attach_us(this, &StreamPlayer::dac_out, 1000000 / entry.rate);
+    }
+}
+
+/**
+ * @brief Starts the sample clock for a play, taking over from a clip playing on its own
+**/
+void StreamPlayer::start_clock(uint32_t rate)
+{
+    // Once the ring is live the sample interrupt no longer stops the clock at the end of a clip
+    running = true;
+    ring_live = true;
+    ticking = true;
+    tick_rate = rate;
+    voice.retime(rate);
+    tick.attach_us(this, &StreamPlayer::dac_out, 1000000 / rate);
+}
+
+/**
+ * @brief Stops taking samples from the ring, & stops the sample clock unless a clip is playing on it
+**/
+void StreamPlayer::release_clock()
+{
+    ring_live = false;
+    if (!voice.active)
+    {
+        tick.detach();
+        ticking = false;
+    }
+}
+
+int StreamPlayer::play_range(SampleSource &source, uint32_t start, uint32_t end, const uint16_t *first_block,
+                             int first_samples, uint32_t first_bytes, bool chain)
+{
+    const FMT_STRUCT &format = source.format;
+    int align = format.block_align;
+    // Choose the codec once for the whole stream
+    Decoder decoder;
+    if (!open_decoder(format, &decoder))
+    {
+        stop();
+        return PLAY_ERROR;
+    }
+    int song = currentSong;
+    // Without a block, first_bytes are skipped, as after a seek
+    if (first_bytes > end - start)
+    {
+        first_bytes = end - start;
+    }
+
+    // A request takes effect once the DAC reaches the first sample of this play, which a chained
+    // range queues behind the samples still in the ring
+    bool request = request_pending;
+    request_pending = false;
+    if (ticking && ring_live && format.sample_rate == active_rate)
+    {
+        if (request)
+        {
+            request_mark = ring_write;
+            request_armed = true;
+        }
+        if (first_block != NULL)
+        {
+            push(first_block, first_samples);
+        }
+    }
+    else
+    {
+        stop();
+        // Prime the ring with the block decoded ahead of time, then start the sample clock
+        ring_read = 0;
+        ring_write = 0;
+        if (request)
+        {
+            request_mark = 0;
+            request_armed = true;
+        }
+        if (first_block != NULL)
+        {
+            push(first_block, first_samples);
+        }
+        memset(&jitter_stats, 0, sizeof(jitter_stats));
+        jitter_stats.min_us = 0xFFFFFFFF;
+        last_tick_us = 0;
+        tick_seen = false;
+        start_clock(format.sample_rate);
+    }
+    active_Bps = format.sample_rate * align;
+    active_rate = format.sample_rate;
+
+    range_bytes = end - start;
+    played_bytes = first_bytes;
+    uint32_t pos = source.data_start + start + first_bytes;
+    end += source.data_start;
+    uint8_t carry[PLAYER_MAX_ALIGN];
+    int carried = 0;
+    int result = PLAY_DONE;
+    while (pos < end)
+    {
+        if (!playing)
+        {
+            result = PLAY_STOPPED;
+            break;
+        }
+        if (currentSong != song)
+        {
+            result = PLAY_SKIPPED;
+            break;
+        }
+        if (seek_pending)
+        {
+            result = PLAY_SEEKED;
+            break;
+        }
+        uint32_t offset = pos % SECTOR_SIZE;
+        if (!source.read_sector(pos / SECTOR_SIZE, sector))
+        {
+            result = PLAY_ERROR;
+            break;
+        }
+        uint32_t n = SECTOR_SIZE - offset;
+        if (n > end - pos)
+        {
+            n = end - pos;
+        }
+        pos += n;
+        played_bytes += n;
+        const uint8_t *p = sector + offset;
+
+        // Finish a frame split across the sector boundary
+        if (carried > 0)
+        {
+            uint32_t need = align - carried;
+            if (need > n)
+            {
+                need = n;
+            }
+            memcpy(carry + carried, p, need);
+            carried += need;
+            p += need;
+            n -= need;
+            if (carried < align)
+            {
+                continue;
+            }
+            decode_block(decoder, carry, 1, block);
+            push(block, 1);
+            carried = 0;
+        }
+
+        int frames = n / align;
+        while (frames > 0)
+        {
+            int count = frames < PLAYER_BLOCK_SAMPLES ? frames : PLAYER_BLOCK_SAMPLES;
+            decode_block(decoder, p, count, block);
+            push(block, count);
+            p += count * align;
+            frames -= count;
+        }
+        carried = n % align;
+        memcpy(carry, p, carried);
+    }
+
+    // Let the ring drain at the end of a song; stop at once when the user moves on
+    if (result == PLAY_DONE)
+    {
+        if (!chain)
+        {
+            stop();
+        }
+        return result;
+    }
+    running = false;
+    release_clock();
+    // A pause takes effect as the sound stops; a request whose play never reached the DAC is dropped
+    request_armed = false;
+    if (result == PLAY_STOPPED && request_pending)
+    {
+        request_pending = false;
+        request_done(us_ticker_read(), false);
+    }
+    return result;
+}
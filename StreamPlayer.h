@@ -0,0 +1,216 @@
+/**
+ * @file StreamPlayer.h
+ * @brief Plays a SampleSource through the DAC from a sample ring filled a sector at a time
+ * @details Replaces wave_player::play for the music player: the stream arrives already parsed, so
+ * playback can start from a block decoded ahead of time without touching the card first.
+**/
+#ifndef STREAMPLAYER_H
+#define STREAMPLAYER_H
+
+#include "mbed.h"
+#include "rtos.h"
+#include "SampleSource.h"
+#include "Codec.h"
+#include "ClipStore.h"
+
+// Samples held between the decoder and the DAC interrupt; must be a power of two
+#define PLAYER_RING_SIZE 2048
+// Samples decoded per pass over a sector
+#define PLAYER_BLOCK_SAMPLES 128
+// Largest frame (block_align) that can be carried across a sector boundary
+#define PLAYER_MAX_ALIGN CODEC_MAX_ALIGN
+// Right shift of a clip's samples mixed over a song; a clip on its own plays at full scale
+#define PLAYER_CLIP_SHIFT 1
+
+/**
+ * @brief Reasons StreamPlayer::play returns
+**/
+enum PlayResult
+{
+    PLAY_DONE,      // Reached the end of the stream
+    PLAY_STOPPED,   // Paused by the user
+    PLAY_SKIPPED,   // Another song was selected
+    PLAY_SEEKED,    // A seek was requested; take_seek() gives how far
+    PLAY_ERROR      // Unsupported format or card error
+};
+
+/**
+ * @brief Time from a user command to the first sample of the resulting playback
+**/
+struct LatencyStats
+{
+    unsigned count;
+    uint32_t last_us;
+    uint32_t max_us;
+    uint64_t total_us;
+};
+
+/**
+ * @brief Spacing of the sample interrupts during one play
+**/
+struct JitterStats
+{
+    unsigned count;             // Intervals measured
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+};
+
+/**
+ * @brief Streams decoded samples to the DAC at the sample rate of the track
+**/
+class StreamPlayer
+{
+public:
+    /**
+     * @brief Creates a player writing to the given AnalogOut
+     * @param dac DAC the samples are sent to; only p18 works
+    **/
+    StreamPlayer(AnalogOut *dac);
+
+    /**
+     * @brief Plays a parsed source until it ends, the song is paused or another song is selected
+     * @param source Opened source with a parsed format, e.g. a TrackStream or a SignalSource
+     * @param first_block Samples already decoded from the start of the data, or NULL
+     * @param first_samples Number of samples in first_block
+     * @param first_bytes Bytes of sample data first_block was decoded from; with no first_block, bytes
+     * of sample data to skip
+     * @return One of PlayResult
+    **/
+    int play(SampleSource &source, const uint16_t *first_block, int first_samples, uint32_t first_bytes);
+
+    /**
+     * @brief Plays part of a source's sample data, optionally running on into the next part
+     * @details With chain set, reaching the end leaves the sample clock running & the ring full, so a
+     * following call for the next range of the same format continues without a gap. stop() ends a
+     * chain that is not continued.
+     * @param start First byte of sample data to play, from the start of the data; whole frames
+     * @param end Byte after the last one to play
+     * @param chain true if another range follows on from end
+     * @return One of PlayResult
+    **/
+    int play_range(SampleSource &source, uint32_t start, uint32_t end, const uint16_t *first_block, int first_samples,
+                   uint32_t first_bytes, bool chain);
+
+    /**
+     * @brief Lets the ring drain & stops the sample clock left running by a chained play_range
+    **/
+    void stop();
+
+    /**
+     * @brief Timestamps a user command so the time until its audio starts is measured
+     * @details Safe to call from interrupt context.
+    **/
+    void mark_request();
+
+    /**
+     * @brief Sets a function called when a request marked by mark_request() takes effect: from the
+     * sample interrupt as the first sample of the play it starts reaches the DAC, or from the playing
+     * thread as the play it stops ends
+     * @param handler Takes the us_ticker time of the effect; must not block
+    **/
+    void attach_effect(void (*handler)(uint32_t us)) { effect_handler = handler; }
+
+    /**
+     * @brief Asks the current play to jump forwards or backwards
+     * @details Safe to call from any thread. Requests made before the play returns add up.
+     * @param seconds Distance to jump, negative to go back
+    **/
+    void seek(int seconds);
+
+    /**
+     * @brief Takes the distance of the pending seek, in seconds, & clears it
+    **/
+    int take_seek();
+
+    /**
+     * @brief Plays a clip from flash, mixed over the song playing or on its own
+     * @details Safe to call from any thread. Over a song the clip is stepped at the song's rate; with
+     * nothing playing it starts the sample clock at its own rate & stops it at its end. A clip plays
+     * on through pauses & skips until it ends; a new clip replaces it.
+     * @param clip Clip number in the store; ignored if out of range
+    **/
+    void play_clip(const ClipStore &store, int clip);
+
+    /**
+     * @brief Ends the clip playing, looped or not
+    **/
+    void stop_clip() { voice.active = false; }
+    bool clip_playing() const { return voice.active; }
+
+    const LatencyStats &start_latency() const { return latency; }
+    unsigned underruns() const { return underrun_count; }
+    /**
+     * @brief Sample interrupt spacing of the current or last play, to the 1 us of the us_ticker
+    **/
+    const JitterStats &jitter() const { return jitter_stats; }
+
+    /**
+     * @brief Byte rate & sample rate of the stream being played, 0 when stopped
+    **/
+    uint32_t stream_Bps() const { return active_Bps; }
+    uint32_t stream_rate() const { return active_rate; }
+
+    /**
+     * @brief Bytes of the current or last range read so far, & the length of that range
+    **/
+    uint32_t played() const { return played_bytes; }
+    uint32_t length() const { return range_bytes; }
+
+    /**
+     * @brief Samples of the current or last range the DAC has played: those read, less those still in the ring
+    **/
+    uint32_t position() const;
+
+    /**
+     * @brief Samples waiting in the ring, & whether a stream is feeding it
+    **/
+    uint32_t fill() const { return ring_write - ring_read; }
+    bool streaming() const { return running; }
+
+    /**
+     * @brief Takes the lowest & highest ring fill seen by the sample interrupt since the last call
+     * @details Both are 0 if the sample clock did not run.
+    **/
+    void fill_window(uint16_t *min, uint16_t *max);
+
+private:
+    void dac_out();
+    void push(const uint16_t *samples, int count);
+    void request_done(uint32_t now, bool started);
+    void start_clock(uint32_t rate);
+    void release_clock();
+
+    AnalogOut *dac;
+    Ticker tick;
+    uint16_t ring[PLAYER_RING_SIZE];
+    volatile uint32_t ring_read;
+    volatile uint32_t ring_write;
+    volatile bool running;
+    volatile bool ring_live;    // The sample interrupt takes samples from the ring
+    volatile bool ticking;      // Sample clock attached, possibly left running between chained ranges or for a clip
+    volatile uint32_t tick_rate;
+    ClipVoice voice;
+    volatile unsigned underrun_count;
+    volatile uint16_t fill_min;
+    volatile uint16_t fill_max;
+    volatile uint32_t active_Bps;
+    volatile uint32_t active_rate;
+    volatile uint32_t played_bytes;
+    volatile uint32_t range_bytes;
+    volatile bool request_pending;
+    volatile int seek_seconds;
+    volatile bool seek_pending;
+    volatile uint32_t request_us;
+    volatile bool request_armed;    // A request waits for the sample at request_mark to be played
+    volatile uint32_t request_mark;
+    void (*effect_handler)(uint32_t us);
+    LatencyStats latency;
+    volatile uint32_t last_tick_us;
+    volatile bool tick_seen;
+    JitterStats jitter_stats;
+    uint8_t sector[SECTOR_SIZE];
+    uint16_t block[PLAYER_BLOCK_SAMPLES];
+};
+
+#endif
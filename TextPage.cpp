@@ -0,0 +1,77 @@
+/**
+ * @file TextPage.cpp
+ * @brief Full-screen text page on the uLCD that sends only the characters that changed
+**/
+#include "TextPage.h"
+#include <stdarg.h>
+#include <string.h>
+
+TextPage::TextPage(uLCD_4DGL *lcd)
+{
+    this->lcd = lcd;
+    memset(wanted, ' ', sizeof(wanted));
+    memset(shown, ' ', sizeof(shown));
+}
+
+void TextPage::clear()
+{
+    lcd->cls();
+    memset(wanted, ' ', sizeof(wanted));
+    memset(shown, ' ', sizeof(shown));
+}
+
+void TextPage::print(int row, const char *format, ...)
+{
+    if (row < 0 || row >= TEXT_ROWS)
+    {
+        return;
+    }
+    char line[TEXT_COLUMNS + 1];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (len < 0)
+    {
+        len = 0;
+    }
+    if (len > TEXT_COLUMNS)
+    {
+        len = TEXT_COLUMNS;
+    }
+    memcpy(wanted[row], line, len);
+    memset(wanted[row] + len, ' ', TEXT_COLUMNS - len);
+}
+
+uint32_t TextPage::present()
+{
+    uint32_t sent = 0;
+    for (int row = 0; row < TEXT_ROWS; row++)
+    {
+        int col = 0;
+        while (col < TEXT_COLUMNS)
+        {
+            if (wanted[row][col] == shown[row][col])
+            {
+                col++;
+                continue;
+            }
+            // Extend the run over single unchanged characters, which cost less to resend than a move
+            int end = col + 1;
+            while (end < TEXT_COLUMNS && (wanted[row][end] != shown[row][end] ||
+                   (end + 1 < TEXT_COLUMNS && wanted[row][end + 1] != shown[row][end + 1])))
+            {
+                end++;
+            }
+            lcd->locate(col, row);
+            for (int i = col; i < end; i++)
+            {
+                lcd->putc(wanted[row][i]);
+                shown[row][i] = wanted[row][i];
+            }
+            sent += TEXT_MOVE_BYTES + (end - col) * TEXT_CHAR_BYTES;
+            col = end;
+        }
+    }
+    return sent;
+}
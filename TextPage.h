@@ -0,0 +1,51 @@
+/**
+ * @file TextPage.h
+ * @brief Full-screen text page on the uLCD that sends only the characters that changed
+ * @details The page keeps what it last drew next to what it should show. present() walks the two
+ * and sends each run of changed characters as one cursor move & its characters, so a page that
+ * updates a few numbers a few times a second costs the serial link a few dozen bytes.
+**/
+#ifndef TEXTPAGE_H
+#define TEXTPAGE_H
+
+#include "mbed.h"
+#include "uLCD_4DGL.h"
+
+// Character cells of the uLCD in its default 7x8 font
+#define TEXT_COLUMNS 18
+#define TEXT_ROWS 16
+// Bytes the uLCD takes to move the cursor & to draw one character
+#define TEXT_MOVE_BYTES 5
+#define TEXT_CHAR_BYTES 3
+
+/**
+ * @brief Shadowed text screen with changed-characters-only output
+**/
+class TextPage
+{
+public:
+    TextPage(uLCD_4DGL *lcd);
+
+    /**
+     * @brief Clears the screen & the page
+    **/
+    void clear();
+
+    /**
+     * @brief Sets one row of the page, padded with spaces & cut to the width of the screen
+    **/
+    void print(int row, const char *format, ...);
+
+    /**
+     * @brief Sends the characters that differ from what is on the screen
+     * @return Bytes sent to the uLCD
+    **/
+    uint32_t present();
+
+private:
+    uLCD_4DGL *lcd;
+    char wanted[TEXT_ROWS][TEXT_COLUMNS];
+    char shown[TEXT_ROWS][TEXT_COLUMNS];
+};
+
+#endif
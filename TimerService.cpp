@@ -0,0 +1,156 @@
+/**
+ * @file TimerService.cpp
+ * @brief One thread running the player's short periodic jobs & one-shots from a timer wheel
+**/
+#include "TimerService.h"
+#include "us_ticker_api.h"
+#include <string.h>
+
+TimerService::TimerService()
+{
+    memset(entries, 0, sizeof(entries));
+    memset(slots, TIMER_NO_JOB, sizeof(slots));
+    tick = 0;
+}
+
+/**
+ * @brief Puts a job in the slot it is due in
+ * @param delay Ticks from the current one, at least 1
+**/
+void TimerService::insert(int id, uint32_t delay)
+{
+    uint32_t due = tick + delay;
+    int slot = due & (TIMER_WHEEL_SLOTS - 1);
+    entries[id].rounds = (delay - 1) / TIMER_WHEEL_SLOTS;
+    entries[id].next = slots[slot];
+    slots[slot] = id;
+}
+
+int TimerService::schedule(const char *name, uint32_t delay_ms, uint32_t period, TimerJob job)
+{
+    uint32_t delay = (delay_ms + TIMER_TICK_MS - 1) / TIMER_TICK_MS;
+    if (delay == 0)
+    {
+        delay = 1;
+    }
+    __disable_irq();
+    int id = 0;
+    while (id < TIMER_MAX_JOBS && entries[id].job != NULL)
+    {
+        id++;
+    }
+    if (id == TIMER_MAX_JOBS)
+    {
+        __enable_irq();
+        return -1;
+    }
+    TimerEntry &entry = entries[id];
+    entry.name = name;
+    entry.job = job;
+    entry.period = period;
+    entry.runs = 0;
+    entry.max_us = 0;
+    entry.active = true;
+    insert(id, delay);
+    __enable_irq();
+    return id;
+}
+
+int TimerService::every(const char *name, uint32_t period_ms, TimerJob job)
+{
+    uint32_t period = (period_ms + TIMER_TICK_MS - 1) / TIMER_TICK_MS;
+    return schedule(name, period_ms, period ? period : 1, job);
+}
+
+int TimerService::after(const char *name, uint32_t delay_ms, TimerJob job)
+{
+    return schedule(name, delay_ms, 0, job);
+}
+
+void TimerService::cancel(int id)
+{
+    if (id >= 0 && id < TIMER_MAX_JOBS)
+    {
+        // Taken out of its slot the next time the slot comes round
+        entries[id].active = false;
+    }
+}
+
+/**
+ * @brief Runs the jobs due in the current tick's slot & puts periodic ones back in the wheel
+**/
+void TimerService::run_slot()
+{
+    int slot = tick & (TIMER_WHEEL_SLOTS - 1);
+    // Detach the slot's list, so jobs rescheduled into this slot wait for the next turn
+    __disable_irq();
+    uint8_t id = slots[slot];
+    slots[slot] = TIMER_NO_JOB;
+    __enable_irq();
+    while (id != TIMER_NO_JOB)
+    {
+        TimerEntry &entry = entries[id];
+        uint8_t next = entry.next;
+        bool due = false;
+        __disable_irq();
+        if (!entry.active)
+        {
+            // Cancelled; the entry is free again
+            entry.job = NULL;
+        }
+        else if (entry.rounds > 0)
+        {
+            entry.rounds--;
+            entry.next = slots[slot];
+            slots[slot] = id;
+        }
+        else
+        {
+            due = true;
+        }
+        __enable_irq();
+        if (due)
+        {
+            uint32_t start = us_ticker_read();
+            entry.job();
+            uint32_t elapsed = us_ticker_read() - start;
+            entry.runs++;
+            if (elapsed > entry.max_us)
+            {
+                entry.max_us = elapsed;
+            }
+            __disable_irq();
+            if (entry.period == 0 || !entry.active)
+            {
+                entry.active = false;
+                entry.job = NULL;
+            }
+            else
+            {
+                insert(id, entry.period);
+            }
+            __enable_irq();
+        }
+        id = next;
+    }
+}
+
+void TimerService::run()
+{
+    uint32_t last_us = us_ticker_read();
+    uint32_t owed_us = 0;
+    while (true)
+    {
+        Thread::wait(TIMER_TICK_MS);
+        // Catch up on every tick that passed, so the jobs keep time while others hold the CPU
+        uint32_t now = us_ticker_read();
+        owed_us += now - last_us;
+        last_us = now;
+        while (owed_us >= TIMER_TICK_MS * 1000)
+        {
+            owed_us -= TIMER_TICK_MS * 1000;
+            tick++;
+            run_slot();
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/**
+ * @file TimerService.h
+ * @brief One thread running the player's short periodic jobs & one-shots from a timer wheel
+ * @details Each job sits in the wheel slot of the tick it is due in, with the number of turns of the
+ * wheel still to wait, so a tick only looks at one slot however many jobs there are. Jobs run one
+ * after another on the service thread's stack & must not block; work that waits on the card, the
+ * LCD or a serial link keeps a thread of its own.
+**/
+#ifndef TIMERSERVICE_H
+#define TIMERSERVICE_H
+
+#include "mbed.h"
+#include "rtos.h"
+
+// Resolution of the wheel
+#define TIMER_TICK_MS 10
+// Slots of the wheel; a power of two
+#define TIMER_WHEEL_SLOTS 32
+// Largest number of jobs scheduled at once
+#define TIMER_MAX_JOBS 12
+// Marks the end of a slot's list
+#define TIMER_NO_JOB 0xFF
+
+typedef void (*TimerJob)(void);
+
+/**
+ * @brief One scheduled job
+**/
+struct TimerEntry
+{
+    const char *name;
+    TimerJob job;
+    uint32_t period;        // Ticks between runs, 0 for a one-shot
+    uint32_t rounds;        // Turns of the wheel still to wait
+    uint32_t runs;
+    uint32_t max_us;        // Longest run, to catch jobs that should have a thread
+    uint8_t next;           // Next job in the same slot
+    bool active;
+};
+
+/**
+ * @brief Timer wheel & the thread that runs it
+**/
+class TimerService
+{
+public:
+    TimerService();
+
+    /**
+     * @brief Runs a job every period
+     * @param name Short name for reports, e.g. "leds"
+     * @param period_ms Time between runs, rounded up to whole ticks
+     * @return Job number, or -1 if TIMER_MAX_JOBS are scheduled
+    **/
+    int every(const char *name, uint32_t period_ms, TimerJob job);
+
+    /**
+     * @brief Runs a job once, after a delay
+     * @return Job number, or -1 if TIMER_MAX_JOBS are scheduled
+    **/
+    int after(const char *name, uint32_t delay_ms, TimerJob job);
+
+    /**
+     * @brief Stops a job before it next runs
+    **/
+    void cancel(int id);
+
+    /**
+     * @brief Body of the service thread. Never returns.
+    **/
+    void run();
+
+    const TimerEntry &entry(int id) const { return entries[id]; }
+
+private:
+    int schedule(const char *name, uint32_t delay_ms, uint32_t period, TimerJob job);
+    void insert(int id, uint32_t delay);
+    void run_slot();
+
+    TimerEntry entries[TIMER_MAX_JOBS];
+    uint8_t slots[TIMER_WHEEL_SLOTS];
+    volatile uint32_t tick;         // Ticks run so far
+};
+
+#endif
@@ -0,0 +1,266 @@
+/**
+ * @file TrackCache.cpp
+ * @brief Keeps the neighbours of the current song warm so Prev/Next start from RAM
+**/
+#include "TrackCache.h"
+
+TrackCache::TrackCache(SDFileSystem *fs, const LibraryIndex *library)
+{
+    this->fs = fs;
+    this->library = library;
+    for (int i = 0; i < TRACK_CACHE_ENTRIES; i++)
+    {
+        entries[i].song = -1;
+        entries[i].pinned = false;
+        entries[i].filling = false;
+        entries[i].block_samples = 0;
+        entries[i].block_bytes = 0;
+    }
+    current = -1;
+    failed = -1;
+    fill_song = -1;
+    forget_count = 0;
+    hit_count = 0;
+    miss_count = 0;
+}
+
+/**
+ * @brief Finds the warm entry of a song
+**/
+WarmEntry *TrackCache::find(int song)
+{
+    for (int i = 0; i < TRACK_CACHE_ENTRIES; i++)
+    {
+        if (entries[i].song == song)
+        {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Picks an unpinned entry holding none of the given songs, preferring empty ones
+**/
+WarmEntry *TrackCache::victim(int keep1, int keep2, int keep3)
+{
+    WarmEntry *pick = NULL;
+    for (int i = 0; i < TRACK_CACHE_ENTRIES; i++)
+    {
+        WarmEntry *entry = &entries[i];
+        if (entry->pinned || entry->filling || (entry->song >= 0 && (entry->song == keep1 || entry->song == keep2 || entry->song == keep3)))
+        {
+            continue;
+        }
+        if (entry->song < 0)
+        {
+            return entry;
+        }
+        if (pick == NULL)
+        {
+            pick = entry;
+        }
+    }
+    return pick;
+}
+
+/**
+ * @brief Opens a song, parses its header & decodes its first block into an entry
+ * @details Leaves entry->song to the caller, which publishes the entry under the lock.
+ * @param buffer Sector buffer of the calling thread
+**/
+bool TrackCache::warm(WarmEntry *entry, int song, uint8_t *buffer)
+{
+    TrackStream &stream = entry->stream;
+    Decoder decoder;
+    if (!stream.open(fs, library->handle(song)) || !stream.parse_header(buffer) || !open_decoder(stream.format, &decoder))
+    {
+        stream.close();
+        return false;
+    }
+
+    // Decode the whole frames of the first data sector of the song's range
+    library->data_range(song, stream.format, stream.data_size, &entry->start, &entry->end);
+    uint32_t pos = stream.data_start + entry->start;
+    uint32_t offset = pos % SECTOR_SIZE;
+    if (!stream.read_sector(pos / SECTOR_SIZE, buffer))
+    {
+        stream.close();
+        return false;
+    }
+    uint32_t n = SECTOR_SIZE - offset;
+    if (n > entry->end - entry->start)
+    {
+        n = entry->end - entry->start;
+    }
+    int frames = n / stream.format.block_align;
+    if (frames > WARM_BLOCK_SAMPLES)
+    {
+        frames = WARM_BLOCK_SAMPLES;
+    }
+    entry->block_samples = decode_block(decoder, buffer + offset, frames, entry->block);
+    entry->block_bytes = entry->block_samples * stream.format.block_align;
+    return true;
+}
+
+WarmEntry *TrackCache::acquire(int song)
+{
+    int count = library->count();
+    if (song < 0 || song >= count)
+    {
+        return NULL;
+    }
+    lock.lock();
+    current = song;
+    failed = -1;
+    // The song is already being read in the background, so it is ready sooner than if opened again
+    while (fill_song == song)
+    {
+        lock.unlock();
+        Thread::wait(1);
+        lock.lock();
+    }
+    WarmEntry *entry = find(song);
+    if (entry != NULL)
+    {
+        hit_count++;
+    }
+    else
+    {
+        miss_count++;
+        entry = victim(song, (song + 1) % count, (song + count - 1) % count);
+        if (entry == NULL)
+        {
+            // The neighbours give way while another entry is being filled
+            entry = victim(song, song, song);
+        }
+        if (entry != NULL)
+        {
+            entry->song = -1;
+            if (warm(entry, song, scratch))
+            {
+                entry->song = song;
+            }
+            else
+            {
+                entry = NULL;
+            }
+        }
+    }
+    if (entry != NULL)
+    {
+        entry->pinned = true;
+    }
+    lock.unlock();
+    return entry;
+}
+
+void TrackCache::release(WarmEntry *entry)
+{
+    lock.lock();
+    entry->pinned = false;
+    lock.unlock();
+}
+
+WarmEntry *TrackCache::advance(WarmEntry *entry, int song)
+{
+    lock.lock();
+    WarmEntry *other = find(song);
+    if (other != NULL && other != entry && !other->pinned)
+    {
+        other->song = -1;
+        other->stream.close();
+    }
+    library->data_range(song, entry->stream.format, entry->stream.data_size, &entry->start, &entry->end);
+    entry->block_samples = 0;
+    entry->block_bytes = 0;
+    entry->song = song;
+    current = song;
+    failed = -1;
+    lock.unlock();
+    return entry;
+}
+
+void TrackCache::forget(int song)
+{
+    lock.lock();
+    forget_count++;
+    const TrackHandle &moved = library->handle(song);
+    for (int i = 0; i < TRACK_CACHE_ENTRIES; i++)
+    {
+        WarmEntry *entry = &entries[i];
+        if (entry->song < 0)
+        {
+            continue;
+        }
+        const TrackHandle &held = library->handle(entry->song);
+        if (held.start_cluster != moved.start_cluster || held.size != moved.size)
+        {
+            continue;
+        }
+        // An entry being played keeps its stream until it is released, but is never found again
+        entry->song = -1;
+        if (!entry->pinned)
+        {
+            entry->stream.close();
+        }
+    }
+    lock.unlock();
+}
+
+bool TrackCache::warm_neighbours()
+{
+    WarmEntry *entry = NULL;
+    int wanted = -1;
+    lock.lock();
+    int count = library->count();
+    int song = current;
+    if (song >= 0 && count > 1)
+    {
+        int neighbours[2] = {(song + 1) % count, (song + count - 1) % count};
+        for (int i = 0; i < 2 && entry == NULL; i++)
+        {
+            if (neighbours[i] == failed || find(neighbours[i]) != NULL)
+            {
+                continue;
+            }
+            entry = victim(song, neighbours[0], neighbours[1]);
+            if (entry == NULL)
+            {
+                break;
+            }
+            wanted = neighbours[i];
+        }
+    }
+    if (entry == NULL)
+    {
+        lock.unlock();
+        return false;
+    }
+    entry->song = -1;
+    entry->filling = true;
+    fill_song = wanted;
+    unsigned forgets = forget_count;
+    lock.unlock();
+
+    bool ok = warm(entry, wanted, fill_scratch);
+
+    // Not published if the song's clusters moved meanwhile, or it was warmed into another entry
+    lock.lock();
+    if (ok && forget_count == forgets && find(wanted) == NULL)
+    {
+        entry->song = wanted;
+    }
+    else if (ok)
+    {
+        entry->stream.close();
+    }
+    else if (forget_count == forgets && current == song)
+    {
+        failed = wanted;
+    }
+    entry->filling = false;
+    fill_song = -1;
+    lock.unlock();
+    return true;
+}
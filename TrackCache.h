@@ -0,0 +1,108 @@
+/**
+ * @file TrackCache.h
+ * @brief Keeps the neighbours of the current song warm so Prev/Next start from RAM
+ * @details Each entry holds an opened TrackStream (stream descriptor & cluster link map) and the first
+ * block of samples already decoded. Entries for the previous and next song in play order are filled
+ * in the background while the current song plays.
+**/
+#ifndef TRACKCACHE_H
+#define TRACKCACHE_H
+
+#include "mbed.h"
+#include "rtos.h"
+#include "TrackStream.h"
+#include "StreamPlayer.h"
+#include "LibraryIndex.h"
+
+// Warm entries: the current song plus its previous & next neighbours
+#define TRACK_CACHE_ENTRIES 3
+// Samples decoded ahead of time for each warm entry
+#define WARM_BLOCK_SAMPLES 256
+
+/**
+ * @brief Ready-to-play state of one song
+**/
+struct WarmEntry
+{
+    int song;                               // Index into the song list, -1 when empty
+    bool pinned;                            // Being played; must not be evicted
+    bool filling;                           // Being warmed outside the lock; neither found nor evicted
+    TrackStream stream;                     // Parsed descriptor & cluster link map
+    uint32_t start;                         // First byte of sample data the song plays
+    uint32_t end;                           // Byte after the last one the song plays
+    uint16_t block[WARM_BLOCK_SAMPLES];     // First decoded samples of the song
+    int block_samples;                      // Samples held in block
+    uint32_t block_bytes;                   // Bytes of sample data block was decoded from
+};
+
+/**
+ * @brief Warm-state cache for the previous & next songs in play order
+**/
+class TrackCache
+{
+public:
+    /**
+     * @brief Creates an empty cache
+     * @param fs File system holding the songs
+     * @param library Index of the songs in play order; songs are opened from their handles
+    **/
+    TrackCache(SDFileSystem *fs, const LibraryIndex *library);
+
+    /**
+     * @brief Pins the warm state of a song, warming it on the spot on a miss
+     * @param song Index of the song to play
+     * @return Entry to play from, or NULL if the song could not be opened
+    **/
+    WarmEntry *acquire(int song);
+
+    /**
+     * @brief Unpins an entry; it stays warm as a neighbour of the next song
+    **/
+    void release(WarmEntry *entry);
+
+    /**
+     * @brief Moves a pinned entry on to the next virtual track of the same file
+     * @details The stream & its cluster link map are kept; only the byte range changes, so nothing is
+     * read from the card. Another entry warmed for the same song is dropped.
+     * @return The same entry, now holding song
+    **/
+    WarmEntry *advance(WarmEntry *entry, int song);
+
+    /**
+     * @brief Warms one missing neighbour of the current song; called from the background thread
+     * @details The entry is claimed under the lock, filled from the card without it & published under
+     * it again, so a skip never waits for a neighbour being warmed, unless it is the song skipped to.
+     * @return true if an entry was warmed
+    **/
+    bool warm_neighbours();
+
+    /**
+     * @brief Drops the warm state of a song whose clusters have moved, & of other tracks of its file
+     * @details A pinned entry finishes playing from its old clusters, which are freed but not
+     * overwritten while the player is busy, and is then reused like an empty entry.
+    **/
+    void forget(int song);
+
+    unsigned hits() const { return hit_count; }
+    unsigned misses() const { return miss_count; }
+
+private:
+    WarmEntry *find(int song);
+    WarmEntry *victim(int keep1, int keep2, int keep3);
+    bool warm(WarmEntry *entry, int song, uint8_t *buffer);
+
+    SDFileSystem *fs;
+    const LibraryIndex *library;
+    WarmEntry entries[TRACK_CACHE_ENTRIES];
+    Mutex lock;
+    volatile int current;
+    int failed;                 // Neighbour that could not be opened; not retried until the song changes
+    volatile int fill_song;     // Neighbour being warmed outside the lock, -1 if none
+    unsigned forget_count;      // Calls of forget(), which void a fill under way
+    unsigned hit_count;
+    unsigned miss_count;
+    uint8_t scratch[SECTOR_SIZE];
+    uint8_t fill_scratch[SECTOR_SIZE];
+};
+
+#endif
@@ -0,0 +1,376 @@
+/**
+ * @file TrackStream.cpp
+ * @brief Sector-level reader for a WAV file on the SD card
+**/
+#include "TrackStream.h"
+#include "Codec.h"
+#include <string.h>
+
+Mutex sdMutex;
+
+// RIFF chunk IDs as read little-endian from the file
+#define CHUNK_WAVE 0x45564157
+#define CHUNK_FMT  0x20746d66
+#define CHUNK_DATA 0x61746164
+
+// FAT sector shared by every stream while walking cluster chains; guarded by sdMutex
+static uint8_t fatBuffer[SECTOR_SIZE];
+static uint32_t fatBufferSector = 0;
+// Path lookup work area, kept off the thread stacks; guarded by sdMutex
+static FIL lookupFile;
+static char lookupPath[_MAX_LFN + 8];
+
+void invalidate_fat_cache()
+{
+    fatBufferSector = 0;
+}
+
+/**
+ * @brief Reads a little-endian 32 bit value from a byte buffer
+**/
+static uint32_t load_dword(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+TrackStream::TrackStream()
+{
+    fs = NULL;
+    close();
+}
+
+bool TrackStream::open(SDFileSystem *fs, const char *path)
+{
+    close();
+    TrackHandle handle;
+    sdMutex.lock();
+    snprintf(lookupPath, sizeof(lookupPath), "%d:/%s", fs->_fsid, path);
+    FRESULT res = f_open(&lookupFile, lookupPath, FA_READ);
+    if (res == FR_OK)
+    {
+        handle.start_cluster = lookupFile.sclust;
+        handle.size = lookupFile.fsize;
+        f_close(&lookupFile);
+    }
+    sdMutex.unlock();
+    return res == FR_OK && open(fs, handle);
+}
+
+bool TrackStream::open(SDFileSystem *fs, const TrackHandle &handle)
+{
+    close();
+    if (handle.start_cluster < 2 || handle.size == 0)
+    {
+        return false;
+    }
+    this->fs = fs;
+    start_cluster = handle.start_cluster;
+    file_size = handle.size;
+    restart_map();
+    return true;
+}
+
+TrackHandle TrackStream::handle() const
+{
+    TrackHandle handle;
+    handle.start_cluster = start_cluster;
+    handle.size = file_size;
+    return handle;
+}
+
+void TrackStream::close()
+{
+    fs = NULL;
+    start_cluster = 0;
+    file_size = 0;
+    data_start = 0;
+    data_size = 0;
+    memset(&format, 0, sizeof(format));
+    restart_map();
+}
+
+/**
+ * @brief Drops the cluster link map so it is rebuilt from the first cluster of the file
+**/
+void TrackStream::restart_map()
+{
+    walk_cluster = start_cluster;
+    map_base = 0;
+    map_sectors = 0;
+    num_extents = 0;
+    num_fragments = 0;
+}
+
+/**
+ * @brief Appends the clusters whose links live in the next FAT sector of the chain to the map
+ * @details Costs at most one sector read. Once the map is full it slides forward, keeping only the
+ * run currently being appended to.
+ * @return false at the end of the chain, on a corrupt chain or on card error
+**/
+bool TrackStream::extend_map()
+{
+    FATFS *vol = &fs->_fs;
+    if (walk_cluster == 0 || (vol->fs_type != FS_FAT16 && vol->fs_type != FS_FAT32))
+    {
+        return false;
+    }
+    if (num_extents == TRACK_MAX_EXTENTS)
+    {
+        Extent last = extents[num_extents - 1];
+        map_base += map_sectors - last.count;
+        map_sectors = last.count;
+        extents[0] = last;
+        num_extents = 1;
+    }
+
+    bool fat32 = (vol->fs_type == FS_FAT32);
+    uint32_t per_sector = fat32 ? SECTOR_SIZE / 4 : SECTOR_SIZE / 2;
+    uint32_t fat_sector = vol->fatbase + walk_cluster / per_sector;
+    bool ok = true;
+    sdMutex.lock();
+    if (fatBufferSector != fat_sector)
+    {
+        fatBufferSector = 0;
+        if (fs->disk_read(fatBuffer, fat_sector) != 0)
+        {
+            sdMutex.unlock();
+            return false;
+        }
+        fatBufferSector = fat_sector;
+    }
+    while (walk_cluster != 0 && vol->fatbase + walk_cluster / per_sector == fat_sector)
+    {
+        // Merge the cluster into the last run if it directly follows it
+        uint32_t sector = vol->database + (walk_cluster - 2) * vol->csize;
+        if (num_extents > 0 && extents[num_extents - 1].sector + extents[num_extents - 1].count == sector)
+        {
+            extents[num_extents - 1].count += vol->csize;
+        }
+        else if (num_extents < TRACK_MAX_EXTENTS)
+        {
+            extents[num_extents].sector = sector;
+            extents[num_extents].count = vol->csize;
+            num_extents++;
+            num_fragments++;
+        }
+        else
+        {
+            break;
+        }
+        map_sectors += vol->csize;
+
+        // Follow the link to the next cluster
+        uint32_t index = walk_cluster % per_sector;
+        uint32_t next;
+        bool last;
+        if (fat32)
+        {
+            next = load_dword(fatBuffer + index * 4) & 0x0FFFFFFF;
+            last = next >= 0x0FFFFFF8;
+        }
+        else
+        {
+            next = fatBuffer[index * 2] | (fatBuffer[index * 2 + 1] << 8);
+            last = next >= 0xFFF8;
+        }
+        if (last)
+        {
+            next = 0;
+        }
+        else if (next < 2 || next >= vol->n_fatent)
+        {
+            next = 0;
+            ok = false;
+        }
+        walk_cluster = next;
+    }
+    sdMutex.unlock();
+    return ok;
+}
+
+/**
+ * @brief Finds the card sector holding a file sector, extending the map as needed
+**/
+bool TrackStream::map_sector(uint32_t file_sector, uint32_t *disk_sector)
+{
+    if (fs == NULL || file_sector >= (file_size + SECTOR_SIZE - 1) / SECTOR_SIZE)
+    {
+        return false;
+    }
+    if (file_sector < map_base)
+    {
+        restart_map();
+    }
+    while (file_sector >= map_base + map_sectors)
+    {
+        if (!extend_map())
+        {
+            return false;
+        }
+    }
+    uint32_t offset = file_sector - map_base;
+    int i = 0;
+    while (offset >= extents[i].count)
+    {
+        offset -= extents[i].count;
+        i++;
+    }
+    *disk_sector = extents[i].sector + offset;
+    return true;
+}
+
+uint32_t TrackStream::run(uint32_t file_sector, uint32_t *disk_sector)
+{
+    if (!map_sector(file_sector, disk_sector))
+    {
+        return 0;
+    }
+    // The sector is in the map, so its extent is found as map_sector found it
+    uint32_t offset = file_sector - map_base;
+    int i = 0;
+    while (offset >= extents[i].count)
+    {
+        offset -= extents[i].count;
+        i++;
+    }
+    uint32_t count = extents[i].count - offset;
+    uint32_t left = (file_size + SECTOR_SIZE - 1) / SECTOR_SIZE - file_sector;
+    return count < left ? count : left;
+}
+
+uint32_t TrackStream::cluster(uint32_t file_sector)
+{
+    uint32_t disk_sector;
+    if (!map_sector(file_sector, &disk_sector))
+    {
+        return 0;
+    }
+    FATFS *vol = &fs->_fs;
+    return (disk_sector - vol->database) / vol->csize + 2;
+}
+
+void TrackStream::seek_hint(uint32_t file_sector, uint32_t cluster)
+{
+    if (fs == NULL || cluster < 2 || (file_sector >= map_base && file_sector < map_base + map_sectors))
+    {
+        return;
+    }
+    walk_cluster = cluster;
+    map_base = file_sector;
+    map_sectors = 0;
+    num_extents = 0;
+}
+
+bool TrackStream::read_sector(uint32_t file_sector, uint8_t *buffer)
+{
+    uint32_t disk_sector;
+    if (!map_sector(file_sector, &disk_sector))
+    {
+        return false;
+    }
+    sdMutex.lock();
+    int err = fs->disk_read(buffer, disk_sector);
+    sdMutex.unlock();
+    return err == 0;
+}
+
+bool TrackStream::write_sector(uint32_t file_sector, const uint8_t *buffer)
+{
+    uint32_t disk_sector;
+    if (!map_sector(file_sector, &disk_sector))
+    {
+        return false;
+    }
+    sdMutex.lock();
+    int err = fs->disk_write(buffer, disk_sector);
+    sdMutex.unlock();
+    return err == 0;
+}
+
+/**
+ * @brief Copies a byte range of the file, reading sectors through scratch
+ * @param loaded File sector currently held in scratch; updated as sectors are read
+**/
+static bool read_range(TrackStream *stream, uint32_t offset, void *dest, uint32_t length, uint8_t *scratch, uint32_t *loaded)
+{
+    uint8_t *out = (uint8_t *)dest;
+    while (length > 0)
+    {
+        uint32_t sector = offset / SECTOR_SIZE;
+        uint32_t skip = offset % SECTOR_SIZE;
+        uint32_t n = SECTOR_SIZE - skip;
+        if (n > length)
+        {
+            n = length;
+        }
+        if (*loaded != sector)
+        {
+            if (!stream->read_sector(sector, scratch))
+            {
+                *loaded = 0xFFFFFFFF;
+                return false;
+            }
+            *loaded = sector;
+        }
+        memcpy(out, scratch + skip, n);
+        out += n;
+        offset += n;
+        length -= n;
+    }
+    return true;
+}
+
+bool TrackStream::parse_header(uint8_t *scratch)
+{
+    uint32_t loaded = 0xFFFFFFFF;
+    uint32_t chunk[3];
+    bool have_format = false;
+
+    if (!read_range(this, 0, chunk, 12, scratch, &loaded) || codec_for_magic(chunk[0]) == NULL || chunk[2] != CHUNK_WAVE)
+    {
+        return false;
+    }
+    uint32_t offset = 12;
+    while (offset + 8 <= file_size)
+    {
+        if (!read_range(this, offset, chunk, 8, scratch, &loaded))
+        {
+            return false;
+        }
+        offset += 8;
+        switch (chunk[0])
+        {
+            case CHUNK_FMT:
+                if (chunk[1] < sizeof(format) || !read_range(this, offset, &format, sizeof(format), scratch, &loaded))
+                {
+                    return false;
+                }
+                have_format = true;
+                break;
+
+            case CHUNK_DATA:
+                if (!have_format || format.block_align <= 0 || format.num_channels <= 0 || offset > file_size)
+                {
+                    return false;
+                }
+                data_start = offset;
+                data_size = chunk[1];
+                if (data_size > file_size - offset)
+                {
+                    data_size = file_size - offset;
+                }
+                data_size -= data_size % format.block_align;
+                return true;
+
+            default:
+                break;
+        }
+        // Chunks are padded to an even length
+        if (chunk[1] >= file_size - offset)
+        {
+            return false;
+        }
+        offset += chunk[1] + (chunk[1] & 1);
+    }
+    return false;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file TrackStream.h
+ * @brief Sector-level reader for a WAV file on the SD card
+ * @details Resolves a file once, then reads its data sectors straight from the card using a cluster
+ * link map (runs of contiguous sectors) instead of going through stdio and FatFs for every read.
+ * The parsed stream descriptor (format, data chunk position & size) is kept with the map.
+**/
+#ifndef TRACKSTREAM_H
+#define TRACKSTREAM_H
+
+#include "mbed.h"
+#include "rtos.h"
+#include "SDFileSystem.h"
+#include "SampleSource.h"
+
+// Number of contiguous sector runs held in a cluster link map at once
+#define TRACK_MAX_EXTENTS 16
+
+/**
+ * @brief Serializes all SD card access
+ * @details FatFs is built without reentrancy, and the card's SPI bus is shared by every thread that
+ * reads or writes it, so anything touching the card (stdio, FatFs or raw sectors) must hold this lock.
+**/
+extern Mutex sdMutex;
+
+/**
+ * @brief Drops the FAT sector cached for cluster chain walks
+ * @details Call, holding sdMutex, after the FAT has been changed on the card.
+**/
+void invalidate_fat_cache();
+
+/**
+ * @brief Compact reference to a file that opens without resolving its path
+**/
+struct TrackHandle
+{
+    uint32_t start_cluster;     // First cluster of the file
+    uint32_t size;              // Size of the file in bytes
+};
+
+/**
+ * @brief One run of contiguous sectors belonging to a file
+**/
+struct Extent
+{
+    uint32_t sector;    // First absolute sector of the run
+    uint32_t count;     // Number of sectors in the run
+};
+
+/**
+ * @brief Cluster-mapped reader for one file on the card, plus its parsed WAV descriptor
+ * @details The cluster link map is built lazily, reading at most one FAT sector per step, and slides
+ * forward once it holds TRACK_MAX_EXTENTS runs so very fragmented files still use bounded memory.
+**/
+class TrackStream : public SampleSource
+{
+public:
+    TrackStream();
+
+    /**
+     * @brief Resolves a file by path & maps its first clusters
+     * @param fs File system the file lives on
+     * @param path Path relative to the root of fs, e.g. "myMusic/song.wav"
+     * @return true if the file exists & is not empty
+    **/
+    bool open(SDFileSystem *fs, const char *path);
+
+    /**
+     * @brief Opens a file from its handle without reading the card
+     * @details The first read then costs one FAT sector read on top of the data sector.
+     * @param fs File system the file lives on
+     * @param handle Start cluster & size of the file, as stored in the library index
+     * @return true if the handle refers to a non-empty file
+    **/
+    bool open(SDFileSystem *fs, const TrackHandle &handle);
+
+    /**
+     * @brief Forgets the file; the object may be reopened
+    **/
+    void close();
+
+    /**
+     * @brief Reads one sector of the file
+     * @param file_sector Sector index counted from the start of the file
+     * @param buffer Destination of SECTOR_SIZE bytes
+     * @return true on success, false past the end of file or on card error
+    **/
+    virtual bool read_sector(uint32_t file_sector, uint8_t *buffer);
+
+    /**
+     * @brief Overwrites one sector of the file in place
+     * @details The file's size & clusters are unchanged, so nothing in the FAT or directory needs
+     * updating. Meant for files allocated once at full size.
+     * @return true on success, false past the end of file or on card error
+    **/
+    bool write_sector(uint32_t file_sector, const uint8_t *buffer);
+
+    /**
+     * @brief Finds where a sector of the file lies on the card & how many follow it contiguously
+     * @param disk_sector Set to the absolute sector holding file_sector
+     * @return Sectors of the file from file_sector on that are contiguous on the card, at least 1, or 0
+     * past the end of file or on card error
+    **/
+    uint32_t run(uint32_t file_sector, uint32_t *disk_sector);
+
+    /**
+     * @brief Cluster holding a sector of the file
+     * @return The cluster, or 0 past the end of file or on card error
+    **/
+    uint32_t cluster(uint32_t file_sector);
+
+    /**
+     * @brief Restarts the cluster map at a cluster of the file found earlier, e.g. from a seek table
+     * @details The next read at or after file_sector then maps the file from there instead of from its
+     * first cluster. Ignored if the map already covers file_sector.
+     * @param file_sector First file sector of the cluster
+     * @param cluster Cluster holding file_sector
+    **/
+    void seek_hint(uint32_t file_sector, uint32_t cluster);
+
+    /**
+     * @brief Walks the RIFF chunks & fills format, data_start & data_size
+     * @param scratch Sector buffer used while parsing
+     * @return true if a format chunk and a data chunk were found
+    **/
+    bool parse_header(uint8_t *scratch);
+
+    bool is_open() const { return fs != NULL; }
+    TrackHandle handle() const;
+    int extent_count() const { return num_extents; }
+    /**
+     * @brief Runs of contiguous sectors mapped since the file was opened or the map restarted
+     * @details Counts every run, including those the sliding map has already dropped, so after a
+     * front-to-back read it is the fragment count of the file.
+    **/
+    uint32_t fragment_count() const { return num_fragments; }
+
+    uint32_t file_size;     // Size of the file in bytes
+
+private:
+    void restart_map();
+    bool extend_map();
+    bool map_sector(uint32_t file_sector, uint32_t *disk_sector);
+
+    SDFileSystem *fs;
+    uint32_t start_cluster;
+    uint32_t walk_cluster;      // Next cluster to append to the map, 0 at end of chain
+    uint32_t map_base;          // File sector held by the start of extents[0]
+    uint32_t map_sectors;       // Sectors covered by the map
+    Extent extents[TRACK_MAX_EXTENTS];
+    int num_extents;
+    uint32_t num_fragments;
+};
+
+#endif
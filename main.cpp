@@ -14,11 +14,32 @@
 // are the correct by using those included in this github
 #include "mbed.h"
 #include "rtos.h"
-#include "SDFileSystem.h"
+#include "SDCard.h"
 #include "uLCD_4DGL.h"
-#include "wave_player.h"
+#include "BluetoothLink.h"
+#include "Compositor.h"
+#include "TrackStream.h"
+#include "StreamPlayer.h"
+#include "SignalSource.h"
+#include "ClockGovernor.h"
+#include "MediaScrubber.h"
+#include "Defragmenter.h"
+#include "LibraryIndex.h"
+#include "SearchIndex.h"
+#include "BlackBox.h"
+#include "AudioHealth.h"
+#include "CpuProfiler.h"
+#include "TextPage.h"
+#include "DisplayAnimation.h"
+#include "TrackCache.h"
 #include "MMA8452.h"
-#include "PinDetect.h"
+#include "PolledButton.h"
+#include "TimerService.h"
+#include "ContentChain.h"
+#include "InputLatency.h"
+#include "ScenarioRunner.h"
+#include "ClipStore.h"
+#include "us_ticker_api.h"
 #include <string>
 #include <vector>
 
@@ -30,39 +51,196 @@ DigitalOut led2(LED2);
 DigitalOut led3(LED3);
 DigitalOut led4(LED4);
 
-// Pushbuttons for MP3 Player Controls
-PinDetect prev(p21);
-PinDetect next(p22);
-PinDetect shuffle(p23);
-PinDetect play(p24);
+// Pushbuttons for MP3 Player Controls, debounced together by one timer service job
+PolledButton prev(p21, PullUp);
+PolledButton next(p22, PullUp);
+PolledButton shuffle(p23, PullUp);
+PolledButton play(p24, PullUp);
 
 // Serial & Analog Inputs & Ouputs for Data Communication
 RawSerial blueTooth(p28,p27);
+// Bluefruit flow control: p29 to the module's CTS, p30 from its RTS
+BluetoothLink btLink(&blueTooth, p29, p30);
 Serial pc(USBTX, USBRX);
-SDFileSystem sd(p5, p6, p7, p12, "sd");
+SDCard sd(p5, p6, p7, p12, "sd");
 uLCD_4DGL uLCD(p13,p14,p11);
+Compositor compositor(&uLCD);
+TextPage diagPage(&uLCD);
+DisplayAnimation animation(&uLCD);
+#if CONTENT_CHAIN
+// p9 & p10 carry the content ring instead of the accelerometer
+ContentChain chain(&sd, "myMusic");
+#else
 MMA8452 acc(p9, p10, 100000);
+#endif
 AnalogOut DACout(p18);
-wave_player waver(&DACout);
+StreamPlayer player(&DACout);
 
 
+// Progress bar drawn through the compositor on the bottom text row
+#define PROGRESS_BAR_Y 123
+#define PROGRESS_BAR_HEIGHT 3
+#define PROGRESS_BAR_WIDTH 128
+// Songs sent per page of search results & longest search accepted over BlueTooth
+#define SEARCH_PAGE 5
+#define SEARCH_LINE 48
+// Distance jumped by the Control Pad left & right arrows
+#define SEEK_STEP_SECONDS 10
+// Diagnostics page refresh period, & how close together the prev & next buttons must be held to toggle it
+#define DIAG_PERIOD_MS 250
+#define DIAG_COMBO_US 500000
+// How often the animation mode checks the audio position for the next frame
+#define ANIM_POLL_MS 20
+// SDCard latency window of the diagnostics page
+#define DIAG_SD_WINDOW 1
+// Periods of the timer service jobs
+#define LED_PERIOD_MS 50
+#define GOVERNOR_PERIOD_MS 250
+// Watchdog timeout, how often it is fed, & how long after start up it is armed
+#define WATCHDOG_TIMEOUT_MS 4000
+#define WATCHDOG_FEED_MS 1000
+#define WATCHDOG_ARM_MS 5000
+// Governor windows per black box record
+#define BLACKBOX_WINDOWS 4
+// How often the BlueTooth thread looks for commands
+#define BLUETOOTH_POLL_MS 10
+// Signal that wakes the LCD thread as soon as a command has changed what it shows
+#define LCD_WAKE 0x01
+// Longest a scenario's skip may take to reach the DAC before it is counted as lost
+#define SCENARIO_SKIP_TIMEOUT_MS 2000
+
 // Defining Internal Global Variables
 bool playing = false;
 int currentSong = 0;
 int songCount = 0;
 vector<string> songList;
 unsigned short max_range = 0xFFFF;
+// Set by the Control Pad "up" arrow to play the test signals instead of the song list
+volatile bool signalTest = false;
+SignalSource testSignal;
+LibraryIndex library(&sd);
+TrackCache trackCache(&sd, &library);
+ClockGovernor governor;
+MediaScrubber scrubber(&sd, &library);
+Defragmenter defragmenter(&sd, &library, &trackCache, &scrubber);
+SearchIndex search(&sd, &library);
+BlackBox blackBox(&sd);
+// Non-audio work gives way while the sample ring runs low; clients are registered in main()
+AudioHealth health(&player);
+int lcdClient = -1;
+int ledClient = -1;
+int bluetoothClient = -1;
+int searchClient = -1;
+int cacheClient = -1;
+int blackBoxClient = -1;
+// Short periodic jobs & one-shots, run from one thread
+TimerService timers;
+// Set by the governor job when the clock changed; reported by the cache thread, as jobs must not block
+volatile bool clockChanged = false;
+// Hidden diagnostics page, toggled by holding prev & next together
+CpuProfiler profiler;
+volatile bool diagnostics = false;
+volatile uint32_t prevHeldUs = 0;
+volatile uint32_t nextHeldUs = 0;
+// Animation mode, toggled from the Control Pad, playing videos from the display's own card
+volatile bool animating = false;
+// Time from each command to its effect in the audio & on the screen; the LCD thread is woken by commands
+InputLatency inputs;
+osThreadId lcdThreadId = NULL;
+// Clips built into flash by tools/pack_clips.py, played without the card
+ClipStore clips(clipImage);
+int clickClip = -1;
+int errorClip = -1;
+#if CONTENT_CHAIN
+// Set by the BlueTooth '>' command to copy this unit's library to the rest of the ring
+volatile bool chainPush = false;
+#endif
+// Last library search over BlueTooth & the first match of the page last sent
+char searchText[SEARCH_LINE];
+int searchFirst = 0;
+#if SCENARIO_RUNNER
+// Bench builds: the scenarios, & a search handed to the BlueTooth thread by the browsing scenario
+ScenarioRunner scenarios(&governor, &blackBox, &player, &profiler, &pc);
+volatile bool scenarioRun = false;
+volatile bool scenarioBrowse = false;
+char scenarioText[SEARCH_LINE];
+#endif
 
 // Defining Functions
 
+/**
+ * @brief Starts timing a user command & wakes the LCD thread to show it
+ * @details Called before the command is carried out, from the button job or the BlueTooth thread.
+ * @param origin_us us_ticker time the command was first seen
+**/
+void noteInput(InputAction action, InputSource source, uint32_t origin_us)
+{
+    inputs.command(action, source, origin_us, playing);
+    // Each command clicks, over the music or on its own; this also ends the fallback loop
+    player.play_clip(clips, clickClip);
+    if (lcdThreadId != NULL)
+    {
+        osSignalSet(lcdThreadId, LCD_WAKE);
+    }
+}
+
+/**
+ * @brief Ends the timing of the command waiting on the audio. Attached to the player, which calls it
+ * as the first sample a command started reaches the DAC, or as the play a command paused stops.
+**/
+void audioEffect(uint32_t us)
+{
+    inputs.done(INPUT_AUDIO, us);
+}
+
+/**
+ * @brief Sends the command latency histograms that hold any commands over the PC serial port & BlueTooth
+ * @details One line per command, control & path: the count, the bucket bounds of the median & 99th
+ * percentile, and the slowest, in ms.
+**/
+void reportInputLatency()
+{
+    char line[64];
+    pc.printf("input latency, %u superseded\r\n", inputs.superseded());
+    for (int action = 0; action < INPUT_ACTIONS; action++)
+    {
+        for (int source = 0; source < INPUT_SOURCES; source++)
+        {
+            for (int path = 0; path < INPUT_PATHS; path++)
+            {
+                const InputHistogram &histogram = inputs.histogram((InputAction)action, (InputSource)source, (InputPath)path);
+                if (histogram.count == 0)
+                {
+                    continue;
+                }
+                int length = snprintf(line, sizeof(line), "%s %s %s n%u p50<%u p99<%u max %u ms",
+                                      InputLatency::action_name(action), InputLatency::source_name(source),
+                                      InputLatency::path_name(path), (unsigned)histogram.count,
+                                      (unsigned)InputLatency::percentile(histogram, 50),
+                                      (unsigned)InputLatency::percentile(histogram, 99),
+                                      (unsigned)(histogram.max_us / 1000));
+                pc.printf("%s\r\n", line);
+                btLink.write(line, length < (int)sizeof(line) ? length : (int)sizeof(line) - 1);
+                btLink.write("\n", 1);
+            }
+        }
+    }
+}
+
 /**
  * @brief Increments integer variable currentSong by one, while circling back to first song at end of list
  * @details Function is called both when "next song" pushbutton pressed or bluetooth command is sent;
+ * does nothing while the library is empty;
  * LED1 switches value when called for diagnostics & testing
 **/
 void nextSong()
 {
     //led1 = !led1;
+    if (songCount == 0)
+    {
+        return;
+    }
+    player.mark_request();
     if (currentSong == songCount - 1)
     {
         currentSong = 0;
@@ -76,11 +254,17 @@ void nextSong()
 /**
  * @brief Increments integer variable currentSong by minus one, while circling back to last song at zero
  * @details Function is called both when "previous song" pushbutton pressed or bluetooth command is sent;
+ * does nothing while the library is empty;
  * LED2 switches value when called for diagnostics & testing
 **/
 void prevSong()
 {
     //led2 = !led2;
+    if (songCount == 0)
+    {
+        return;
+    }
+    player.mark_request();
     if (currentSong == 0)
     {
         currentSong = songCount - 1;
@@ -100,6 +284,7 @@ void prevSong()
 void playSong()
 {
     //led3 = !led3;
+    player.mark_request();
     playing = !playing;
 }
 
@@ -107,35 +292,137 @@ void playSong()
  * @brief Generates random integer within song list range to assign integer variable currentSong
  * @details Function is called both when "shuffle song" pushbutton pressed or bluetooth command is sent;
  * function seeds a true random value through the noise present on the 5th decimal place of an
- * accelerometer's input values;
+ * accelerometer's input values, or from the microsecond ticker in builds where the content ring has
+ * the accelerometer's pins; does nothing while the library is empty;
  * LED4 switches value when called for diagnostics & testing
 **/
 void shuffleSong()
 {
     //led4 = !led4;
+    if (songCount == 0)
+    {
+        return;
+    }
+    player.mark_request();
+#if CONTENT_CHAIN
+    currentSong = us_ticker_read() % songCount;
+#else
     double x, y, z;
     acc.readXYZGravity(&x,&y,&z);
     currentSong = int(100000 * (x + y + z)) % songCount;
+#endif
 }
 
-// Defining Threads
+/**
+ * @brief Works out where a seek lands in the playing song & readies its file for the read there
+ * @details The distance becomes a frame of the song's range, then a byte of its data through the
+ * codec. The seek points in the library index let the first read map the file from the nearest known
+ * cluster instead of walking the chain from the start of the file.
+ * @param track Warm entry of the playing song
+ * @param position Byte of sample data reached, from the start of the data
+ * @param seconds Distance to jump, negative to go back
+ * @return Byte of sample data to resume from
+**/
+uint32_t seekTarget(WarmEntry *track, uint32_t position, int seconds)
+{
+    TrackStream &stream = track->stream;
+    Decoder decoder;
+    if (track->end <= track->start || !open_decoder(stream.format, &decoder))
+    {
+        return position;
+    }
+    int64_t align = stream.format.block_align;
+    int64_t frame = position / align + (int64_t)seconds * stream.format.sample_rate;
+    int64_t first = track->start / align;
+    int64_t last = (track->end - 1) / align;
+    frame = frame < first ? first : (frame > last ? last : frame);
+    uint32_t target = decoder_seek(decoder, frame);
+
+    uint32_t point;
+    uint32_t cluster;
+    if (library.seek_point(track->song, (stream.data_start + target) / SECTOR_SIZE, &point, &cluster))
+    {
+        stream.seek_hint(point, cluster);
+    }
+    return target;
+}
 
 /**
- * @brief Updates LCD screen according to user input & selections
- * @details First configures LCD screen layout & songlist, then continously checks for changes in global variables
- * integer currentSong & boolean playing to update LCD screen accordingly. No updates made if no changes found.
- * All LCD communications occur strictly in this thread.
- * @param *arguments Input arguments to thread used for RTOS thread library. Not needed to understand thread code.
- */
-void LCDThread(void const *argument)
+ * @brief Runs the current search & sends the page of matches from searchFirst over BlueTooth
+**/
+void sendSearchPage()
+{
+    // A query reads many index sectors; put it off while the audio is struggling
+    while (!health.admit(searchClient))
+    {
+        Thread::wait(50);
+    }
+    uint16_t results[SEARCH_PAGE];
+    int total = search.query(searchText, searchFirst, SEARCH_PAGE, results);
+    char text[64];
+    if (total < 0)
+    {
+        btLink.puts("Search failed\n");
+        return;
+    }
+    snprintf(text, sizeof(text), "%d found in %u ms\n", total, (unsigned)(search.last_query_us() / 1000));
+    btLink.puts(text);
+    for (int i = 0; i < SEARCH_PAGE && searchFirst + i < total; i++)
+    {
+        string name = songList[results[i]].substr(0, songList[results[i]].find(".wav"));
+        snprintf(text, sizeof(text), "%d: %s\n", results[i] + 1, name.c_str());
+        btLink.puts(text);
+    }
+}
+
+/**
+ * @brief Reads a library search from the BlueTooth terminal & sends back one page of matching songs
+ * @details "?words" starts a search for songs with every word in their name; "?" alone sends the next
+ * page of the last search. Each match is sent with its number in the song list.
+**/
+void searchSongs()
+{
+    char line[SEARCH_LINE];
+    int len = 0;
+    char c;
+    while ((c = btLink.getc()) != '\n' && c != '\r')
+    {
+        if (len < SEARCH_LINE - 1)
+        {
+            line[len++] = c;
+        }
+    }
+    line[len] = 0;
+    if (len > 0)
+    {
+        strcpy(searchText, line);
+        searchFirst = 0;
+    }
+    else
+    {
+        searchFirst += SEARCH_PAGE;
+    }
+    sendSearchPage();
+}
+
+/**
+ * @brief Draws the player screen from scratch: song list, "NOW PLAYING: " & "STATUS: "
+ * @details With no songs it says so instead, while the fallback loop plays from flash.
+**/
+void drawPlayerScreen()
 {
-    // Configure LCD screen
     uLCD.cls();
-    uLCD.baudrate(3000000);
-    uLCD.background_color(BLACK);
-    uLCD.color(WHITE);
-    uLCD.text_width(1);
-    uLCD.text_height(1);   
+    compositor.reset(BLACK);
+    if (songCount == 0)
+    {
+        uLCD.locate(0,0);
+        uLCD.printf("No songs found");
+        uLCD.locate(0,2);
+        uLCD.printf("Put .wav songs in");
+        uLCD.locate(0,3);
+        uLCD.printf("the myMusic folder");
+        return;
+    }
 
     // Print Song List to LCD Screen
     uLCD.locate(0,0);
@@ -155,6 +442,146 @@ void LCDThread(void const *argument)
     uLCD.printf("%s", songList[currentSong].substr(0,songList[currentSong].find(".wav")));
     uLCD.locate(0,14);
     uLCD.printf("STATUS: PAUSED");
+}
+
+/**
+ * @brief Shows live performance figures until the diagnostics page is closed
+ * @details Refreshed a few times a second through a TextPage, so only the characters that change are
+ * sent, and put off like any other LCD update while the audio is running low. The per-thread CPU
+ * sampler only runs while the page is open.
+**/
+void showDiagnostics()
+{
+    static const char *healthNames[] = {"good", "low", "CRIT"};
+    uint8_t percent[PROFILER_MAX_THREADS];
+    uint32_t max_us;
+    diagPage.clear();
+    profiler.start();
+    sd.read_latency(DIAG_SD_WINDOW, 99, &max_us);
+    uint32_t lastBlocks = sd.blocks_read();
+    uint32_t lastUs = us_ticker_read();
+    bool shown = false;
+    while (diagnostics)
+    {
+        // A command ends the wait early, so closing the page is not held up by the refresh period
+        Thread::signal_wait(LCD_WAKE, DIAG_PERIOD_MS);
+        if (!health.admit(lcdClient))
+        {
+            continue;
+        }
+        uint32_t now = us_ticker_read();
+        uint32_t blocks = sd.blocks_read();
+        uint32_t elapsed_us = now - lastUs;
+        uint32_t kBps = elapsed_us ? (uint32_t)((uint64_t)(blocks - lastBlocks) * SECTOR_SIZE * 1000 / elapsed_us) : 0;
+        lastBlocks = blocks;
+        lastUs = now;
+        uint32_t p99_us = sd.read_latency(DIAG_SD_WINDOW, 99, &max_us);
+        unsigned other = profiler.take(percent);
+        uint32_t spi_khz = sd.spi_hz() / 1000;
+
+        diagPage.print(0, "DIAG %3uMHz %3u%%", (unsigned)(governor.cpu_hz() / 1000000), governor.load());
+        // One row per sampled thread: CPU share & stack never used
+        int row = 1;
+        for (int i = 0; i < profiler.threads(); i++, row++)
+        {
+            if (i < blackBox.watched())
+            {
+                diagPage.print(row, "%-8s%3u%% %4u", profiler.name(i), percent[i], blackBox.stack_free(i));
+            }
+            else
+            {
+                diagPage.print(row, "%-8s%3u%%    -", profiler.name(i), percent[i]);
+            }
+        }
+        diagPage.print(row++, "%-8s%3u%%", "other", other);
+        diagPage.print(row++, "ring %4u %s", (unsigned)player.fill(), healthNames[health.level()]);
+        diagPage.print(row++, "underruns %u", player.underruns());
+        diagPage.print(row++, "sd %4uKB/s %2u.%uM", (unsigned)kBps, (unsigned)(spi_khz / 1000),
+                       (unsigned)(spi_khz % 1000 / 100));
+        diagPage.print(row++, "p99 %5u max%5u", (unsigned)p99_us, (unsigned)max_us);
+        diagPage.print(row++, "sd errors %u", (unsigned)sd.read_errors());
+        diagPage.print(row++, "heap %5u free", blackBox.heap_free());
+        const FilePoolStats &files = sd.files();
+        diagPage.print(row++, "files %u/%u pk%u h%u", files.in_use, FILE_POOL_SIZE, files.peak, files.heap_opens);
+        diagPage.present();
+        if (!shown)
+        {
+            inputs.done(INPUT_DISPLAY, us_ticker_read());
+            shown = true;
+        }
+    }
+    profiler.stop();
+}
+
+/**
+ * @brief Plays the current song's video from the display's card until the animation mode is closed
+ * @details Each pass works out the frame due from the samples the DAC has played & sends it if it is
+ * new, so a display slower than the video drops frames rather than falling behind the audio. The song
+ * name & progress bar stay below the video.
+**/
+void showAnimation()
+{
+    uLCD.cls();
+    compositor.reset(BLACK);
+    int song = -1;
+    while (animating && !diagnostics)
+    {
+        unsigned inputsSeen = inputs.started(INPUT_DISPLAY);
+        if (!health.admit(lcdClient))
+        {
+            Thread::wait(ANIM_POLL_MS);
+            continue;
+        }
+        if (song != currentSong && songCount > 0)
+        {
+            song = currentSong;
+            // Clear the last song's video, which the new one may not cover
+            const AnimationEntry &video = animation.selected();
+            if (video.width > 0 && video.height > 0)
+            {
+                uLCD.filled_rectangle(video.x, video.y, video.x + video.width - 1, video.y + video.height - 1, BLACK);
+            }
+            bool found = animation.select(songList[song].c_str());
+            uLCD.locate(0,5);
+            uLCD.printf("%-18s", found ? "" : "no animation");
+            uLCD.locate(0,13);
+            uLCD.printf("%-18s", songList[song].substr(0,songList[song].find(".wav")).substr(0,18).c_str());
+        }
+        animation.show(player.position(), player.stream_rate());
+        uint32_t length = player.length();
+        int progress = length ? (int)((uint64_t)player.played() * PROGRESS_BAR_WIDTH / length) : 0;
+        compositor.fill(0, PROGRESS_BAR_Y, progress, PROGRESS_BAR_HEIGHT, GREEN);
+        compositor.fill(progress, PROGRESS_BAR_Y, PROGRESS_BAR_WIDTH - progress, PROGRESS_BAR_HEIGHT, DGREY);
+        compositor.present(COMPOSITOR_FRAME_BUDGET);
+        // Commands seen before the pass began are now on screen
+        inputs.done_since(INPUT_DISPLAY, us_ticker_read(), inputsSeen);
+        Thread::wait(ANIM_POLL_MS);
+    }
+}
+
+// Defining Threads
+
+/**
+ * @brief Updates LCD screen according to user input & selections
+ * @details First configures LCD screen layout & songlist, then continously checks for changes in global variables
+ * integer currentSong & boolean playing to update LCD screen accordingly. No updates made if no changes found.
+ * Updates are put off while the audio is running low, & catch up once it recovers. A command wakes the
+ * thread, so it is drawn without waiting out the rest of the pass. Holding prev & next
+ * together swaps the screen for the diagnostics page & back, and the Control Pad swaps it for the animation mode.
+ * All LCD communications occur strictly in this thread.
+ * @param *arguments Input arguments to thread used for RTOS thread library. Not needed to understand thread code.
+ */
+void LCDThread(void const *argument)
+{
+    // Configure LCD screen
+    uLCD.cls();
+    uLCD.baudrate(3000000);
+    uLCD.background_color(BLACK);
+    uLCD.color(WHITE);
+    uLCD.text_width(1);
+    uLCD.text_height(1);   
+    drawPlayerScreen();
+    lcdThreadId = Thread::gettid();
 
     // Initialize internal thread variables to check for changes to external global variables
     bool prevPlayLCD = false;
@@ -163,8 +590,31 @@ void LCDThread(void const *argument)
     // Thread while loop to continously check for changes and update screen accordingly
     while (true)
     {   
+        if (diagnostics || animating)
+        {
+            // Back to the player screen as drawn at start up, which the checks below then bring up to date
+            if (diagnostics)
+            {
+                showDiagnostics();
+            }
+            else
+            {
+                showAnimation();
+            }
+            drawPlayerScreen();
+            prevPlayLCD = false;
+            previousSongLCD = currentSong;
+            continue;
+        }
+        // Commands that came in before the checks below are on screen once they are drawn
+        unsigned inputsSeen = inputs.started(INPUT_DISPLAY);
+        if (!health.admit(lcdClient))
+        {
+            Thread::wait(50);
+            continue;
+        }
         // Check if new song has been selected
-        if (previousSongLCD != currentSong)
+        if (previousSongLCD != currentSong && songCount > 0)
         {
             // Update "NOW PLAYING: " feature
             uLCD.locate(0,12);
@@ -195,7 +645,15 @@ void LCDThread(void const *argument)
             // Set internal change check to playing
             prevPlayLCD = playing;
         }
-        Thread::wait(50);
+        // Progress bar below "STATUS: "; only the pixels it changes are sent to the screen
+        uint32_t length = player.length();
+        int progress = length ? (int)((uint64_t)player.played() * PROGRESS_BAR_WIDTH / length) : 0;
+        compositor.fill(0, PROGRESS_BAR_Y, progress, PROGRESS_BAR_HEIGHT, GREEN);
+        compositor.fill(progress, PROGRESS_BAR_Y, PROGRESS_BAR_WIDTH - progress, PROGRESS_BAR_HEIGHT, DGREY);
+        compositor.present(COMPOSITOR_FRAME_BUDGET);
+        inputs.done_since(INPUT_DISPLAY, us_ticker_read(), inputsSeen);
+        // Woken at once by a command, so it is drawn without waiting out the period
+        Thread::signal_wait(LCD_WAKE, 50);
     }
 }
 
@@ -203,11 +661,16 @@ void LCDThread(void const *argument)
  * @brief Updates phone screen to latest currentSong playing, sends phone commands to mBED, all over BlueTooth
  * @details See commenting in thread for step-by-step approach
  * All BlueTooth communications occur strictly in this thread
- * BlueTooth Control Pad Module Controls:  1 = Pause/Play, 2 = Next Song, 3 = Previous Song, 4 = Shuffle Song
+ * BlueTooth Control Pad Module Controls:  1 = Pause/Play, 2 = Next Song, 3 = Previous Song, 4 = Shuffle Song,
+ * Down = Animation mode on/off, Left/Right = Seek back/forward. From a terminal, '?' searches the library
+ * & '%' reports the command latency histograms
  * @param *arguments Input arguments to thread used for RTOS thread library. Not needed to understand thread code.
  */
 void BluetoothThread(void const *argument)
 {
+    // Raise the link to the fastest rate the module holds, before the phone connects
+    btLink.negotiate();
+    pc.printf("bluetooth link %u baud\r\n", (unsigned)btLink.stats().baud);
     // Initialize internal thread variable to check for changes to external global variables
     int previousSongBLE = 0;
     // Thread while look to continously check for BlueTooth commands and update currentSong on phone
@@ -216,56 +679,120 @@ void BluetoothThread(void const *argument)
         // Update currentSong on phone
         if (blueTooth.writeable())
         {
-            // Check if new song has been selected
-            if (previousSongBLE != currentSong)
+            // Check if new song has been selected; the name is resent later if the audio is running low
+            if (previousSongBLE != currentSong && songCount > 0 && health.admit(bluetoothClient))
             {
-                // Send currentSong name over BlueTooth
-                string str = "Current Song: ";
-                for (int i = 0; i < 14; i++)
-                {
-                    blueTooth.putc(str[i]);
-                }
-                for (int i = 0; i < songList[currentSong].size() - 4; i++)
-                {
-                    blueTooth.putc(songList[currentSong][i]);
-                }
-                blueTooth.putc('\n');
+                // Send currentSong name over BlueTooth; tracks of a CUE sheet have no extension to strip
+                string str = "Current Song: " + songList[currentSong].substr(0, songList[currentSong].find(".wav")) + "\n";
+                btLink.write(str.data(), str.size());
                 previousSongBLE = currentSong;
             }
             
         }
+#if SCENARIO_RUNNER
+        // A search from the browsing scenario is answered like one typed on the terminal
+        if (scenarioBrowse)
+        {
+            strcpy(searchText, scenarioText);
+            searchFirst = 0;
+            sendSearchPage();
+            scenarioBrowse = false;
+        }
+#endif
         // Read in commands from BlueTooth module
-        if (blueTooth.readable())
+        if (btLink.readable())
         {
+            char command = btLink.getc();
+            // Commands are timed from the poll that found them
+            uint32_t seenUs = us_ticker_read();
+            // '?' starts a library search from a BlueTooth terminal
+            if (command == '?')
+            {
+                searchSongs();
+            }
+            // '%' reports the command latency histograms
+            else if (command == '%')
+            {
+                reportInputLatency();
+            }
+#if CONTENT_CHAIN
+            // '>' copies the library to the other units on the ring, once nothing is playing
+            else if (command == '>')
+            {
+                if (playing || signalTest)
+                {
+                    btLink.write("Pause first\n", 12);
+                }
+                else
+                {
+                    chainPush = true;
+                    btLink.write("Copying to ring\n", 16);
+                }
+            }
+#endif
+#if SCENARIO_RUNNER
+            // '*' runs the scenario script on the card again
+            else if (command == '*')
+            {
+                scenarioRun = true;
+                btLink.write("Running scenarios\n", 18);
+            }
+#endif
             // Check for '!B' to be compatible with "Control Pad" Module serial output
-            if (blueTooth.getc()=='!')
+            else if (command == '!')
             {
-                if (blueTooth.getc()=='B')
+                if (btLink.getc()=='B')
                 {
                     // Check which command was hit
-                    char bnum = blueTooth.getc();
+                    char bnum = btLink.getc();
                     // Ensure mBED only updates on release, not hit
-                    char bhit = blueTooth.getc();
+                    char bhit = btLink.getc();
                     if (bhit == '0')
                     {
                         switch (bnum)
                             {
                                 case '1':
+                                noteInput(INPUT_PLAY, INPUT_PAD, seenUs);
                                 playSong();
                                 break;
                                 
                                 case '2':
+                                noteInput(INPUT_NEXT, INPUT_PAD, seenUs);
                                 nextSong();
                                 break;
                                 
                                 case '3':
+                                noteInput(INPUT_PREV, INPUT_PAD, seenUs);
                                 prevSong();
                                 break;
                                 
                                 case '4':
+                                noteInput(INPUT_SHUFFLE, INPUT_PAD, seenUs);
                                 shuffleSong();
                                 break;
                                 
+                                case '5':
+                                playing = false;
+                                signalTest = true;
+                                break;
+                                
+                                case '6':
+                                noteInput(INPUT_ANIMATION, INPUT_PAD, seenUs);
+                                animating = !animating;
+                                break;
+                                
+                                case '7':
+                                noteInput(INPUT_SEEK, INPUT_PAD, seenUs);
+                                player.mark_request();
+                                player.seek(-SEEK_STEP_SECONDS);
+                                break;
+                                
+                                case '8':
+                                noteInput(INPUT_SEEK, INPUT_PAD, seenUs);
+                                player.mark_request();
+                                player.seek(SEEK_STEP_SECONDS);
+                                break;
+                                
                                 default:
                                 break;
                             }
@@ -273,44 +800,437 @@ void BluetoothThread(void const *argument)
                 }
             }
         }
-        Thread::wait(50);
+        Thread::wait(BLUETOOTH_POLL_MS);
     }
 }
 
 /**
  * @brief Updates Mbed LEDs to show current volume level 
- * @details Read and scales analogOut level, then sets leds to show the level in 4 tiers. 
+ * @details Read and scales analogOut level, then sets leds to show the level in 4 tiers. Skipped while
+ * the audio is running low. Run by the timer service every LED_PERIOD_MS.
+ */
+void visualizerJob()
+{
+    if(!playing || !health.admit(ledClient))
+    {
+        return;
+    }
+    float level = (DACout.read() - 0.25f) * 3.3f;
+    if(level<0.825)
+    {
+        led1=true;
+        led2=led3=led4=false;
+    }
+    else if(level>0.825&&level<1.65)
+    {
+        led1=led2=true;
+        led3=led4=false;
+    }
+    else if(level>1.65&&level<2.47)
+    {
+        led1=led2=led3=true;
+        led4=false;
+    }
+    else if(level>2.47)
+    {
+        led1=led2=led3=led4=true;
+    }
+}
+
+/**
+ * @brief Reports clock changes, & the work shed each time the audio recovers from running low, over the
+ * PC serial port
+**/
+void reportGovernor()
+{
+    static unsigned lastDrops = 0;
+    if (clockChanged)
+    {
+        clockChanged = false;
+        pc.printf("clock %u MHz, load %u%%, %u changes %u refused\r\n",
+                  governor.cpu_hz() / 1000000, governor.load(), governor.transitions(), governor.refusals());
+    }
+    if (health.drops() != lastDrops && health.level() == HEALTH_GOOD)
+    {
+        lastDrops = health.drops();
+        pc.printf("audio health: %u drops, shed", lastDrops);
+        for (int i = 0; i < health.clients(); i++)
+        {
+            const HealthClient &client = health.client(i);
+            pc.printf(" %s %u/%u", client.name, client.shed, client.episodes);
+        }
+        pc.printf("\r\n");
+    }
+}
+
+/**
+ * @brief Keeps the previous & next songs warm so skipping starts playback from RAM
+ * @details Runs below normal priority so the card is only used for warming when the speaker thread
+ * does not need it, & not at all while the audio is running low. Once both neighbours are warm, the cache hit rate & the time from a user command
+ * to its first sample are reported over the PC serial port, along with the clock governor's reports.
+ * @param *arguments Input arguments to thread used for RTOS thread library. Not needed to understand thread code.
+ */
+void CacheThread(void const *argument)
+{
+    bool warmed = false;
+    while (true)
+    {
+        reportGovernor();
+        if (!health.admit(cacheClient))
+        {
+            Thread::wait(50);
+            continue;
+        }
+        if (trackCache.warm_neighbours())
+        {
+            warmed = true;
+            continue;
+        }
+        if (warmed)
+        {
+            const LatencyStats &latency = player.start_latency();
+            unsigned average = latency.count ? (unsigned)(latency.total_us / latency.count) : 0;
+            pc.printf("cache hits %u misses %u, skip latency last %u avg %u max %u us\r\n",
+                      trackCache.hits(), trackCache.misses(), latency.last_us, average, latency.max_us);
+            warmed = false;
+        }
+        Thread::wait(50);
+    }
+}
+
+/**
+ * @brief Counts idle time for the clock governor. Runs at idle priority, so it only gets the CPU
+ * when every other thread is waiting.
  * @param *arguments Input arguments to thread used for RTOS thread library. Not needed to understand thread code.
  */
-void AudioVisualizerThread(void const *argument)
+void IdleThread(void const *argument)
+{
+    governor.idle();
+}
+
+/**
+ * @brief Lowers the CPU clock while the player is lightly loaded & raises it as soon as load or the
+ * playing stream needs more; the cache thread reports the changes. Once a second the player's health is
+ * recorded to the black box file. Run by the timer service every GOVERNOR_PERIOD_MS.
+ */
+void governorJob()
 {
-        while(1)
+    static int windows = 0;
+    static unsigned lastUnderruns = 0;
+    if (governor.update(GOVERNOR_PERIOD_MS, player.stream_Bps(), player.stream_rate()))
+    {
+        clockChanged = true;
+    }
+    if (++windows < BLACKBOX_WINDOWS)
+    {
+        return;
+    }
+    windows = 0;
+    BlackBoxRecord entry;
+    memset(&entry, 0, sizeof(entry));
+    player.fill_window(&entry.fifo_min, &entry.fifo_max);
+    unsigned underruns = player.underruns();
+    entry.underruns = underruns - lastUnderruns;
+    lastUnderruns = underruns;
+    entry.cpu_mhz = governor.cpu_hz() / 1000000;
+    entry.cpu_percent = governor.load();
+    entry.song = currentSong;
+    entry.flags = (playing || signalTest) ? BLACKBOX_PLAYING : 0;
+    inputs.take_window(&entry.input_audio_ms, &entry.input_lcd_ms, &entry.inputs);
+    blackBox.record(&entry);
+}
+
+/**
+ * @brief Samples the pushbuttons, which call their interrupt functions on a debounced change.
+ * Run by the timer service every BUTTON_SAMPLE_MS.
+ */
+void buttonJob()
+{
+    prev.sample();
+    next.sample();
+    play.sample();
+    shuffle.sample();
+}
+
+/**
+ * @brief Feeds the watchdog. Run by the timer service every WATCHDOG_FEED_MS, so the player resets
+ * if the service thread stops running.
+ */
+void feedWatchdog()
+{
+    __disable_irq();
+    LPC_WDT->WDFEED = 0xAA;
+    LPC_WDT->WDFEED = 0x55;
+    __enable_irq();
+}
+
+/**
+ * @brief Starts the watchdog, clocked from the 4 MHz IRC, which it divides by 4, & schedules its feeding.
+ * Run once by the timer service, after start up has settled.
+ */
+void armWatchdog()
+{
+    LPC_WDT->WDCLKSEL = 0;
+    LPC_WDT->WDTC = WATCHDOG_TIMEOUT_MS * 1000;
+    LPC_WDT->WDMOD = 0x03;      // Enabled, resets the chip on timeout
+    feedWatchdog();
+    timers.every("watchdog", WATCHDOG_FEED_MS, feedWatchdog);
+}
+
+#if CONTENT_CHAIN
+/**
+ * @brief Passes on & stores what other units send round the content ring, and copies this unit's
+ * library to them when asked from BlueTooth. A copy sent by another unit is written to the card at the
+ * same time as it is passed on, and once it is whole the unit restarts to index it. The result of
+ * each copy is reported over the PC serial port.
+ * @param *arguments Input arguments to thread used for RTOS thread library. Not needed to understand thread code.
+ */
+void ChainThread(void const *argument)
+{
+    chain.start();
+    while (true)
+    {
+        if (chainPush)
         {
-            if(playing)
+            bool ok = chain.push();
+            chainPush = false;
+            const ChainStats &stats = chain.stats();
+            pc.printf("chain push %s: %u units, %u files, %u bytes at %u B/s, %u resumes\r\n",
+                      ok ? "done" : "failed", stats.units, stats.files_sent, (unsigned)stats.last_bytes,
+                      (unsigned)stats.last_Bps, stats.resumes);
+        }
+        chain.poll();
+        Thread::wait(5);
+    }
+}
+#endif
+
+#if SCENARIO_RUNNER
+/**
+ * @brief Starts the next song if nothing is playing, so a scenario runs under playback
+**/
+void scenarioPlay()
+{
+    if (!playing && !signalTest)
+    {
+        nextSong();
+        playing = true;
+    }
+}
+
+/**
+ * @brief Cold boot scenario. The boot phase times are in every result; this adds the size of the
+ * library & the heap left once every thread has started. Put it first in the script.
+**/
+void bootScenario(ScenarioRunner &runner, int arg, int arg2)
+{
+    runner.result("tracks", songCount);
+    runner.result("heap_free", blackBox.heap_free());
+}
+
+/**
+ * @brief Skip storm: skips `count` times while playing, at random gaps of up to `gap_ms`, timing each
+ * from the request to its first sample at the DAC. Skips that take longer than SCENARIO_SKIP_TIMEOUT_MS
+ * are counted as lost.
+**/
+void skipScenario(ScenarioRunner &runner, int count, int gap_ms)
+{
+    gap_ms = gap_ms > 0 ? gap_ms : 300;
+    unsigned lost = 0;
+    scenarioPlay();
+    runner.wait(1000);
+    for (int i = 0; i < count; i++)
+    {
+        scenarioPlay();
+        unsigned started = player.start_latency().count;
+        uint32_t start = us_ticker_read();
+        nextSong();
+        while (player.start_latency().count == started && us_ticker_read() - start < SCENARIO_SKIP_TIMEOUT_MS * 1000)
+        {
+            Thread::wait(1);
+        }
+        if (player.start_latency().count != started)
+        {
+            runner.latency(player.start_latency().last_us);
+        }
+        else
+        {
+            lost++;
+        }
+        runner.wait(rand() % gap_ms);
+    }
+    runner.result("lost", lost);
+}
+
+/**
+ * @brief Long playback: plays the library in order for `seconds`, starting each song as the last ends,
+ * so a card written with mixed formats plays all of them
+**/
+void playScenario(ScenarioRunner &runner, int seconds, int arg2)
+{
+    unsigned started = player.start_latency().count;
+    uint32_t start = us_ticker_read();
+    while ((us_ticker_read() - start) / 1000 < (uint32_t)seconds * 1000)
+    {
+        scenarioPlay();
+        runner.wait(100);
+    }
+    runner.result("songs", player.start_latency().count - started);
+}
+
+/**
+ * @brief Reindex during playback: builds a second index of the library from the card `passes` times
+ * while a song plays, timing each build. The heap is measured while both indexes are held.
+**/
+void reindexScenario(ScenarioRunner &runner, int passes, int arg2)
+{
+    passes = passes > 0 ? passes : 1;
+    int tracks = 0;
+    scenarioPlay();
+    runner.wait(1000);
+    for (int i = 0; i < passes; i++)
+    {
+        scenarioPlay();
+        LibraryIndex *scratch = new LibraryIndex(&sd);
+        vector<string> names;
+        uint32_t start = us_ticker_read();
+        tracks = scratch->build(library.directory(), &names);
+        runner.latency(us_ticker_read() - start);
+        runner.result("heap_free", blackBox.heap_free());
+        delete scratch;
+        runner.wait(1000);
+    }
+    runner.result("tracks", tracks);
+}
+
+/**
+ * @brief BlueTooth browsing under load: `count` searches for the first word of a random song, `gap_ms`
+ * apart while a song plays, each timed from the request until the BlueTooth thread has sent its page
+**/
+void browseScenario(ScenarioRunner &runner, int count, int gap_ms)
+{
+    gap_ms = gap_ms > 0 ? gap_ms : 500;
+    uint32_t query_max = 0;
+    scenarioPlay();
+    runner.wait(1000);
+    for (int i = 0; i < count; i++)
+    {
+        scenarioPlay();
+        const string &name = songList[rand() % songCount];
+        int length = 0;
+        while (length < SEARCH_LINE - 1 && length < (int)name.size() && isalnum((unsigned char)name[length]))
+        {
+            scenarioText[length] = name[length];
+            length++;
+        }
+        scenarioText[length] = 0;
+        if (length == 0)
+        {
+            continue;
+        }
+        uint32_t start = us_ticker_read();
+        scenarioBrowse = true;
+        while (scenarioBrowse)
+        {
+            Thread::wait(1);
+        }
+        runner.latency(us_ticker_read() - start);
+        if (search.last_query_us() > query_max)
+        {
+            query_max = search.last_query_us();
+        }
+        runner.wait(gap_ms);
+    }
+    runner.result("query_max_us", query_max);
+}
+
+/**
+ * @brief Runs the scenario script on the card once the player has booted, & again whenever asked from
+ * BlueTooth. Each result goes over the PC serial port & is appended to the results file on the card.
+ * @param *arguments Input arguments to thread used for RTOS thread library. Not needed to understand thread code.
+ */
+void ScenarioThread(void const *argument)
+{
+    srand(us_ticker_read());
+    scenarioRun = true;
+    while (true)
+    {
+        if (scenarioRun && songCount > 0)
+        {
+            int count = scenarios.run_script("/sd/scenario.txt", "/sd/scenario.json");
+            playing = false;
+            pc.printf("scenarios: %d run\r\n", count);
+        }
+        scenarioRun = false;
+        Thread::wait(100);
+    }
+}
+#endif
+
+/**
+ * @brief Runs the timer service: the LED level meter, clock governor & black box, button debouncing
+ * and the watchdog, none of which blocks, share this one thread & stack.
+ * @param *arguments Input arguments to thread used for RTOS thread library. Not needed to understand thread code.
+ */
+void TimerThread(void const *argument)
+{
+    timers.run();
+}
+
+/**
+ * @brief Profiles the songs on the SD card while nothing is playing, then makes the fragmented ones
+ * contiguous, so playback never competes with either for the card. Each step is short, so the card is
+ * free again within a few milliseconds of a song starting. Songs that will not play cleanly and
+ * the fragmentation of each song defragmented are reported over the PC serial port. Also writes the
+ * black box sectors, so they never hold up a higher priority thread, and saves the card's calibration
+ * profile to flash when it changes.
+ * @param *arguments Input arguments to thread used for RTOS thread library. Not needed to understand thread code.
+ */
+void ScrubThread(void const *argument)
+{
+    while (true)
+    {
+        // Black box sectors are written whether or not a song is playing, one sector every 8 seconds,
+        // unless the audio is close to running dry
+        if (health.admit(blackBoxClient))
+        {
+            blackBox.flush();
+        }
+        if (playing)
+        {
+            Thread::wait(100);
+            continue;
+        }
+        // A new card profile, or one lowered by read errors, is written to flash while nothing plays:
+        // the flash write stops interrupts, which would break up a clip or the fallback loop too
+        if (!signalTest && !player.clip_playing())
+        {
+            sd.save_profile();
+        }
+        if (scrubber.step())
+        {
+            int song = scrubber.finished();
+            if (song >= 0 && MediaScrubber::flagged(library.profile(song)))
             {
-                float level = (DACout.read() - 0.25f) * 3.3f;
-                if(level<0.825)
-                {
-                    led1=true;
-                    led2=led3=led4=false;
-                }
-                else if(level>0.825&&level<1.65)
-                {
-                    led1=led2=true;
-                    led3=led4=false;
-                }
-                else if(level>1.65&&level<2.47)
-                {
-                    led1=led2=led3=true;
-                    led4=false;
-                }
-                else if(level>2.47)
-                {
-                    led1=led2=led3=led4=true;
-                }
-                Thread::wait(50);
+                const TrackProfile &profile = library.profile(song);
+                pc.printf("scrub %s: %u fragments, worst sector %u us, flags %02x\r\n",
+                          songList[song].c_str(), profile.fragments, profile.worst_us, profile.flags);
             }
         }
+        else if (defragmenter.step())
+        {
+            if (defragmenter.finished() >= 0)
+            {
+                const DefragReport &report = defragmenter.report();
+                pc.printf("defrag %s: %u fragments before, %u after\r\n",
+                          songList[report.song].c_str(), report.before, report.after);
+            }
+        }
+        else
+        {
+            Thread::wait(100);
+        }
+    }
 }
 
 // Button Interupt Functions
@@ -320,6 +1240,7 @@ void AudioVisualizerThread(void const *argument)
 **/
 void nextInt()
 {
+    noteInput(INPUT_NEXT, INPUT_BUTTON, next.edge());
     nextSong();
 }
 
@@ -328,14 +1249,50 @@ void nextInt()
 **/
 void prevInt()
 {
+    noteInput(INPUT_PREV, INPUT_BUTTON, prev.edge());
     prevSong();
 }
 
+/**
+ * @brief Opens or closes the diagnostics page once prev & next have both been held down together
+ * @details Pressing both also skips forwards & back, which leaves the same song selected.
+**/
+void checkDiagCombo()
+{
+    uint32_t gap = prevHeldUs > nextHeldUs ? prevHeldUs - nextHeldUs : nextHeldUs - prevHeldUs;
+    if (prevHeldUs != 0 && nextHeldUs != 0 && gap < DIAG_COMBO_US)
+    {
+        noteInput(INPUT_DIAGNOSTICS, INPUT_BUTTON, prevHeldUs > nextHeldUs ? prevHeldUs : nextHeldUs);
+        diagnostics = !diagnostics;
+        prevHeldUs = 0;
+        nextHeldUs = 0;
+    }
+}
+
+/**
+ * @brief Notes when prev has been held down. Attached using PinDetect.
+**/
+void prevHeldInt()
+{
+    prevHeldUs = us_ticker_read();
+    checkDiagCombo();
+}
+
+/**
+ * @brief Notes when next has been held down. Attached using PinDetect.
+**/
+void nextHeldInt()
+{
+    nextHeldUs = us_ticker_read();
+    checkDiagCombo();
+}
+
 /**
  * @brief runs playSong() function on pushbotton hit. Attached using PinDetect.
 **/
 void playInt()
 {
+    noteInput(INPUT_PLAY, INPUT_BUTTON, play.edge());
     playSong();
 }
 
@@ -344,72 +1301,273 @@ void playInt()
 **/
 void shuffleInt()
 {
+    noteInput(INPUT_SHUFFLE, INPUT_BUTTON, shuffle.edge());
     shuffleSong();
 }
 
+/**
+ * @brief One test signal of the output-chain test
+**/
+struct SignalTest
+{
+    int type;
+    uint32_t rate;
+    int bits;
+    int channels;
+    uint32_t frequency;
+    uint32_t frequency_end;
+};
+
+static const SignalTest signalTests[] =
+{
+    {SIGNAL_SINE, 44100, 16, 1, 1000, 0},
+    {SIGNAL_SINE, 8000, 8, 1, 1000, 0},
+    {SIGNAL_SINE, 48000, 32, 2, 1000, 0},
+    {SIGNAL_SWEEP, 44100, 16, 1, 20, 20000},
+    {SIGNAL_SQUARE, 44100, 16, 1, 1000, 0},
+    {SIGNAL_IMPULSE, 44100, 16, 1, 10, 0},
+    {SIGNAL_SILENCE, 44100, 16, 1, 0, 0}
+};
+static const char *signalNames[] = {"sine", "sweep", "square", "impulse", "silence"};
+
+/**
+ * @brief Plays each test signal for 3 seconds through the normal decode & output path, without
+ * touching the SD card, & reports the decode cost & sample clock jitter over the PC serial port
+ * @details Separates output problems from storage problems: if a signal plays cleanly but songs do
+ * not, the card is to blame. The sine & sweep can be checked for distortion on p18 with a scope or
+ * an audio analyser. Pausing stops the test.
+**/
+void runSignalTest()
+{
+    static uint8_t raw[SECTOR_SIZE];
+    static uint16_t decoded[SECTOR_SIZE];
+    uLCD.locate(0,12);
+    uLCD.printf("signal test     ");
+    playing = true;
+    for (unsigned i = 0; i < sizeof(signalTests) / sizeof(signalTests[0]) && playing; i++)
+    {
+        const SignalTest &test = signalTests[i];
+        if (!testSignal.configure(test.type, test.rate, test.bits, test.channels, test.frequency, test.frequency_end, 3000))
+        {
+            continue;
+        }
+        // Decode cost: one sector of the signal decoded 100 times
+        Decoder decoder;
+        open_decoder(testSignal.format, &decoder);
+        testSignal.read_sector(0, raw);
+        int frames = SECTOR_SIZE / testSignal.format.block_align;
+        uint32_t start = us_ticker_read();
+        for (int pass = 0; pass < 100; pass++)
+        {
+            decode_block(decoder, raw, frames, decoded);
+        }
+        uint32_t decode_ns = (us_ticker_read() - start) * 10 / frames;
+
+        unsigned underruns = player.underruns();
+        player.take_seek();
+        player.play(testSignal, NULL, 0, 0);
+        const JitterStats &jitter = player.jitter();
+        unsigned average = jitter.count ? (unsigned)(jitter.total_us / jitter.count) : 0;
+        pc.printf("signal %s %u Hz %d bit x%d: decode %u ns/sample, tick %u..%u us avg %u, underruns %u\r\n",
+                  signalNames[test.type], test.rate, test.bits, test.channels, decode_ns,
+                  jitter.min_us, jitter.max_us, average, player.underruns() - underruns);
+    }
+    playing = false;
+    signalTest = false;
+    uLCD.locate(0,12);
+    uLCD.printf("                ");
+}
+
 /**
  * @brief Program main routine.
  * @return int No return expected.
  */
 int main()
 {   
-    // Attach & configure interupts to pushbuttons
-    next.mode(PullUp);
-    prev.mode(PullUp);
-    play.mode(PullUp);
-    shuffle.mode(PullUp);
+    // The speaker thread runs on this stack; its paint shows how far it & the heap can still grow
+    blackBox.watch_main_stack();
+    // Report a reset by the watchdog, then clear its flag
+    if (LPC_WDT->WDMOD & 0x04)
+    {
+        pc.printf("reset by watchdog\r\n");
+        LPC_WDT->WDMOD &= ~0x04;
+    }
+    // Attach interupts to pushbuttons; the buttons are sampled once the timer service starts
     next.attach_deasserted(&nextInt);
     prev.attach_deasserted(&prevInt);
     play.attach_deasserted(&playInt);
     shuffle.attach_deasserted(&shuffleInt);
-    next.setSampleFrequency();
-    prev.setSampleFrequency();
-    play.setSampleFrequency();
-    shuffle.setSampleFrequency();
+    player.attach_effect(&audioEffect);
+    clickClip = clips.find("click");
+    errorClip = clips.find("error");
+    next.attach_deasserted_held(&nextHeldInt);
+    prev.attach_deasserted_held(&prevHeldInt);
     // Wait 10 milliseconds to ensure functions are attached
     Thread::wait(10);
     
-    // Extract file list from SD Card, place in vector<string> songList
-    DIR *dp;
-    struct dirent *dirp;
-    dp = opendir("/sd/myMusic");
-    if(dp !=NULL)
+    // Finish or undo a defragmenter swap cut short by a reset, before any song is indexed
+    defragmenter.recover("/sd/defrag.jnl");
+    // The card was mounted by the recovery, which set its SPI clock from its profile, calibrating it if new
+    const CardProfile &card = sd.profile();
+    pc.printf("sd card %s: %u kHz, read p50 %u p99 %u max %u us, read ahead %u blocks, flags %02x\r\n",
+              sd.calibrated() ? "calibrated" : "profile found", (unsigned)(card.spi_hz / 1000), card.p50_us,
+              card.p99_us, card.max_us, card.read_ahead, card.flags);
+#if SCENARIO_RUNNER
+    scenarios.boot_phase("mount");
+#endif
+
+    // Index songs on SD Card, place file names in vector<string> songList;
+    // each song is opened later from its indexed handle instead of its path
+    songCount = library.build("myMusic", &songList);
+    // A playlist in the card's root directory, if present, sets which songs play & in what order
+    if (library.load_playlist("/sd/playlist.m3u") > 0)
     {
-       while ((dirp = readdir(dp)) != NULL) {
-            songList.push_back(string(dirp->d_name));
-            songCount++;
-        }
+        songCount = library.count();
     }
-    // Wait 10 miliseconds to ensure SD card communication complete
-    Thread::wait(1000);
+#if SCENARIO_RUNNER
+    scenarios.boot_phase("index");
+#endif
+    // Resume profiling the library where the last scan stopped
+    scrubber.load("/sd/scrub.dat");
+    // Word index of the song names for searches over BlueTooth; rebuilt when the library changes
+    search.load("search.idx");
+#if SCENARIO_RUNNER
+    scenarios.boot_phase("search");
+#endif
+    // Videos on the display's card for the animation mode, written by tools/pack_animation.py
+    animation.open("/sd/anims.dat");
+    // Health metrics, recorded once a second by the governor job into a circular file
+    blackBox.open("blackbox.bin");
+    // Non-audio work, & the audio health at which it gives way
+    lcdClient = health.add_client("lcd", HEALTH_LOW);
+    ledClient = health.add_client("leds", HEALTH_LOW);
+    bluetoothClient = health.add_client("bluetooth", HEALTH_LOW);
+    cacheClient = health.add_client("cache", HEALTH_LOW);
+    searchClient = health.add_client("search", HEALTH_CRITICAL);
+    blackBoxClient = health.add_client("blackbox", HEALTH_CRITICAL);
+    // Thread stacks are painted by the black box so their high water marks can be recorded
+    // Wait 1 second to ensure SD card communication complete; the clock governor measures
+    // the idle loop over the same second, while nothing else is running
+    Thread idleThread(IdleThread, NULL, osPriorityIdle, 512, blackBox.watch_stack(512));
+    governor.calibrate(1000);
     
     // Start LCD & BlueTooth Thread
-    Thread thread1(LCDThread);
-    Thread thread2(BluetoothThread);
-    Thread thread3(AudioVisualizerThread);
+    Thread thread1(LCDThread, NULL, osPriorityNormal, DEFAULT_STACK_SIZE, blackBox.watch_stack(DEFAULT_STACK_SIZE));
+    Thread thread2(BluetoothThread, NULL, osPriorityNormal, DEFAULT_STACK_SIZE, blackBox.watch_stack(DEFAULT_STACK_SIZE));
+    Thread thread3(CacheThread, NULL, osPriorityBelowNormal, DEFAULT_STACK_SIZE, blackBox.watch_stack(DEFAULT_STACK_SIZE));
+    Thread thread4(ScrubThread, NULL, osPriorityLow, DEFAULT_STACK_SIZE, blackBox.watch_stack(DEFAULT_STACK_SIZE));
+    // Periodic work that never blocks shares the timer service thread
+    timers.every("buttons", BUTTON_SAMPLE_MS, buttonJob);
+    timers.every("leds", LED_PERIOD_MS, visualizerJob);
+    timers.every("governor", GOVERNOR_PERIOD_MS, governorJob);
+    timers.after("watchdog", WATCHDOG_ARM_MS, armWatchdog);
+    Thread timerThread(TimerThread, NULL, osPriorityNormal, 1024, blackBox.watch_stack(1024));
+#if CONTENT_CHAIN
+    // The diagnostics page has no row left for the ring, so its time shows as other
+    Thread chainThread(ChainThread, NULL, osPriorityBelowNormal);
+#endif
+#if SCENARIO_RUNNER
+    // Scenarios the script on the card can run; their thread has no row on the diagnostics page either
+    scenarios.add("boot", bootScenario);
+    scenarios.add("skips", skipScenario);
+    scenarios.add("play", playScenario);
+    scenarios.add("reindex", reindexScenario);
+    scenarios.add("browse", browseScenario);
+    Thread scenarioThread(ScenarioThread, NULL, osPriorityBelowNormal);
+#endif
+    // Threads told apart on the diagnostics page, in the order their stacks were watched
+    profiler.add_thread("idle", idleThread.gettid());
+    profiler.add_thread("lcd", thread1.gettid());
+    profiler.add_thread("bt", thread2.gettid());
+    profiler.add_thread("cache", thread3.gettid());
+    profiler.add_thread("scrub", thread4.gettid());
+    profiler.add_thread("timers", timerThread.gettid());
+    profiler.add_thread("speaker", osThreadGetId());
+#if SCENARIO_RUNNER
+    scenarios.boot_phase("ready");
+#endif
+    // A chime once the player is ready; with no card, or no songs on it, a loop from flash instead
+    if (songCount == 0)
+    {
+        pc.printf("no songs found, playing the fallback loop\r\n");
+        player.play_clip(clips, clips.find("fallback"));
+    }
+    else
+    {
+        player.play_clip(clips, clips.find("chime"));
+    }
 
     // Main while loop:
     // Main loop is now considered the Speaker Thread, playing/pausing current song 
     // based on changes in global varaibles boolean playing & integer currentSong
     while (true)
     {
-        // Read in selected file
-        FILE *wave_file;
-        string selectedSong= "/sd/myMusic/" + songList[currentSong];
-        const char* song = selectedSong.c_str();
-        wave_file=fopen(song,"r");
-        if(wave_file==NULL)
+        // The test signals take over the speaker until they finish or are paused
+        if (signalTest)
+        {
+            runSignalTest();
+            continue;
+        }
+        // Wait for a song to be played; with no songs the fallback loop keeps playing
+        if (!playing || songCount == 0)
+        {
+            Thread::wait(10);
+            continue;
+        }
+        // Fetch the warm state of the selected song; on a cache miss it is opened here
+        WarmEntry *track = trackCache.acquire(currentSong);
+        if (track == NULL)
         {
             uLCD.locate(0,12);
             uLCD.printf("file open error!");
+            player.play_clip(clips, errorClip);
+            playing = false;
+            continue;
+        }
+        // Play song; stops early when paused or when another song is selected. Consecutive tracks of
+        // a CUE sheet album run on from the same open file without stopping the sample clock
+        // A seek restarts the same song further on, skipping to the target without the warm block
+        int result;
+        uint32_t from = track->start;
+        player.take_seek();
+        while (true)
+        {
+            int song = currentSong;
+            int following = (song + 1) % songCount;
+            bool gapless = library.continues(song, following);
+            if (from == track->start)
+            {
+                result = player.play_range(track->stream, track->start, track->end, track->block,
+                                           track->block_samples, track->block_bytes, gapless);
+            }
+            else
+            {
+                result = player.play_range(track->stream, track->start, track->end, NULL, 0, from - track->start, gapless);
+            }
+            if (result == PLAY_SEEKED && currentSong == song)
+            {
+                from = seekTarget(track, track->start + player.played(), player.take_seek());
+                continue;
+            }
+            if (result != PLAY_DONE || !gapless || currentSong != song)
+            {
+                break;
+            }
+            track = trackCache.advance(track, following);
+            currentSong = following;
+            from = track->start;
+        }
+        player.stop();
+        trackCache.release(track);
+        // A song the card fails partway through is marked by the error clip
+        if (result == PLAY_ERROR)
+        {
+            player.play_clip(clips, errorClip);
+        }
+        // Reset playing variable so song does not repeat; a skip carries on with the new song
+        if (result != PLAY_SKIPPED)
+        {
+            playing = false;
         }
-        // Wait 10 miliseconds to ensure file properly loaded
-        Thread::wait(1000);
-        // Play file; stop/play feature built into waver library
-        waver.play(wave_file);
-        // Close file
-        fclose(wave_file);
-        // Reset playing variable so song does not repeat
-        playing = false;
     }
 }
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""Plots the player's black box file (blackbox.bin from the SD card) as a time series.
+
+Usage: blackbox_plot.py blackbox.bin [--boot N] [--csv out.csv] [--out plot.png]
+
+Records are put back in order by their sequence numbers, so the plot runs from the oldest record
+still in the circular file to the newest. Boots are marked with vertical lines.
+"""
+import argparse
+import struct
+import sys
+
+# Layout of BlackBoxRecord in BlackBox.h
+RECORD = struct.Struct("<IIHHHHHHHHhBB8HHHB15x")
+NUM_STACKS = 8
+FLAG_PLAYING = 0x01
+FLAG_DROPPED = 0x02
+# Order the thread stacks are watched in main()
+STACKS = ["idle", "lcd", "bluetooth", "cache", "scrub", "timers"]
+FIELDS = ["sequence", "uptime_s", "boot", "cpu_mhz", "fifo_min", "fifo_max", "underruns",
+          "sd_p99_us", "sd_max_us", "heap_free", "song", "cpu_percent", "flags"]
+# Slowest command to reach the audio & the screen, & commands timed, over each second
+INPUT_FIELDS = ["input_audio_ms", "input_lcd_ms", "inputs"]
+
+
+def read_records(path):
+    records = []
+    with open(path, "rb") as f:
+        data = f.read()
+    for offset in range(0, len(data) - RECORD.size + 1, RECORD.size):
+        values = RECORD.unpack_from(data, offset)
+        record = dict(zip(FIELDS, values[:len(FIELDS)]))
+        if record["sequence"] == 0:
+            continue
+        record["stack_free"] = values[len(FIELDS):len(FIELDS) + NUM_STACKS]
+        record.update(zip(INPUT_FIELDS, values[len(FIELDS) + NUM_STACKS:]))
+        records.append(record)
+    records.sort(key=lambda r: r["sequence"])
+    return records
+
+
+def write_csv(records, path):
+    with open(path, "w") as f:
+        f.write(",".join(FIELDS + INPUT_FIELDS + ["stack_" + name for name in STACKS]) + "\n")
+        for r in records:
+            row = [r[name] for name in FIELDS + INPUT_FIELDS] + list(r["stack_free"][:len(STACKS)])
+            f.write(",".join(str(v) for v in row) + "\n")
+
+
+def plot(records, out):
+    import matplotlib
+    if out:
+        matplotlib.use("Agg")
+    import matplotlib.pyplot as plt
+
+    # Seconds since the first record, counting each boot on from the end of the one before
+    t = []
+    base = 0
+    prev = None
+    boots = []
+    for r in records:
+        if prev is not None and r["boot"] != prev["boot"]:
+            base = t[-1] + 1 - r["uptime_s"]
+            boots.append(base + r["uptime_s"])
+        t.append(base + r["uptime_s"])
+        prev = r
+
+    fig, axes = plt.subplots(6, 1, sharex=True, figsize=(12, 14))
+    axes[0].plot(t, [r["fifo_min"] for r in records], label="min")
+    axes[0].plot(t, [r["fifo_max"] for r in records], label="max")
+    axes[0].set_ylabel("FIFO fill")
+    axes[0].legend(loc="upper right")
+    under = axes[0].twinx()
+    under.bar(t, [r["underruns"] for r in records], color="red", width=1.0)
+    under.set_ylabel("underruns", color="red")
+
+    axes[1].plot(t, [r["sd_p99_us"] for r in records], label="p99")
+    axes[1].plot(t, [r["sd_max_us"] for r in records], label="max")
+    axes[1].set_ylabel("SD read us")
+    axes[1].set_yscale("log")
+    axes[1].legend(loc="upper right")
+
+    axes[2].plot(t, [r["cpu_percent"] for r in records], label="load %")
+    axes[2].plot(t, [r["cpu_mhz"] for r in records], label="MHz")
+    axes[2].set_ylabel("CPU")
+    axes[2].legend(loc="upper right")
+
+    axes[3].plot(t, [r["heap_free"] for r in records], label="heap")
+    for i, name in enumerate(STACKS):
+        axes[3].plot(t, [r["stack_free"][i] for r in records], label=name)
+    axes[3].set_ylabel("free bytes")
+    axes[3].set_yscale("symlog")
+    axes[3].legend(loc="upper right", fontsize="small", ncol=4)
+
+    timed = [(ti, r) for ti, r in zip(t, records) if r["inputs"]]
+    axes[4].scatter([ti for ti, r in timed], [r["input_audio_ms"] for ti, r in timed], s=8, label="audio")
+    axes[4].scatter([ti for ti, r in timed], [r["input_lcd_ms"] for ti, r in timed], s=8, label="lcd")
+    axes[4].set_ylabel("command ms")
+    axes[4].legend(loc="upper right")
+
+    axes[5].step(t, [r["song"] if r["flags"] & FLAG_PLAYING else -1 for r in records], where="post")
+    axes[5].set_ylabel("song (-1 idle)")
+    axes[5].set_xlabel("seconds")
+
+    for ax in axes:
+        for b in boots:
+            ax.axvline(b, color="grey", linestyle=":")
+        for ti, r in zip(t, records):
+            if r["flags"] & FLAG_DROPPED:
+                ax.axvline(ti, color="orange", alpha=0.3)
+    fig.tight_layout()
+    if out:
+        fig.savefig(out)
+    else:
+        plt.show()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("file")
+    parser.add_argument("--boot", type=int, help="only plot this boot")
+    parser.add_argument("--csv", help="also write the ordered records as CSV")
+    parser.add_argument("--out", help="save the plot to a file instead of showing it")
+    args = parser.parse_args()
+
+    records = read_records(args.file)
+    if args.boot is not None:
+        records = [r for r in records if r["boot"] == args.boot]
+    if not records:
+        sys.exit("no records")
+    print("%d records, boots %d-%d, %d underruns" % (len(records), records[0]["boot"], records[-1]["boot"],
+                                                    sum(r["underruns"] for r in records)))
+    if args.csv:
+        write_csv(records, args.csv)
+    plot(records, args.out)
+
+
+if __name__ == "__main__":
+    main()
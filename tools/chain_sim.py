@@ -0,0 +1,447 @@
+#!/usr/bin/env python3
+"""Runs the content ring protocol of ContentChain between host processes, to try it without boards.
+
+Usage: chain_sim.py ring --card SRC --units N [--baud B] [--kill-after S] [--work DIR]
+       chain_sim.py node --card DIR --rx FD --tx FD [--baud B]
+
+A directory stands in for each unit's card: SRC holds the sending unit's library (playlist.m3u &
+myMusic/), & `ring` makes an empty card for each of the N other units under --work. The units are
+linked in a ring by pipes, each throttled to the UART's baud rate, with one process per receiving
+unit & the sender in this process. Once the push finishes, every card is compared with SRC & the
+end-to-end rate is reported. --kill-after kills the first receiving unit that many seconds in and
+starts it again, to show the copy resuming from its journal.
+"""
+import argparse
+import os
+import select
+import shutil
+import signal
+import struct
+import subprocess
+import sys
+import time
+import zlib
+
+# Layout of ChainHeader, ChainEntry & ChainJournal in ContentChain.h
+HEADER = struct.Struct("<BBBBHHII")
+ENTRY = struct.Struct("<IIB3x48s")
+JOURNAL = struct.Struct("<I%dsII" % ENTRY.size)
+SYNC = b"\xa5\x5a"
+ANNOUNCE, BEGIN, DATA, END, DONE = 1, 2, 3, 4, 5
+SECTOR = 512
+BAUD = 460800
+WINDOW = 3
+BATCH_SECTORS = 4
+JOURNAL_BATCHES = 8
+TIMEOUT = 2.0
+FRAME_TIMEOUT = 0.05
+RETRIES = 5
+MAX_FILES = 256
+MAX_HOPS = 32
+NAME_LEN = 48
+PER_FRAME = SECTOR // ENTRY.size
+JOURNAL_MAGIC = 0x4E484343
+TEMP_NAME = "chain.tmp"
+JOURNAL_NAME = "chain.jnl"
+PLAYLIST_NAME = "playlist.m3u"
+LIBRARY = "myMusic"
+
+
+class Entry:
+    def __init__(self, name, size, signature, needed=0):
+        self.name, self.size, self.signature, self.needed = name, size, signature, needed
+
+    def pack(self):
+        return ENTRY.pack(self.size, self.signature, self.needed, self.name.encode()[:NAME_LEN])
+
+    @classmethod
+    def unpack(cls, data):
+        size, signature, needed, name = ENTRY.unpack(data)
+        return cls(name.rstrip(b"\0").decode(errors="replace"), size, signature, needed)
+
+    def same(self, other):
+        return (self.name, self.size, self.signature) == (other.name, other.size, other.signature)
+
+
+def signature(path, size):
+    """Adler-32 of the first sector & of the bytes of the last sector, or None if unreadable."""
+    try:
+        if os.path.getsize(path) != size or size == 0:
+            return None
+        with open(path, "rb") as f:
+            last = (size - 1) // SECTOR
+            sig = zlib.adler32(f.read(min(size, SECTOR)))
+            if last > 0:
+                f.seek(last * SECTOR)
+                sig = zlib.adler32(f.read(size - last * SECTOR), sig)
+        return sig
+    except OSError:
+        return None
+
+
+def journal_check(magic, entry, committed):
+    """journal_check in ContentChain.cpp."""
+    return (magic + entry.size + entry.signature + committed +
+            zlib.adler32(entry.name.encode()[:NAME_LEN].ljust(NAME_LEN, b"\0"))) & 0xFFFFFFFF
+
+
+class Link:
+    """One unit's end of the ring: frames out through tx, frames in through rx, at the UART's rate."""
+
+    def __init__(self, rx, tx, baud):
+        self.rx, self.tx, self.baud = rx, tx, baud
+        self.buffer = b""
+        self.stats = {"in": 0, "out": 0, "bad": 0}
+
+    def send(self, ftype, hops, file, sector, payload=b""):
+        header = HEADER.pack(SYNC[0], SYNC[1], ftype, hops, file, len(payload), sector, 0)
+        check = zlib.adler32(payload, zlib.adler32(header))
+        frame = header[:-4] + struct.pack("<I", check) + payload
+        os.write(self.tx, frame)
+        # Each byte takes 10 bit times on the wire
+        time.sleep(len(frame) * 10.0 / self.baud)
+        self.stats["out"] += 1
+
+    def _fill(self, deadline):
+        wait = deadline - time.monotonic()
+        if wait <= 0 or not select.select([self.rx], [], [], wait)[0]:
+            return False
+        data = os.read(self.rx, 4096)
+        if not data:
+            raise EOFError
+        self.buffer += data
+        return True
+
+    def read(self, timeout):
+        """Next good frame as (type, hops, file, sector, payload), or None once timeout passes."""
+        deadline = time.monotonic() + timeout
+        while True:
+            start = self.buffer.find(SYNC)
+            if start < 0:
+                self.buffer = self.buffer[-1:] if self.buffer[-1:] == SYNC[:1] else b""
+            else:
+                self.buffer = self.buffer[start:]
+                if len(self.buffer) >= HEADER.size:
+                    _, _, ftype, hops, file, length, sector, check = HEADER.unpack_from(self.buffer)
+                    if length > SECTOR:
+                        self.stats["bad"] += 1
+                        self.buffer = self.buffer[2:]
+                        continue
+                    if len(self.buffer) >= HEADER.size + length:
+                        header = self.buffer[:HEADER.size - 4] + b"\0\0\0\0"
+                        payload = self.buffer[HEADER.size:HEADER.size + length]
+                        self.buffer = self.buffer[HEADER.size + length:]
+                        if zlib.adler32(payload, zlib.adler32(header)) == check and hops < MAX_HOPS:
+                            self.stats["in"] += 1
+                            return ftype, hops, file, sector, payload
+                        self.stats["bad"] += 1
+                        continue
+                    # The rest of a started frame has FRAME_TIMEOUT to arrive
+                    deadline = max(deadline, time.monotonic() + FRAME_TIMEOUT)
+            if not self._fill(deadline):
+                return None
+
+
+class Node:
+    """A receiving unit, as ContentChain::poll handles frames."""
+
+    def __init__(self, card, link):
+        self.card, self.link = card, link
+        self.receiving = False
+        self.current = 0
+        self.batch = []
+        self.unjournalled = 0
+        self.changed = False
+        self.entry, self.committed = None, 0
+        self.load_journal()
+
+    def path(self, name):
+        return os.path.join(self.card, name)
+
+    def load_journal(self):
+        try:
+            with open(self.path(JOURNAL_NAME), "rb") as f:
+                magic, entry, committed, check = JOURNAL.unpack(f.read(JOURNAL.size))
+        except (OSError, struct.error):
+            return
+        entry = Entry.unpack(entry)
+        if magic == JOURNAL_MAGIC and check == journal_check(magic, entry, committed):
+            self.entry, self.committed = entry, committed
+
+    def save_journal(self):
+        entry = self.entry or Entry("", 0, 0)
+        magic = JOURNAL_MAGIC if self.entry else 0
+        check = journal_check(magic, entry, self.committed)
+        with open(self.path(JOURNAL_NAME), "wb") as f:
+            f.write(JOURNAL.pack(magic, entry.pack(), self.committed, check).ljust(SECTOR, b"\0"))
+            f.flush()
+            os.fsync(f.fileno())
+        self.unjournalled = 0
+
+    def needs(self, entry):
+        return signature(self.path(entry.name), entry.size) != entry.signature
+
+    def sectors(self):
+        return (self.entry.size + SECTOR - 1) // SECTOR
+
+    def begin(self, file, entry):
+        self.current, self.batch = file, []
+        if self.receiving and self.entry.same(entry):
+            return
+        self.receiving = False
+        temp = self.path(TEMP_NAME)
+        if self.entry and self.entry.same(entry) and os.path.exists(temp) and os.path.getsize(temp) == entry.size:
+            self.receiving = True
+            print("node %s: resuming %s at sector %d" % (self.card, entry.name, self.committed), flush=True)
+            return
+        # Journal the new file first, so a kill while the temporary file is remade never resumes into it
+        entry.needed = 0
+        self.entry, self.committed = entry, 0
+        self.save_journal()
+        with open(temp, "wb") as f:
+            f.truncate(entry.size)
+        self.receiving = True
+
+    def store(self, sector, data):
+        if sector != self.committed + len(self.batch):
+            return
+        self.batch.append(data)
+        if len(self.batch) == BATCH_SECTORS or self.committed + len(self.batch) == self.sectors():
+            self.flush()
+
+    def flush(self):
+        with open(self.path(TEMP_NAME), "r+b") as f:
+            f.seek(self.committed * SECTOR)
+            data = b"".join(self.batch)
+            f.write(data[:max(0, self.entry.size - self.committed * SECTOR)])
+        self.committed += len(self.batch)
+        self.batch = []
+        self.unjournalled += 1
+        if self.unjournalled >= JOURNAL_BATCHES:
+            self.save_journal()
+
+    def end(self):
+        name = self.entry.name
+        target = self.path(name)
+        os.makedirs(os.path.dirname(target) or self.card, exist_ok=True)
+        os.replace(self.path(TEMP_NAME), target)
+        self.receiving = False
+        self.entry, self.committed = None, 0
+        self.save_journal()
+        self.changed = True
+        print("node %s: received %s" % (self.card, name), flush=True)
+
+    def handle(self, ftype, hops, file, sector, payload):
+        hops += 1
+        send = lambda: self.link.send(ftype, hops, file, sector, payload)
+        if ftype == ANNOUNCE:
+            entries = [Entry.unpack(payload[i:i + ENTRY.size]) for i in range(0, len(payload), ENTRY.size)]
+            for entry in entries:
+                if not entry.needed and self.needs(entry):
+                    entry.needed = 1
+            payload = b"".join(entry.pack() for entry in entries)
+            send()
+        elif ftype == BEGIN:
+            entry = Entry.unpack(payload[:ENTRY.size])
+            if self.needs(entry):
+                self.begin(file, entry)
+                if self.receiving:
+                    sector = min(sector, self.committed)
+            elif self.receiving and file == self.current:
+                self.receiving = False
+            send()
+        elif ftype == DATA:
+            send()
+            if self.receiving and file == self.current:
+                self.store(sector, payload)
+        elif ftype == END:
+            whole = False
+            if self.receiving and file == self.current:
+                if self.batch:
+                    self.flush()
+                self.save_journal()
+                sector = min(sector, self.committed)
+                whole = self.committed >= self.sectors()
+            send()
+            if whole:
+                self.end()
+        elif ftype == DONE:
+            send()
+            if self.changed:
+                # The firmware restarts here to index the new files
+                print("node %s: done, restarting to index" % self.card, flush=True)
+                self.changed = False
+        else:
+            send()
+
+    def run(self):
+        while True:
+            frame = self.link.read(1.0)
+            if frame:
+                self.handle(*frame)
+
+
+class Sender:
+    """The pushing unit, as ContentChain::push sends its library."""
+
+    def __init__(self, card, link):
+        self.card, self.link = card, link
+        self.units = 1
+        self.resumes = 0
+
+    def scan(self):
+        names = []
+        if os.path.isfile(os.path.join(self.card, PLAYLIST_NAME)):
+            names.append(PLAYLIST_NAME)
+        library = os.path.join(self.card, LIBRARY)
+        if os.path.isdir(library):
+            names += [LIBRARY + "/" + n for n in sorted(os.listdir(library))
+                      if os.path.isfile(os.path.join(library, n)) and len(LIBRARY) + 1 + len(n) < NAME_LEN]
+        entries = []
+        for name in names:
+            path = os.path.join(self.card, name)
+            size = os.path.getsize(path)
+            if size > 0:
+                entries.append(Entry(name, size, signature(path, size)))
+        return entries[:MAX_FILES]
+
+    def exchange(self, ftype, file, sector, payload=b""):
+        for _ in range(RETRIES):
+            self.link.send(ftype, 0, file, sector, payload)
+            while True:
+                frame = self.link.read(TIMEOUT)
+                if frame is None:
+                    break
+                if frame[0] == ftype and frame[2] == file:
+                    self.units = frame[1] + 1
+                    return frame
+        raise IOError("ring stopped answering")
+
+    def send_file(self, file, entry):
+        total = (entry.size + SECTOR - 1) // SECTOR
+        best, stalls = 0, 0
+        with open(os.path.join(self.card, entry.name), "rb") as f:
+            while True:
+                resume = self.exchange(BEGIN, file, total, entry.pack())[3]
+                sent = acked = resume
+                while acked < total:
+                    while sent < total and sent - acked < WINDOW:
+                        f.seek(sent * SECTOR)
+                        self.link.send(DATA, 0, file, sent, f.read(SECTOR).ljust(SECTOR, b"\0"))
+                        sent += 1
+                    frame = self.link.read(TIMEOUT)
+                    if frame is None:
+                        break
+                    if frame[0] == DATA and frame[2] == file:
+                        if frame[3] != acked:
+                            break
+                        acked += 1
+                done = self.exchange(END, file, total)[3]
+                if done >= total:
+                    return True
+                if done > best:
+                    best, stalls = done, 0
+                else:
+                    stalls += 1
+                    if stalls >= RETRIES:
+                        return False
+                self.resumes += 1
+                print("%s: round ended with every unit at sector %d or later" % (entry.name, done), flush=True)
+
+    def push(self):
+        entries = self.scan()
+        needed = []
+        for first in range(0, len(entries), PER_FRAME):
+            chunk = entries[first:first + PER_FRAME]
+            payload = self.exchange(ANNOUNCE, first, 0, b"".join(e.pack() for e in chunk))[4]
+            for i in range(len(chunk)):
+                if Entry.unpack(payload[i * ENTRY.size:(i + 1) * ENTRY.size]).needed:
+                    needed.append(first + i)
+        ok, sent = True, 0
+        for i in needed:
+            if self.send_file(i, entries[i]):
+                sent += entries[i].size
+            else:
+                ok = False
+        self.exchange(DONE, 0, 0)
+        return ok, len(needed), sent
+
+
+def compare(src, card):
+    """Files of the library that differ between two cards."""
+    bad = []
+    for entry in Sender(src, None).scan():
+        try:
+            with open(os.path.join(src, entry.name), "rb") as a, open(os.path.join(card, entry.name), "rb") as b:
+                if a.read() != b.read():
+                    bad.append(entry.name)
+        except OSError:
+            bad.append(entry.name)
+    return bad
+
+
+def start_node(args, card, rx, tx):
+    return subprocess.Popen([sys.executable, os.path.abspath(__file__), "node", "--card", card, "--rx", str(rx),
+                             "--tx", str(tx), "--baud", str(args.baud)], pass_fds=(rx, tx))
+
+
+def ring(args):
+    cards = [os.path.join(args.work, "unit%d" % (i + 1)) for i in range(args.units)]
+    for card in cards:
+        if not args.keep:
+            shutil.rmtree(card, ignore_errors=True)
+        os.makedirs(card, exist_ok=True)
+    # Pipe i runs from unit i to unit i + 1, & the last back to the sender
+    pipes = [os.pipe() for _ in range(args.units + 1)]
+    nodes = [start_node(args, cards[i], pipes[i][0], pipes[i + 1][1]) for i in range(args.units)]
+    if args.kill_after:
+        def restart(signum, frame):
+            print("killing & restarting %s" % cards[0], flush=True)
+            nodes[0].kill()
+            nodes[0].wait()
+            time.sleep(0.5)
+            nodes[0] = start_node(args, cards[0], pipes[0][0], pipes[1][1])
+        signal.signal(signal.SIGALRM, restart)
+        signal.setitimer(signal.ITIMER_REAL, args.kill_after)
+    sender = Sender(args.card, Link(pipes[args.units][0], pipes[0][1], args.baud))
+    start = time.monotonic()
+    try:
+        ok, files, sent = sender.push()
+    finally:
+        for node in nodes:
+            node.kill()
+    elapsed = time.monotonic() - start
+    print("push %s: %d units, %d files, %d bytes in %.1f s, %.0f B/s end to end, %d resumes"
+          % ("done" if ok else "failed", sender.units, files, sent, elapsed, sent / elapsed if elapsed else 0,
+             sender.resumes))
+    failed = False
+    for card in cards:
+        bad = compare(args.card, card)
+        print("%s: %s" % (card, "matches" if not bad else "differs: " + ", ".join(bad)))
+        failed = failed or bool(bad)
+    return 1 if failed or not ok else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("mode", choices=["ring", "node"])
+    parser.add_argument("--card", required=True)
+    parser.add_argument("--units", type=int, default=3)
+    parser.add_argument("--baud", type=int, default=BAUD)
+    parser.add_argument("--kill-after", type=float, default=0)
+    parser.add_argument("--work", default="chain_work")
+    parser.add_argument("--keep", action="store_true", help="keep what the receiving cards already hold")
+    parser.add_argument("--rx", type=int)
+    parser.add_argument("--tx", type=int)
+    args = parser.parse_args()
+    if args.mode == "node":
+        try:
+            Node(args.card, Link(args.rx, args.tx, args.baud)).run()
+        except (EOFError, KeyboardInterrupt):
+            pass
+        return 0
+    return ring(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
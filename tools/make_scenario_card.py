@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""Writes a test library & scenario script for a bench build of the player (SCENARIO_RUNNER=1).
+
+Usage: make_scenario_card.py CARD_DIR [--tracks N] [--seconds N] [--formats pcm16,pcm8,mulaw,alaw]
+                             [--script FILE]
+
+Fills CARD_DIR/myMusic with N short tone tracks, rotating through the formats given, and writes
+CARD_DIR/scenario.txt, which the player runs after boot. Copy CARD_DIR to the root of a FAT32 card.
+Track names are made of a few words from a small list, so the browsing scenario's searches match
+anything from one song to a few hundred.
+
+The default script is the standard suite: cold boot, a 500 skip storm, an hour of playback, three
+reindexes during playback & 200 BlueTooth searches. Every song name is held in RAM once indexed,
+so a library as large as the default may not fit on the LPC1768; the boot result shows the heap left.
+"""
+import argparse
+import math
+import os
+import struct
+import sys
+
+# FMT_STRUCT::comp_code values, as in Codec.h
+WAVE_FORMAT_PCM = 1
+WAVE_FORMAT_ALAW = 6
+WAVE_FORMAT_MULAW = 7
+# name: (comp_code, sample rate, bits, channels)
+FORMATS = {
+    "pcm16": (WAVE_FORMAT_PCM, 44100, 16, 2),
+    "pcm8": (WAVE_FORMAT_PCM, 22050, 8, 1),
+    "mulaw": (WAVE_FORMAT_MULAW, 8000, 8, 1),
+    "alaw": (WAVE_FORMAT_ALAW, 8000, 8, 1),
+}
+WORDS = ["blue", "night", "river", "song", "dance", "light", "road", "heart", "city", "rain",
+         "fire", "dream", "ocean", "star", "home", "wild"]
+# Whole-hertz tones, so one second of samples repeats without a click
+TONES = [220, 262, 294, 330, 349, 392, 440, 494]
+SCRIPT = """# Written by tools/make_scenario_card.py; one scenario per line, results go to scenario.json
+boot
+skips 500 300
+play 3600
+reindex 3
+browse 200 500
+"""
+
+
+def mulaw(sample):
+    """G.711 mu-law byte of a 16 bit sample."""
+    # Negative samples round away from zero, as in the G.711 reference code
+    sign = 0x80 if sample < 0 else 0
+    magnitude = min(-(sample >> 2) << 2 if sample < 0 else sample, 32635) + 0x84
+    exponent = 7
+    while exponent > 0 and not magnitude & (0x4000 >> (7 - exponent)):
+        exponent -= 1
+    mantissa = (magnitude >> (exponent + 3)) & 0x0F
+    return ~(sign | (exponent << 4) | mantissa) & 0xFF
+
+
+def alaw(sample):
+    """G.711 A-law byte of a 16 bit sample."""
+    sign = 0x80 if sample >= 0 else 0
+    magnitude = sample >> 3 if sample >= 0 else -(sample >> 3) - 1
+    if magnitude < 32:
+        byte = magnitude >> 1
+    else:
+        exponent = 1
+        while magnitude >= 64 and exponent < 7:
+            magnitude >>= 1
+            exponent += 1
+        byte = (exponent << 4) | ((magnitude >> 1) & 0x0F)
+    return (byte | sign) ^ 0x55
+
+
+def second_of_tone(fmt, frequency):
+    """One second of a tone at half scale, in the sample format of fmt."""
+    code, rate, bits, channels = FORMATS[fmt]
+    out = bytearray()
+    for i in range(rate):
+        value = int(16383 * math.sin(2 * math.pi * frequency * i / rate))
+        if code == WAVE_FORMAT_MULAW:
+            frame = bytes([mulaw(value)])
+        elif code == WAVE_FORMAT_ALAW:
+            frame = bytes([alaw(value)])
+        elif bits == 8:
+            frame = bytes([(value >> 8) + 128])
+        else:
+            frame = struct.pack("<h", value)
+        out += frame * channels
+    return bytes(out)
+
+
+def write_wav(path, fmt, data, seconds):
+    code, rate, bits, channels = FORMATS[fmt]
+    align = channels * bits // 8
+    size = len(data) * seconds
+    with open(path, "wb") as f:
+        f.write(struct.pack("<4sI4s", b"RIFF", 36 + size, b"WAVE"))
+        f.write(struct.pack("<4sIHHIIHH", b"fmt ", 16, code, channels, rate, rate * align, align, bits))
+        f.write(struct.pack("<4sI", b"data", size))
+        for _ in range(seconds):
+            f.write(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("card")
+    parser.add_argument("--tracks", type=int, default=5000)
+    parser.add_argument("--seconds", type=int, default=5)
+    parser.add_argument("--formats", default="pcm16,pcm8,mulaw,alaw")
+    parser.add_argument("--script", help="scenario script to copy instead of the standard suite")
+    args = parser.parse_args()
+
+    formats = args.formats.split(",")
+    for fmt in formats:
+        if fmt not in FORMATS:
+            sys.exit("unknown format %s; known: %s" % (fmt, ", ".join(sorted(FORMATS))))
+    music = os.path.join(args.card, "myMusic")
+    os.makedirs(music, exist_ok=True)
+
+    tones = {}
+    for i in range(args.tracks):
+        fmt = formats[i % len(formats)]
+        tone = TONES[i % len(TONES)]
+        if (fmt, tone) not in tones:
+            tones[(fmt, tone)] = second_of_tone(fmt, tone)
+        words = [WORDS[i % len(WORDS)], WORDS[(i // len(WORDS)) % len(WORDS)]]
+        name = "%s %s %04d %s.wav" % (words[0].title(), words[1], i + 1, fmt)
+        write_wav(os.path.join(music, name), fmt, tones[(fmt, tone)], args.seconds)
+
+    script = SCRIPT
+    if args.script:
+        with open(args.script) as f:
+            script = f.read()
+    with open(os.path.join(args.card, "scenario.txt"), "w") as f:
+        f.write(script)
+    print("%d tracks of %d s in %s, script in %s" % (args.tracks, args.seconds, music,
+                                                     os.path.join(args.card, "scenario.txt")))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""Renders an animation for each song & packs them for the uLCD's own microSD card.
+
+Usage: pack_animation.py SONG.wav [SONG.wav ...] [--fps N] [--loop] [--first-sector N]
+                         [--image display.img] [--manifest anims.dat]
+
+Each song gets a video timed to its audio: one frame every 1/fps seconds, showing the waveform &
+level of that stretch of the song. The videos go into a raw image for the display's card, in the
+Goldelox video format read by media_VideoFrame, each starting on a sector boundary. The manifest
+lists the sector, frame count & rate of each video & goes in the root of the player's card.
+
+Write the image to the display's card raw, e.g. dd if=display.img of=/dev/sdX bs=512 seek=N, with
+the same N as --first-sector; this overwrites whatever the card held there.
+"""
+import argparse
+import os
+import struct
+import sys
+import wave
+
+SECTOR = 512
+# Layout of AnimationHeader & AnimationEntry in DisplayAnimation.h
+MAGIC = 0x4D494E41
+HEADER = struct.Struct("<II")
+ENTRY = struct.Struct("<40sIHHBBBB")
+LOOP_NAME = "*"
+# Video area: the song list rows, above "NOW PLAYING"
+WIDTH = 128
+HEIGHT = 88
+X = 0
+Y = 0
+# Goldelox colour mode byte for 16 bit pixels
+COLOUR_16BIT = 0x10
+LOOP_FRAMES = 24
+# Bytes of the Goldelox video header
+HEADER_BYTES = 8
+
+
+def rgb565(r, g, b):
+    return ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+
+
+BLACK = rgb565(0, 0, 0)
+GRID = rgb565(40, 40, 40)
+
+
+def level_colour(level):
+    """Green through yellow to red as the level rises from 0 to 1."""
+    level = max(0.0, min(1.0, level))
+    if level < 0.5:
+        return rgb565(int(510 * level), 255, 0)
+    return rgb565(255, int(510 * (1 - level)), 0)
+
+
+def read_mono(path):
+    """Samples of an 8 or 16 bit PCM WAV file, mixed to mono & scaled to -1..1, & its sample rate."""
+    with wave.open(path, "rb") as w:
+        width = w.getsampwidth()
+        channels = w.getnchannels()
+        rate = w.getframerate()
+        data = w.readframes(w.getnframes())
+    if width == 1:
+        values = [(b - 128) / 128.0 for b in data]
+    elif width == 2:
+        values = [v / 32768.0 for v in struct.unpack("<%dh" % (len(data) // 2), data[:len(data) // 2 * 2])]
+    else:
+        raise wave.Error("%d bit samples" % (8 * width))
+    return [sum(values[i:i + channels]) / channels for i in range(0, len(values), channels)], rate
+
+
+def render_frame(window):
+    """One frame: a column per slice of the window from its lowest to highest sample, over a level bar."""
+    pixels = [BLACK] * (WIDTH * HEIGHT)
+    mid = HEIGHT // 2
+    for x in range(WIDTH):
+        pixels[mid * WIDTH + x] = GRID
+    if not window:
+        return pixels
+    rms = (sum(s * s for s in window) / len(window)) ** 0.5
+    colour = level_colour(rms * 3)
+    step = max(1, len(window) // WIDTH)
+    for x in range(WIDTH):
+        part = window[x * step:(x + 1) * step] or [0.0]
+        top = int(mid - max(part) * (mid - 1))
+        bottom = int(mid - min(part) * (mid - 1))
+        for y in range(max(0, top), min(HEIGHT, bottom + 1)):
+            pixels[y * WIDTH + x] = colour
+    # Level bar along the bottom edge
+    bar = int(min(1.0, rms * 3) * WIDTH)
+    for y in range(HEIGHT - 4, HEIGHT):
+        for x in range(bar):
+            pixels[y * WIDTH + x] = colour
+    return pixels
+
+
+def render_loop():
+    """Frames of a pulsing bar, looped for songs without a video of their own."""
+    frames = []
+    for i in range(LOOP_FRAMES):
+        phase = abs(LOOP_FRAMES // 2 - i) / (LOOP_FRAMES / 2.0)
+        window = [phase * (1 if (n // 8) % 2 else -1) for n in range(WIDTH * 8)]
+        frames.append(render_frame(window))
+    return frames
+
+
+def write_video(image, frames, count, fps):
+    """Goldelox video: width, height, colour mode, frame delay & frame count, then big endian pixels.
+
+    Frames are rendered as they are written, so a long song never has to fit in memory.
+    Returns the sectors written.
+    """
+    size = HEADER_BYTES
+    image.write(struct.pack(">HHBBH", WIDTH, HEIGHT, COLOUR_16BIT, max(1, 1000 // fps), count))
+    for pixels in frames:
+        image.write(struct.pack(">%dH" % len(pixels), *pixels))
+        size += 2 * len(pixels)
+    image.write(bytes(-size % SECTOR))
+    return (size + SECTOR - 1) // SECTOR
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("songs", nargs="*")
+    parser.add_argument("--fps", type=int, default=12)
+    parser.add_argument("--loop", action="store_true", help="add a looped video for songs without their own")
+    parser.add_argument("--first-sector", type=int, default=0)
+    parser.add_argument("--image", default="display.img")
+    parser.add_argument("--manifest", default="anims.dat")
+    args = parser.parse_args()
+
+    entries = []
+    sector = args.first_sector
+    with open(args.image, "wb") as image:
+        if args.loop:
+            sectors = write_video(image, render_loop(), LOOP_FRAMES, args.fps)
+            entries.append(ENTRY.pack(LOOP_NAME.encode(), sector, LOOP_FRAMES, args.fps, X, Y, WIDTH, HEIGHT))
+            print("%-40s sector %8u, %5u frames" % ("(loop)", sector, LOOP_FRAMES))
+            sector += sectors
+        for path in args.songs:
+            name = os.path.basename(path)
+            try:
+                samples, rate = read_mono(path)
+            except (wave.Error, EOFError) as e:
+                print("skipping %s: %s" % (name, e), file=sys.stderr)
+                continue
+            per_frame = rate // args.fps
+            count = (len(samples) + per_frame - 1) // per_frame
+            if count > 0xFFFF:
+                print("skipping %s: %d frames is too many" % (name, count), file=sys.stderr)
+                continue
+            frames = (render_frame(samples[i:i + per_frame]) for i in range(0, len(samples), per_frame))
+            sectors = write_video(image, frames, count, args.fps)
+            entries.append(ENTRY.pack(name.encode()[:40], sector, count, args.fps, X, Y, WIDTH, HEIGHT))
+            print("%-40s sector %8u, %5u frames" % (name, sector, count))
+            sector += sectors
+
+    with open(args.manifest, "wb") as f:
+        f.write(HEADER.pack(MAGIC, len(entries)))
+        for entry in entries:
+            f.write(entry)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""Packs short clips into the flash image of the firmware as IMA-ADPCM.
+
+Usage: pack_clips.py [NAME=CLIP.wav ...] [--loop NAME] [--rate HZ] [--builtin] [--out ClipData.cpp]
+
+Each clip is mixed down to mono, resampled to --rate & compressed to 4 bits a sample, then the
+clips & their index are written as the const array of ClipData.cpp, which the linker keeps in the
+LPC1768's flash. Build the firmware with the new ClipData.cpp to change the clips.
+
+The firmware plays these clips by name: "click" for each command, "chime" when the library is
+ready, "error" when a song cannot be read, & "fallback", packed with --loop, when the card holds
+no music. --builtin synthesizes all four, & is what the checked in ClipData.cpp was made with;
+clips given as NAME=CLIP.wav replace the synthesized clip of the same name.
+"""
+import argparse
+import math
+import struct
+import sys
+import wave
+
+# Layout of ClipImageHeader & ClipEntry in ClipStore.h
+MAGIC = 0x50494C43
+HEADER = struct.Struct("<IHH")
+ENTRY = struct.Struct("<12sIIHBB")
+CLIP_LOOP = 0x01
+NAME_LEN = 12
+
+STEPS = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80,
+    88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544,
+    598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749,
+    3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635,
+    13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+]
+INDEX_STEP = [-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8]
+
+
+def decode_step(predictor, index, code):
+    """One sample of the decoder, exactly as ClipVoice::next() does it."""
+    step = STEPS[index]
+    diff = step >> 3
+    if code & 1:
+        diff += step >> 2
+    if code & 2:
+        diff += step >> 1
+    if code & 4:
+        diff += step
+    predictor += -diff if code & 8 else diff
+    predictor = max(-32768, min(32767, predictor))
+    index = max(0, min(88, index + INDEX_STEP[code]))
+    return predictor, index
+
+
+def encode(samples):
+    """IMA-ADPCM codes of 16 bit samples, two to a byte, low nibble first."""
+    predictor = 0
+    index = 0
+    codes = []
+    for sample in samples:
+        step = STEPS[index]
+        diff = sample - predictor
+        code = 0
+        if diff < 0:
+            code = 8
+            diff = -diff
+        for bit in (4, 2, 1):
+            if diff >= step:
+                code |= bit
+                diff -= step
+            step >>= 1
+        predictor, index = decode_step(predictor, index, code)
+        codes.append(code)
+    if len(codes) % 2:
+        codes.append(0)
+    return bytes(codes[i] | (codes[i + 1] << 4) for i in range(0, len(codes), 2))
+
+
+def read_wav(path, rate):
+    """Samples of a PCM WAV file, mixed to mono & resampled to rate by linear interpolation."""
+    with wave.open(path, "rb") as w:
+        channels = w.getnchannels()
+        width = w.getsampwidth()
+        source_rate = w.getframerate()
+        raw = w.readframes(w.getnframes())
+    if width == 1:
+        values = [(b - 128) << 8 for b in raw]
+    elif width == 2:
+        values = list(struct.unpack("<%dh" % (len(raw) // 2), raw))
+    else:
+        sys.exit("%s: only 8 & 16 bit PCM can be packed" % path)
+    mono = [sum(values[i:i + channels]) // channels for i in range(0, len(values), channels)]
+    if source_rate == rate or len(mono) < 2:
+        return mono
+    out = []
+    position = 0.0
+    ratio = source_rate / rate
+    while position < len(mono) - 1:
+        i = int(position)
+        fraction = position - i
+        out.append(int(mono[i] * (1 - fraction) + mono[i + 1] * fraction))
+        position += ratio
+    return out
+
+
+def tone(rate, notes, level=12000, decay=6.0):
+    """Notes of (frequency, seconds) one after another, each dying away."""
+    out = []
+    for frequency, seconds in notes:
+        count = int(rate * seconds)
+        for i in range(count):
+            t = i / rate
+            out.append(int(level * math.exp(-decay * t / seconds) * math.sin(2 * math.pi * frequency * t)))
+    return out
+
+
+def builtin(rate):
+    """Synthesized clips: a click, a two note chime, a falling error tone & a looped arpeggio."""
+    # Each note of the loop is a quarter second of whole cycles, tuned to the nearest that fit, so the
+    # notes join & the loop repeats without a click
+    loop = []
+    count = rate // 4
+    for frequency in (262, 330, 392, 523, 392, 330):
+        cycles = round(frequency * count / rate)
+        loop += [int(6000 * math.sin(2 * math.pi * cycles * i / count)) for i in range(count)]
+    return {
+        "click": (tone(rate, [(1000, 0.015)], decay=4.0), 0),
+        "chime": (tone(rate, [(659, 0.15), (880, 0.3)]), 0),
+        "error": (tone(rate, [(440, 0.15), (330, 0.25)]), 0),
+        "fallback": (loop, CLIP_LOOP),
+    }
+
+
+def write_source(path, image, clips, rate):
+    lines = [
+        "/**",
+        " * @file ClipData.cpp",
+        " * @brief Clip image built into the firmware; written by tools/pack_clips.py, do not edit",
+        " * @details %d bytes at %d Hz:" % (len(image), rate),
+    ]
+    for name, (samples, flags) in clips:
+        lines.append(" * %s, %d samples%s" % (name, len(samples), ", looped" if flags & CLIP_LOOP else ""))
+    lines += [
+        "**/",
+        '#include "ClipStore.h"',
+        "",
+        "// Aligned so the header & index are read in place",
+        "const uint8_t clipImage[] __attribute__((aligned(4))) =",
+        "{",
+    ]
+    for i in range(0, len(image), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in image[i:i + 16]) + ",")
+    lines.append("};")
+    with open(path, "w") as f:
+        f.write("\n".join(lines) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("clips", nargs="*", metavar="NAME=CLIP.wav")
+    parser.add_argument("--loop", action="append", default=[], help="name of a clip to loop")
+    parser.add_argument("--rate", type=int, default=8000)
+    parser.add_argument("--builtin", action="store_true", help="include the synthesized clips")
+    parser.add_argument("--out", default="ClipData.cpp")
+    args = parser.parse_args()
+
+    clips = builtin(args.rate) if args.builtin else {}
+    for spec in args.clips:
+        if "=" not in spec:
+            sys.exit("%s: expected NAME=CLIP.wav" % spec)
+        name, path = spec.split("=", 1)
+        if len(name.encode()) > NAME_LEN:
+            sys.exit("%s: names are at most %d bytes" % (name, NAME_LEN))
+        clips[name] = (read_wav(path, args.rate), 0)
+    for name in args.loop:
+        if name not in clips:
+            sys.exit("--loop %s: no such clip" % name)
+        clips[name] = (clips[name][0], CLIP_LOOP)
+    if not clips:
+        sys.exit("nothing to pack")
+    if args.rate > 0xFFFF:
+        sys.exit("--rate is at most 65535")
+
+    ordered = sorted(clips.items())
+    offset = HEADER.size + ENTRY.size * len(ordered)
+    index = b""
+    data = b""
+    for name, (samples, flags) in ordered:
+        codes = encode(samples)
+        index += ENTRY.pack(name.encode(), offset + len(data), len(samples), args.rate, flags, 0)
+        data += codes
+    image = HEADER.pack(MAGIC, len(ordered), 0) + index + data
+    write_source(args.out, image, ordered, args.rate)
+    print("%d clips, %d bytes of flash, in %s" % (len(ordered), len(image), args.out))
+
+
+if __name__ == "__main__":
+    main()
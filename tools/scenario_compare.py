@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+"""Compares the scenario results of two firmware builds & flags the regressions.
+
+Usage: scenario_compare.py BEFORE.json AFTER.json [--tolerance PERCENT]
+
+Each file is a scenario.json from a bench build's card: one JSON result per line, as written by
+ScenarioRunner. Results are paired by scenario & arguments; when a file holds several runs of the
+same one, the last is used. Every metric of a pair is printed with its change. A metric is a
+regression when it got worse by more than the tolerance: latencies, boot times & CPU load going up,
+free heap & stack going down. Underruns & lost skips are regressions if they rise at all.
+Exits with status 1 if any metric regressed, so the comparison can gate a release.
+"""
+import argparse
+import json
+import sys
+
+# Metrics where more is better; the rest, apart from NEUTRAL, are better lower
+HIGHER_BETTER = ("heap_min", "heap_free", "stack_min.")
+# Counts of failures: any rise is a regression
+ZERO_TOLERANCE = ("underruns", "lost")
+# Descriptions of the run rather than results
+NEUTRAL = ("scenario", "args", "build", "ms", "tracks", "songs", "latency_us.n")
+
+
+def flatten(result, prefix=""):
+    """Numeric fields of a result, with nested keys joined by dots."""
+    out = {}
+    for key, value in result.items():
+        name = prefix + key
+        if isinstance(value, dict):
+            out.update(flatten(value, name + "."))
+        elif isinstance(value, (int, float)) and not isinstance(value, bool):
+            out[name] = value
+    return out
+
+
+def load(path):
+    results = {}
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            line = line.strip()
+            if not line:
+                continue
+            try:
+                result = json.loads(line)
+            except ValueError:
+                print("%s:%d: not JSON, skipped" % (path, number), file=sys.stderr)
+                continue
+            key = "%s %s" % (result.get("scenario"), " ".join(str(a) for a in result.get("args", [])))
+            results[key] = result
+    return results
+
+
+def verdict(metric, before, after, tolerance):
+    """'worse', 'better' or '' for one metric."""
+    if metric in NEUTRAL or metric.split(".")[0] in NEUTRAL or before == after:
+        return ""
+    higher = metric.startswith(HIGHER_BETTER)
+    worse = after < before if higher else after > before
+    if metric in ZERO_TOLERANCE:
+        return "worse" if worse else "better"
+    change = abs(after - before) * 100.0 / before if before else 100.0
+    if change <= tolerance:
+        return ""
+    return "worse" if worse else "better"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("before")
+    parser.add_argument("after")
+    parser.add_argument("--tolerance", type=float, default=10.0, help="percent change ignored as noise")
+    args = parser.parse_args()
+
+    before = load(args.before)
+    after = load(args.after)
+    regressions = 0
+    for key in list(before) + [k for k in after if k not in before]:
+        if key not in before or key not in after:
+            print("%s: only in %s" % (key, args.before if key in before else args.after))
+            continue
+        if "error" in before[key] or "error" in after[key]:
+            print("%s: %s" % (key, after[key].get("error") or before[key].get("error")))
+            continue
+        print("%s (%s -> %s)" % (key, before[key].get("build"), after[key].get("build")))
+        old = flatten(before[key])
+        new = flatten(after[key])
+        for metric in sorted(set(old) | set(new)):
+            if metric not in old or metric not in new:
+                print("  %-24s %s" % (metric, "new" if metric in new else "gone"))
+                continue
+            mark = verdict(metric, old[metric], new[metric], args.tolerance)
+            if mark == "worse":
+                regressions += 1
+            delta = "%+d" % (new[metric] - old[metric])
+            print("  %-24s %10s %10s %10s  %s" % (metric, old[metric], new[metric], delta,
+                                                 "WORSE" if mark == "worse" else mark))
+    print("%d regression%s" % (regressions, "" if regressions == 1 else "s"))
+    sys.exit(1 if regressions else 0)
+
+
+if __name__ == "__main__":
+    main()